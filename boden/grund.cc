@@ -901,7 +901,13 @@ void grund_t::mark_image_dirty()
 	// see obj_t::mark_image_dirty
 	if(imageid!=IMG_EMPTY) {
 		const scr_coord scr_pos = welt->get_viewport()->get_screen_coord(koord3d(pos.get_2d(),get_disp_height()));
-		display_mark_img_dirty( imageid, scr_pos.x, scr_pos.y );
+		if(  karte_t::sync_region_t *region = karte_t::get_sync_region()  ) {
+			const karte_t::sync_region_t::dirty_image_t dirty = { imageid, scr_pos.x, scr_pos.y };
+			region->dirty_images.append(dirty);
+		}
+		else {
+			display_mark_img_dirty( imageid, scr_pos.x, scr_pos.y );
+		}
 	}
 }
 
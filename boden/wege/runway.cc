@@ -88,8 +88,8 @@ void runway_t::rdwr(loadsave_t *file)
 
 	if (file->get_extended_version() >= 13 || file->get_extended_revision() >= 20)
 	{
-		uint16 reserved_index = reserved.get_id();
-		file->rdwr_short(reserved_index);
+		quickstone_id_t reserved_index = reserved.get_id();
+		file->rdwr_handle_id(reserved_index);
 		reserved.set_id(reserved_index);
 	}
 }
@@ -274,7 +274,7 @@ void schiene_t::rdwr(loadsave_t *file)
 	if(file->get_extended_version() >= 12)
 #endif
 	{
-		uint16 reserved_index = reserved.get_id();
+		quickstone_id_t reserved_index = reserved.get_id();
 		if (file->is_saving())
 		{
 			// Do not save corrupt reservations. We cannot check this on loading, as
@@ -285,7 +285,7 @@ void schiene_t::rdwr(loadsave_t *file)
 				reserved_index = 0;
 			}
 		}
-		file->rdwr_short(reserved_index);
+		file->rdwr_handle_id(reserved_index);
 		reserved.set_id(reserved_index);
 
 		uint8 t = (uint8)type;
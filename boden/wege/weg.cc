@@ -4,6 +4,7 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
 #include <tuple>
 
 #include "../../tpl/slist_tpl.h"
@@ -53,7 +54,6 @@ static pthread_mutex_t weg_calc_image_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZE
 static pthread_mutexattr_t mutex_attributes;
 //static pthread_rwlockattr_t rwlock_attributes;
 
-pthread_mutex_t weg_t::private_car_route_map::route_map_mtx = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 
@@ -62,6 +62,13 @@ pthread_mutex_t weg_t::private_car_route_map::route_map_mtx = PTHREAD_MUTEX_INIT
  */
 vector_tpl <weg_t *> alle_wege;
 
+/**
+ * Ways from index month_rollover_next up to month_rollover_end
+ * have not yet been rolled over into the current month
+ */
+static uint32 month_rollover_next = 0;
+static uint32 month_rollover_end = 0;
+
 static slist_tpl<std::tuple<weg_t*, uint32, uint32>> pending_road_travel_time_updates;
 /**
  * Get list of all ways
@@ -79,6 +86,32 @@ uint32 weg_t::get_all_ways_count()
 void weg_t::clear_list_of__ways()
 {
 	alle_wege.clear();
+	month_rollover_next = month_rollover_end = 0;
+}
+
+
+void weg_t::start_month_rollover()
+{
+	// ways built from now on start in the new month already
+	month_rollover_next = 0;
+	month_rollover_end = alle_wege.get_count();
+}
+
+
+uint32 weg_t::get_month_rollover_pending()
+{
+	return month_rollover_end - month_rollover_next;
+}
+
+
+void weg_t::step_month_rollover(uint32 count)
+{
+	const uint32 end = count < get_month_rollover_pending() ? month_rollover_next + count : month_rollover_end;
+	while(  month_rollover_next < end  ) {
+		// the index moves on first, as new_month() may remove this way
+		weg_t *const w = alle_wege[month_rollover_next++];
+		w->new_month();
+	}
 }
 
 
@@ -151,6 +184,7 @@ sint32 weg_t::get_max_speed(bool needs_electrification) const
 
 void weg_t::set_desc(const way_desc_t *b, bool from_saved_game)
 {
+	route_t::invalidate_route_cache(wtyp);
 	if(desc && desc != b)
 	{
 		// Remove the old maintenance cost
@@ -463,6 +497,7 @@ void weg_t::init()
 	degraded = false;
 	remaining_wear_capacity = 100000000;
 	replacement_way = NULL;
+	route_t::invalidate_route_cache(wtyp);
 #ifdef MULTI_THREAD
 	pthread_mutexattr_init(&mutex_attributes);
 	//int error = pthread_rwlockattr_init(&rwlock_attributes);
@@ -480,6 +515,7 @@ void weg_t::init()
 
 weg_t::~weg_t()
 {
+	route_t::invalidate_route_cache(wtyp);
 	if (!welt->is_destroying())
 	{
 #ifdef MULTI_THREAD
@@ -488,7 +524,17 @@ weg_t::~weg_t()
 		// This is possibly unnecessary and may lead to crashes
 		//delete_all_routes_from_here();
 
-		alle_wege.remove(this);
+		const uint32 index = alle_wege.index_of(this);
+		if(  index != 0xFFFFFFFFu  ) {
+			alle_wege.remove_at(index);
+			// keep the ways not yet rolled over in place
+			if(  index < month_rollover_end  ) {
+				month_rollover_end--;
+				if(  index < month_rollover_next  ) {
+					month_rollover_next--;
+				}
+			}
+		}
 		player_t *player = get_owner();
 		if (player  &&  desc)
 		{
@@ -709,7 +755,9 @@ void weg_t::private_car_route_map::rdwr(loadsave_t *file){
 		if(count < 2){
 			file->rdwr_long(count);
 			if(count==1){
-				single_koord.rdwr(file);
+				// also for a set of one in a master map, or one linked to
+				koord single = get_by_index(0);
+				single.rdwr(file);
 			}
 			return;
 		}
@@ -925,6 +973,7 @@ void weg_t::rotate90()
  */
 void weg_t::count_sign()
 {
+	route_t::invalidate_route_cache(wtyp);
 	// Either only sign or signal please ...
 	flags &= ~(HAS_SIGN|HAS_SIGNAL|HAS_CROSSING);
 	const grund_t *gr=welt->lookup(get_pos());
@@ -1775,19 +1824,169 @@ void weg_t::private_car_route_map::reset(uint8 map_elem){
 	route_maps[map_elem].resize(0);
 }
 
+namespace {
+	// Orders sets of destinations, so that equal sets are next to each other
+	struct route_map_order_t
+	{
+		const vector_tpl<ordered_vector_tpl<koord,uint32> > &maps;
+		const uint32 *hashes;
+
+		// <0, 0 or >0 as the set a is before, equal to or after the set b
+		sint32 compare(const uint32 a, const uint32 b) const
+		{
+			if(hashes[a] != hashes[b]){
+				return hashes[a] < hashes[b] ? -1 : 1;
+			}
+			const ordered_vector_tpl<koord,uint32> &map_a = maps[a];
+			const ordered_vector_tpl<koord,uint32> &map_b = maps[b];
+			if(map_a.get_count() != map_b.get_count()){
+				return map_a.get_count() < map_b.get_count() ? -1 : 1;
+			}
+			for(uint32 k=0; k<map_a.get_count(); k++){
+				if(map_a[k] != map_b[k]){
+					return map_a[k].x < map_b[k].x || (map_a[k].x == map_b[k].x && map_a[k].y < map_b[k].y) ? -1 : 1;
+				}
+			}
+			return 0;
+		}
+
+		bool operator()(const uint32 a, const uint32 b) const
+		{
+			const sint32 result = compare(a, b);
+			return result < 0 || (result == 0 && a < b);
+		}
+	};
+}
+
+void weg_t::private_car_route_map::compact(uint8 map_elem){
+	vector_tpl<ordered_vector_tpl<koord,uint32> > &maps = route_maps[map_elem];
+	const uint32 old_count = maps.get_count();
+	if(old_count == 0){
+		return;
+	}
+
+	// Along a road, many tiles have routes to the same destinations in the same direction:
+	// find the first of each group of equal sets of destinations.
+	uint32 *hashes = new uint32[old_count];
+	uint32 *order = new uint32[old_count];
+	for(uint32 i=0; i<old_count; i++){
+		const ordered_vector_tpl<koord,uint32> &destinations = maps[i];
+		uint32 hash = destinations.get_count();
+		for(uint32 k=0; k<destinations.get_count(); k++){
+			hash = hash * 31 + ((uint32)(uint16)destinations[k].x << 16 | (uint16)destinations[k].y);
+		}
+		hashes[i] = hash;
+		order[i] = i;
+	}
+	route_map_order_t less = { maps, hashes };
+	std::sort(order, order + old_count, less);
+
+	uint32 *first_equal = new uint32[old_count];
+	uint32 distinct_count = 0;
+	for(uint32 i=0; i<old_count; i++){
+		if(i > 0 && less.compare(order[i-1], order[i]) == 0){
+			first_equal[order[i]] = first_equal[order[i-1]];
+		}
+		else{
+			first_equal[order[i]] = order[i];
+			distinct_count++;
+		}
+	}
+	delete [] order;
+
+	uint32 *new_idx = hashes; // reused
+	for(uint32 i=0; i<old_count; i++){
+		new_idx[i] = UINT32_MAX_VALUE;
+	}
+
+	// Keep each distinct set once, in the order in which the ways use them;
+	// the copies are exactly as large as their contents.
+	// The first map to use a set is its master, the others link to it, so that the set is saved only once.
+	vector_tpl<ordered_vector_tpl<koord,uint32> > compacted(distinct_count);
+	for(weg_t *w : weg_t::get_alle_wege()){
+		for(uint8 j=0; j<5; j++){
+			private_car_route_map &map = w->private_car_routes[map_elem][j];
+			if(map.link_mode==link_mode_NULL || map.link_mode==link_mode_single || map.idx>=old_count){
+				continue;
+			}
+			const uint32 first = first_equal[map.idx];
+			if(new_idx[first] == UINT32_MAX_VALUE){
+				new_idx[first] = compacted.get_count();
+				compacted.append(maps[first]);
+				map.link_mode = link_mode_master;
+			}
+			else{
+				map.link_mode = j;
+			}
+			map.idx = new_idx[first];
+		}
+	}
+
+	delete [] first_equal;
+	delete [] hashes;
+	swap(maps, compacted);
+}
+
 weg_t::private_car_route_map* weg_t::private_car_backtrace_last_route_map=NULL;
 uint8 weg_t::private_car_backtrace_last_idx=0;
 
+thread_local vector_tpl<weg_t::private_car_backtrace_t> *weg_t::private_car_backtrace_buffer = NULL;
+
 void weg_t::private_car_backtrace_begin(){
-	private_car_route_map::route_map_lock();
+	if(private_car_backtrace_buffer){
+		private_car_backtrace_t step;
+		step.way=NULL;
+		step.destination=koord::invalid;
+		step.next_tile=koord3d::invalid;
+		private_car_backtrace_buffer->append(step);
+		return;
+	}
 	private_car_backtrace_last_route_map=NULL;
 }
 
 void weg_t::private_car_backtrace_end(){
-	private_car_route_map::route_map_unlock();
 }
 
 void weg_t::private_car_backtrace_add(koord destination, koord3d next_tile){
+	if(private_car_backtrace_buffer){
+		private_car_backtrace_t step;
+		step.way=this;
+		step.destination=destination;
+		step.next_tile=next_tile;
+		private_car_backtrace_buffer->append(step);
+		return;
+	}
+	private_car_backtrace_write(destination, next_tile);
+}
+
+void weg_t::private_car_backtrace_inc(koord3d next_tile){
+	if(private_car_backtrace_buffer){
+		private_car_backtrace_t step;
+		step.way=this;
+		step.destination=koord::invalid;
+		step.next_tile=next_tile;
+		private_car_backtrace_buffer->append(step);
+		return;
+	}
+	private_car_backtrace_write_inc(next_tile);
+}
+
+void weg_t::apply_private_car_backtraces(vector_tpl<private_car_backtrace_t> &buffer){
+	FOR(vector_tpl<private_car_backtrace_t>, const& step, buffer) {
+		if(step.way==NULL){
+			private_car_backtrace_last_route_map=NULL;
+		}
+		else if(step.destination==koord::invalid){
+			step.way->private_car_backtrace_write_inc(step.next_tile);
+		}
+		else{
+			step.way->private_car_backtrace_write(step.destination, step.next_tile);
+		}
+	}
+	buffer.clear();
+}
+
+void weg_t::private_car_backtrace_write(koord destination, koord3d next_tile){
 	uint8 writing_elem=get_private_car_routes_currently_writing_element();
 	auto map = private_car_routes[writing_elem];
 	const uint8 map_idx = get_map_idx(next_tile);
@@ -1806,7 +2005,7 @@ void weg_t::private_car_backtrace_add(koord destination, koord3d next_tile){
 	}
 }
 
-void weg_t::private_car_backtrace_inc(koord3d next_tile){
+void weg_t::private_car_backtrace_write_inc(koord3d next_tile){
 	uint8 writing_elem=get_private_car_routes_currently_writing_element();
 	auto map = private_car_routes[writing_elem];
 	const uint8 map_idx = get_map_idx(next_tile);
@@ -1818,7 +2017,6 @@ void weg_t::add_private_car_route(koord destination, koord3d next_tile)
 {
 
 	uint8 writing_elem=get_private_car_routes_currently_writing_element();
-	private_car_route_map::route_map_lock();
 	auto map = private_car_routes[writing_elem];
 	const uint8 map_idx = get_map_idx(next_tile);
 
@@ -1831,8 +2029,6 @@ void weg_t::add_private_car_route(koord destination, koord3d next_tile)
 		map[map_idx].insert_unique(destination);
 	}
 
-	private_car_route_map::route_map_unlock();
-
 #ifdef DEBUG_PRIVATE_CAR_ROUTES
 	calc_image();
 #endif
@@ -1908,17 +2104,20 @@ void weg_t::delete_route_to(koord destination, bool reading_set)
 void weg_t::remove_private_car_route(koord destination, bool reading_set)
 {
 	const uint32 routes_index = reading_set ? private_car_routes_currently_reading_element : get_private_car_routes_currently_writing_element();
-	private_car_route_map::route_map_lock();
 	for(uint8 i=0;i<5;i++) {
 		if(private_car_routes[routes_index][i].remove(destination)) {
 			break;
 		}
 	}
-	private_car_route_map::route_map_unlock();
 }
 
 void weg_t::add_travel_time_update(weg_t* w, uint32 actual, uint32 ideal)
 {
+	if(  karte_t::sync_region_t *region = karte_t::get_sync_region()  ) {
+		const karte_t::sync_region_t::travel_time_t update = { w, actual, ideal };
+		region->travel_times.append(update);
+		return;
+	}
 	pending_road_travel_time_updates.append(std::make_tuple(w, actual, ideal));
 }
 
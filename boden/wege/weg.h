@@ -17,6 +17,7 @@
 #include "../../obj/simobj.h"
 #include "../../descriptor/way_desc.h"
 #include "../../dataobj/koord3d.h"
+#include "../../dataobj/route.h"
 #include "../../tpl/minivec_tpl.h"
 #include "../../tpl/ordered_vector_tpl.h"
 #include "../../simskin.h"
@@ -96,6 +97,16 @@ public:
 	static uint32 get_all_ways_count();
 	static void clear_list_of__ways();
 
+	/**
+	 * Rolls the ways over into a new month a few at a time:
+	 * start_month_rollover() marks all existing ways as pending and
+	 * step_month_rollover() calls new_month() for the next @p count of them,
+	 * in the order of the list, so the same ways are done on all clients.
+	 */
+	static void start_month_rollover();
+	static uint32 get_month_rollover_pending();
+	static void step_month_rollover(uint32 count);
+
 	enum {
 		HAS_SIDEWALK   = 1 << 0,
 		IS_ELECTRIFIED = 1 << 1,
@@ -279,6 +290,13 @@ public:
 
 		static void reset(uint8 map_elem);
 
+		/**
+		 * Makes the maps of all ways with the same destinations share them, and releases the unused capacity.
+		 * Each shared set has one master map, which saves it; the other maps link to it.
+		 * For the set which is about to be read: the maps must not be written again until they are reset.
+		 */
+		static void compact(uint8 map_elem);
+
 		//backwards compatible saving
 		void rdwr(loadsave_t *file);
 
@@ -300,28 +318,9 @@ public:
 
 		inline sint32 get_idx() const {if(link_mode==link_mode_NULL || link_mode==link_mode_single) return -1; return idx;}
 
-#ifdef MULTI_THREAD
-		static pthread_mutex_t route_map_mtx;
-#endif
-
-
-		inline static void route_map_lock() {
-#ifdef MULTI_THREAD
-			int error = pthread_mutex_lock(&route_map_mtx);
-			assert(error == 0);
-			(void)error;
-#endif
-			return;
-		}
-
-		inline static void route_map_unlock() {
-#ifdef MULTI_THREAD
-			int error = pthread_mutex_unlock(&route_map_mtx);
-			assert(error == 0);
-			(void)error;
-#endif
-			return;
-		}
+		// No locking is needed: the maps are only written by the main thread, as the private car route threads
+		// buffer what they find (see private_car_backtrace_buffer), and the set which is read is only written
+		// whilst nothing reads it, when it is cleared after the sets have been swapped.
 	};
 
 
@@ -343,6 +342,30 @@ public:
 	static private_car_route_map* private_car_backtrace_last_route_map;
 	static uint8 private_car_backtrace_last_idx;
 
+	/// A call of private_car_backtrace_begin(), _add() or _inc() which is to be applied later
+	struct private_car_backtrace_t
+	{
+		weg_t *way;         ///< NULL for the beginning of a route
+		koord destination;  ///< koord::invalid when moving on to the next tile
+		koord3d next_tile;
+	};
+
+	/**
+	 * If set, the private car routes found by this thread are written into this buffer
+	 * rather than directly, so that the routes found by several threads can be applied
+	 * in a deterministic order with apply_private_car_backtraces().
+	 */
+	static thread_local vector_tpl<private_car_backtrace_t> *private_car_backtrace_buffer;
+
+	/// Applies and clears the private car routes written into a buffer.
+	static void apply_private_car_backtraces(vector_tpl<private_car_backtrace_t> &buffer);
+
+private:
+	void private_car_backtrace_write(koord destination, koord3d next_tile);
+	void private_car_backtrace_write_inc(koord3d next_tile);
+
+public:
+
 	void add_private_car_route(koord dest, koord3d next_tile);
 	bool has_private_car_route(koord dest) const;
 	koord3d get_next_on_private_car_route_to(koord dest, bool reading_set=true, uint8 start_dir=0) const;
@@ -377,15 +400,15 @@ public:
 	 */
 	bool check_season(const bool calc_only_season_change) OVERRIDE;
 
-	void set_max_speed(sint32 s) { max_speed = s; }
+	void set_max_speed(sint32 s) { max_speed = s; route_t::invalidate_route_cache(wtyp); }
 
-	void set_max_axle_load(uint32 w) { max_axle_load = w; }
-	void set_bridge_weight_limit(uint32 value) { bridge_weight_limit = value; }
+	void set_max_axle_load(uint32 w) { max_axle_load = w; route_t::invalidate_route_cache(wtyp); }
+	void set_bridge_weight_limit(uint32 value) { bridge_weight_limit = value; route_t::invalidate_route_cache(wtyp); }
 
 	// Resets constraints to their base values. Used when removing way objects.
-	void reset_way_constraints() { way_constraints = desc->get_way_constraints(); }
+	void reset_way_constraints() { way_constraints = desc->get_way_constraints(); route_t::invalidate_route_cache(wtyp); }
 
-	void clear_way_constraints() { way_constraints.set_permissive(0); way_constraints.set_prohibitive(0); }
+	void clear_way_constraints() { way_constraints.set_permissive(0); way_constraints.set_prohibitive(0); route_t::invalidate_route_cache(wtyp); }
 
 	/* Way constraints: determines whether vehicles
 	 * can travel on this way. This method decodes
@@ -396,8 +419,8 @@ public:
 	 * */
 
 	const way_constraints_of_way_t& get_way_constraints() const { return way_constraints; }
-	void add_way_constraints(const way_constraints_of_way_t& value) { way_constraints.add(value); }
-	void remove_way_constraints(const way_constraints_of_way_t& value) { way_constraints.remove(value); }
+	void add_way_constraints(const way_constraints_of_way_t& value) { way_constraints.add(value); route_t::invalidate_route_cache(wtyp); }
+	void remove_way_constraints(const way_constraints_of_way_t& value) { way_constraints.remove(value); route_t::invalidate_route_cache(wtyp); }
 
 	// Convoys that do not require electrification can ignore speed limit by electrification
 	sint32 get_max_speed(bool needs_electrification = false) const;
@@ -448,7 +471,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi;}
+	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi; route_t::invalidate_route_cache(wtyp); }
 
 	/**
 	* Remove direction bits (ribi) for a way.
@@ -456,7 +479,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi;}
+	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi; route_t::invalidate_route_cache(wtyp); }
 
 	/**
 	* Set direction bits (ribi) for the way.
@@ -464,7 +487,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi;}
+	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi; route_t::invalidate_route_cache(wtyp); }
 
 	/**
 	* Get the unmasked direction bits (ribi) for the way (without signals or other ribi changer).
@@ -480,7 +503,7 @@ public:
 	* For signals it is necessary to mask out certain ribi to prevent vehicles
 	* from driving the wrong way (e.g. oneway roads)
 	*/
-	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; }
+	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; route_t::invalidate_route_cache(wtyp); }
 	ribi_t::ribi get_ribi_maske() const { return (ribi_t::ribi)ribi_maske; }
 
 	/**
@@ -513,7 +536,7 @@ public:
 	void set_gehweg(const bool yesno) { flags = (yesno ? flags | HAS_SIDEWALK : flags & ~HAS_SIDEWALK); }
 	inline bool hat_gehweg() const { return flags & HAS_SIDEWALK; }
 
-	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED;}
+	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED; route_t::invalidate_route_cache(wtyp); }
 	inline bool is_electrified() const {return flags&IS_ELECTRIFIED; }
 
 	inline bool has_sign() const {return flags&HAS_SIGN; }
@@ -546,7 +569,7 @@ public:
 	bool should_city_adopt_this(const player_t* player);
 
 	bool is_public_right_of_way() const { return public_right_of_way; }
-	void set_public_right_of_way(bool arg=true) { public_right_of_way = arg; }
+	void set_public_right_of_way(bool arg=true) { public_right_of_way = arg; route_t::invalidate_route_cache(wtyp); }
 
 	bool is_degraded() const { return degraded; }
 
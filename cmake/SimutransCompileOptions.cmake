@@ -46,6 +46,7 @@ option(SIMUTRANS_STEAM_BUILT "Compile a Steam build" OFF)
 option(DEBUG_FLUSH_BUFFER "Highlite areas changes since last redraw" OFF)
 option(ENABLE_WATERWAY_SIGNS "Allow private signs on watersways" OFF)
 option(AUTOJOIN_PUBLIC "Join when making things public" OFF)
+option(SIMUTRANS_QUICKSTONE_32BIT "Use 32 bit handles to allow more than 65535 convoys and lines" OFF)
 
 if(NOT SIMUTRANS_DEBUG_LEVEL)
 	set(SIMUTRANS_DEBUG_LEVEL $<CONFIG:Debug>)
@@ -238,6 +238,7 @@ target_sources(simutrans-extended PRIVATE
 	io/rdwr/adler32_stream.cc
 	io/rdwr/bzip2_file_rdwr_stream.cc
 	io/rdwr/compare_file_rd_stream.cc
+	io/rdwr/memory_rdwr_stream.cc
 	io/rdwr/raw_file_rdwr_stream.cc
 	io/rdwr/rdwr_stream.cc
 	io/rdwr/zlib_file_rdwr_stream.cc
@@ -363,6 +364,7 @@ target_sources(simutrans-extended PRIVATE
 	utils/csv.cc
 	utils/float32e8_t.cc
 	utils/log.cc
+	utils/mapped_file.cc
 	utils/searchfolder.cc
 	utils/sha1.cc
 	utils/simrandom.cc
@@ -162,6 +162,7 @@ bool env_t::cities_ignore_height = false;
 bool env_t::second_open_closes_win;
 bool env_t::remember_window_positions;
 uint8 env_t::num_threads;
+uint32 env_t::rezoom_cache_size;
 bool env_t::draw_earth_border;
 bool env_t::draw_outside_tile;
 
@@ -291,6 +292,8 @@ void env_t::init()
 	num_threads = 1;
 #endif
 
+	rezoom_cache_size = 64;
+
 	sound_distance_scaling = 10;
 
 	show_tooltips = true;
@@ -431,6 +431,9 @@ public:
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/// MB of zoomed images kept for other zoom levels (0 = rezoom every time)
+	static uint32 rezoom_cache_size;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
@@ -823,6 +823,24 @@ void loadsave_t::rdwr_long(uint32 &l)
 }
 
 
+void loadsave_t::rdwr_handle_id(quickstone_id_t &id)
+{
+	if(  is_version_ex_less(14, 73)  ) {
+		uint16 id16 = (uint16)id;
+		rdwr_short(id16);
+		id = id16;
+		return;
+	}
+
+	uint32 id32 = id;
+	rdwr_long(id32);
+	if(  id32 >= QUICKSTONE_ID_RANGE  ) {
+		dbg->fatal( "loadsave_t::rdwr_handle_id()", "Handle %u out of range: this game needs a build with QUICKSTONE_32BIT", id32 );
+	}
+	id = (quickstone_id_t)id32;
+}
+
+
 void loadsave_t::rdwr_longlong(sint64 &ll)
 {
 	if(!is_xml()) {
@@ -1303,6 +1321,15 @@ void loadsave_t::rd_obj_id(char *id_buf, int size)
 }
 
 
+void loadsave_t::wr_raw(const void *buf, size_t len)
+{
+	assert(is_saving()  &&  !is_xml());
+	if(  len > 0  ) {
+		write( buf, len );
+	}
+}
+
+
 extended_version_t loadsave_t::int_version(const char *version_text, char *pak_extension_str)
 {
 	uint32 extended_version = 0;
@@ -1407,6 +1434,14 @@ stream_loadsave_t::stream_loadsave_t(rdwr_stream_t *stream)
 }
 
 
+stream_loadsave_t::stream_loadsave_t(rdwr_stream_t *stream, const loadsave_t *format)
+{
+	assert(!format->is_xml());
+	this->stream = stream;
+	finfo = format->finfo;
+}
+
+
 compare_loadsave_t::compare_loadsave_t(loadsave_t *file1, loadsave_t *file2)
 {
 	stream = new compare_file_rd_stream_t(file1->stream, file2->stream);
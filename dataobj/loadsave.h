@@ -97,8 +97,6 @@ protected:
 
 	void flush_buffer(int buf_num);
 
-	bool is_xml() const { return mode&xml; }
-
 public:
 	static mode_t save_mode;     ///< default to use for saving
 	static mode_t autosave_mode; ///< default to use for autosaves and network mode client temp saves
@@ -136,6 +134,7 @@ public:
 	unsigned get_buf_pos(int buf_num) const { return buff[buf_num].pos; }
 	bool is_loading() const { return stream && !stream->is_writing(); }
 	bool is_saving() const { return stream && stream->is_writing(); }
+	bool is_xml() const { return mode&xml; }
 	const char *get_pak_extension() const { return finfo.pak_extension; }
 
 	uint32 get_version_int() const { return finfo.ext_version.version; }
@@ -159,11 +158,17 @@ public:
 	void rdwr_bool(bool &i);
 	void rdwr_double(double &dbl);
 
+	/// ids of convoy and line handles: 16 bit before 14.73, 32 bit from then on
+	void rdwr_handle_id(quickstone_id_t &id);
+
 	void wr_obj_id(short id);
 	short rd_obj_id();
 	void wr_obj_id(const char *id_text);
 	void rd_obj_id(char *id_buf, int size);
 
+	/// Appends data serialised by another (binary) loadsave_t verbatim
+	void wr_raw(const void *buf, size_t len);
+
 	// s is a malloc-ed string (will be freed and newly allocated on load time!)
 	void rdwr_str(const char *&s);
 
@@ -200,6 +205,7 @@ public:
 	}
 
 	friend class compare_loadsave_t; // to access stream
+	friend class stream_loadsave_t;  // to copy the file info
 };
 
 
@@ -210,6 +216,9 @@ class stream_loadsave_t : public loadsave_t
 {
 public:
 	stream_loadsave_t(rdwr_stream_t *stream);
+
+	/// Uses the same savegame version as @p format, so the data can be appended to it by wr_raw()
+	stream_loadsave_t(rdwr_stream_t *stream, const loadsave_t *format);
 };
 
 /**
@@ -37,6 +37,10 @@
 
 // binary heap, the fastest
 #include "../tpl/binary_heap_tpl.h"
+#include "../tpl/ptrhashtable_tpl.h"
+
+// the closed lists of the bidirectional search can hold very many nodes
+typedef ptrhashtable_tpl <const grund_t *, route_t::ANode *, 4099> bidirectional_closed_list_t;
 
 
 #ifdef DEBUG_ROUTES
@@ -46,6 +50,113 @@
 bool route_t::suspend_private_car_routing = false;
 
 
+/*
+ * Routes found by calc_route() for vehicles whose route searches depend only on the ways and on their
+ * route cache signature, one cache per waytype. Each change of the ways of a waytype advances its
+ * generation, and the routes found for an older generation are forgotten.
+ */
+struct route_cache_key_t
+{
+	koord3d start;
+	koord3d ziel;
+	uint64 signature;
+	sint32 max_speed;
+	uint32 axle_load;
+	uint32 convoy_weight;
+	sint32 tile_length;
+	bool is_tall;
+};
+
+class route_cache_hash_t
+{
+public:
+	typedef int diff_type;
+
+	static uint32 hash(const route_cache_key_t &key)
+	{
+		return ((uint32)key.start.x << 16 | (uint16)key.start.y) ^ ((uint32)key.ziel.y << 16 | (uint16)key.ziel.x) ^ (uint32)key.signature;
+	}
+
+	static diff_type comp(const route_cache_key_t &key1, const route_cache_key_t &key2)
+	{
+		if(  key1.start != key2.start  ) {
+			return key1.start.x != key2.start.x ? (key1.start.x < key2.start.x ? -1 : 1) : key1.start.y != key2.start.y ? (key1.start.y < key2.start.y ? -1 : 1) : (key1.start.z < key2.start.z ? -1 : 1);
+		}
+		if(  key1.ziel != key2.ziel  ) {
+			return key1.ziel.x != key2.ziel.x ? (key1.ziel.x < key2.ziel.x ? -1 : 1) : key1.ziel.y != key2.ziel.y ? (key1.ziel.y < key2.ziel.y ? -1 : 1) : (key1.ziel.z < key2.ziel.z ? -1 : 1);
+		}
+		if(  key1.signature != key2.signature  ) {
+			return key1.signature < key2.signature ? -1 : 1;
+		}
+		if(  key1.max_speed != key2.max_speed  ) {
+			return key1.max_speed < key2.max_speed ? -1 : 1;
+		}
+		if(  key1.axle_load != key2.axle_load  ) {
+			return key1.axle_load < key2.axle_load ? -1 : 1;
+		}
+		if(  key1.convoy_weight != key2.convoy_weight  ) {
+			return key1.convoy_weight < key2.convoy_weight ? -1 : 1;
+		}
+		if(  key1.tile_length != key2.tile_length  ) {
+			return key1.tile_length < key2.tile_length ? -1 : 1;
+		}
+		return (int)key1.is_tall - (int)key2.is_tall;
+	}
+};
+
+struct route_cache_entry_t
+{
+	koord3d_vector_t route;
+	uint32 max_axle_load;
+	route_t::route_result_t result;
+};
+
+struct route_cache_t
+{
+	hashtable_tpl<route_cache_key_t, route_cache_entry_t *, route_cache_hash_t, N_BAGS_LARGE> routes;
+	uint32 generation;        // advanced on every change of the ways
+	uint32 routes_generation; // the generation for which the routes were found
+
+	route_cache_t() : generation(0), routes_generation(0) {}
+
+	~route_cache_t() { clear(); }
+
+	void clear()
+	{
+		for(auto const& i : routes) {
+			delete i.value;
+		}
+		routes.clear();
+	}
+};
+
+// there are no routes cached for other waytypes
+static route_cache_t route_caches[narrowgauge_wt + 1];
+
+#ifdef MULTI_THREAD
+static pthread_mutex_t route_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+void route_t::invalidate_route_cache(waytype_t wt)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock(&route_cache_mutex);
+#endif
+	if(  wt == any_wt  ) {
+		for(  uint8 i = 0;  i < lengthof(route_caches);  i++  ) {
+			route_caches[i].generation++;
+		}
+	}
+	else if(  wt >= 0  &&  wt < (int)lengthof(route_caches)  ) {
+		route_caches[wt].generation++;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock(&route_cache_mutex);
+#endif
+}
+
+
 void route_t::append(const route_t *r)
 {
 	assert(r != NULL);
@@ -760,12 +871,10 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 					// Halt this mid step if there are too many routes being calculated so as not to make the game unresponsive.
 					// On a Ryzen 3900x, calculating all routes from one city on a 600 city map can take ~4 seconds.
 
-					// It is intentional to have two barriers here.
+					// It is intentional to have two barriers here: the first is the end of this step's part of the check,
+					// the second the start of the next part. Once the threads are suspended, the rest of the check runs without halting.
+					simthread_barrier_wait(&karte_t::private_car_barrier);
 					simthread_barrier_wait(&karte_t::private_car_barrier);
-					if (!suspend_private_car_routing)
-					{
-						simthread_barrier_wait(&karte_t::private_car_barrier);
-					}
 					private_car_route_step_counter = 0;
 				}
 #endif
@@ -958,6 +1067,358 @@ ribi_t::ribi *get_next_dirs(const koord3d& gr_pos, const koord3d& ziel)
 }
 
 
+bool route_t::check_tile_entry(karte_t *welt, const grund_t *to, const ribi_t::ribi dir, test_driver_t* const tdriver, const sint32 max_speed, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, find_route_flags flags, sint32 &bridge_tile_count, uint32 &cost)
+{
+	const waytype_t wegtyp = tdriver->get_waytype();
+	const uint8 enforce_weight_limits = welt->get_settings().get_enforce_weight_limits();
+
+	// Do not go on a tile where a one way sign forbids going.
+	// This saves time and fixed the bug in which a oneway sign on the final tile was ignored.
+	const ribi_t::ribi last_dir = dir;
+	weg_t *w = to->get_weg(wegtyp);
+	ribi_t::ribi go_dir = (w == NULL) ? 0 : w->get_ribi_maske();
+	if ((last_dir&go_dir) != 0)
+	{
+		if (tdriver->get_waytype() == track_wt || tdriver->get_waytype() == narrowgauge_wt || tdriver->get_waytype() == maglev_wt || tdriver->get_waytype() == tram_wt || tdriver->get_waytype() == monorail_wt)
+		{
+			// Unidirectional signals allow routing in both directions but only act in one direction. Check whether this is one of those.
+			if (!w->has_signal())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Low bridges
+	if (is_tall && to->is_height_restricted())
+	{
+		return false;
+	}
+
+	// Weight limits
+	sint32 is_overweight = not_overweight;
+	if (enforce_weight_limits > 0 && w != NULL)
+	{
+		// Bernd Gabriel, Mar 10, 2010: way limit info
+		if (to->ist_bruecke() || w->get_desc()->get_styp() == type_elevated || w->get_waytype() == air_wt || w->get_waytype() == water_wt)
+		{
+			// Bridges care about convoy weight, whereas other types of way
+			// care about axle weight.
+			bridge_tile_count++;
+
+			// This is actually maximum convoy weight: the name is odd because of the virtual method.
+			uint32 way_max_convoy_weight;
+
+			// Trams need to check the weight of the underlying bridge.
+
+			if (w->get_desc()->get_styp() == type_tram)
+			{
+				const weg_t* underlying_bridge = welt->lookup(w->get_pos())->get_weg(road_wt);
+				if (!underlying_bridge)
+				{
+					goto check_axle_load;
+				}
+				way_max_convoy_weight = underlying_bridge->get_bridge_weight_limit();
+
+			}
+			else
+			{
+				way_max_convoy_weight = w->get_bridge_weight_limit();
+			}
+
+			// This ensures that only that part of the convoy that is actually on the bridge counts.
+			const sint32 proper_tile_length = tile_length > 8888 ? tile_length - 8888 : tile_length;
+			uint32 adjusted_convoy_weight = tile_length == 0 ? convoy_weight : (convoy_weight * max(bridge_tile_count - 2, 1)) / proper_tile_length;
+			const uint32 min_weight = min(adjusted_convoy_weight, convoy_weight);
+			if (min_weight > way_max_convoy_weight)
+			{
+				switch (enforce_weight_limits)
+				{
+				case 1:
+				default:
+
+					is_overweight = slowly_only;
+					break;
+
+				case 2:
+
+					is_overweight = cannot_route;
+					break;
+
+				case 3:
+
+					is_overweight = way_max_convoy_weight == 0 || (min_weight * 100) / way_max_convoy_weight > 110 ? cannot_route : slowly_only;
+					break;
+				}
+			}
+			if (to->ist_bruecke())
+			{
+				// For a real bridge, also check the axle load of the underlying way.
+				goto check_axle_load;
+			}
+		}
+		else
+		{
+		check_axle_load:
+			bridge_tile_count = 0;
+			const uint32 way_max_axle_load = w->get_max_axle_load();
+			max_axle_load = std::min(max_axle_load, way_max_axle_load);
+			if (axle_load > way_max_axle_load)
+			{
+				switch (enforce_weight_limits)
+				{
+				case 1:
+				default:
+
+					is_overweight = slowly_only;
+					break;
+
+				case 2:
+
+					is_overweight = cannot_route;
+					break;
+
+				case 3:
+
+					is_overweight = way_max_axle_load == 0 || (axle_load * 100) / way_max_axle_load > 110 ? cannot_route : slowly_only;
+					break;
+				}
+			}
+		}
+
+		if (is_overweight == cannot_route)
+		{
+			// Avoid routing over ways for which the convoy is overweight.
+			return false;
+		}
+
+	}
+
+	// new values for cost g (without way it is either in the air or in water => no costs)
+	const int way_cost = flags == simple_cost ? 1 : tdriver->get_cost(to, max_speed, dir) + (is_overweight == slowly_only ? 400 : 0);
+	cost = w ? way_cost : flags == simple_cost ? 1 : 10;
+	return true;
+}
+
+
+route_t::route_result_t route_t::intern_calc_route_bidirectional(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_speed, const sint64 max_cost, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, const koord3d avoid_tile)
+{
+	route_result_t ok = no_route;
+
+	// check for existing koordinates
+	const grund_t *start_gr = welt->lookup(start);
+	const grund_t *ziel_gr = welt->lookup(ziel);
+	if(  start_gr == NULL  ||  ziel_gr == NULL  ) {
+		return no_route;
+	}
+
+	route.clear();
+	max_axle_load = MAXUINT32;
+	max_convoy_weight = MAXUINT32;
+
+	// first or last tile is not valid?!?
+	if(  !tdriver->check_next_tile(start_gr)  ||  !tdriver->check_next_tile(ziel_gr)  ) {
+		return no_route;
+	}
+
+	const waytype_t wegtyp = tdriver->get_waytype();
+
+	// memory in static list ...
+	if(!MAX_STEP)
+	{
+		INIT_NODES(welt->get_settings().get_max_route_steps(), welt->get_size());
+	}
+
+	ANode *nodes;
+	uint8 ni = GET_NODES(&nodes);
+
+#ifdef USE_VALGRIND_MEMCHECK
+	VALGRIND_MAKE_MEM_UNDEFINED(nodes, sizeof(ANode)*MAX_STEP);
+#endif
+
+	// Search 0 runs forwards from the start, search 1 backwards from the target; both share the nodes.
+	// A node of the backwards search has the tile after it on the route as its parent, and ribi_from is
+	// the direction in which that tile is entered.
+	binary_heap_tpl <ANode *> queue[2];
+	bidirectional_closed_list_t *closed = new bidirectional_closed_list_t[2];
+	const koord3d goal[2] = { ziel, start };
+	sint32 bridge_tile_count[2] = { 0, 0 };
+
+	uint32 step = 0;
+	for(  int s = 0;  s < 2;  s++  ) {
+		ANode* tmp = &nodes[step];
+		step ++;
+
+		tmp->parent = NULL;
+		tmp->gr = s == 0 ? start_gr : ziel_gr;
+		tmp->f = calc_distance(start, ziel) * 10;
+		tmp->g = 0;
+		tmp->dir = 0;
+		tmp->count = 0;
+		tmp->ribi_from = ribi_t::none;
+		tmp->jps_ribi = ribi_t::all;
+		queue[s].insert(tmp);
+	}
+	if (route_t::max_used_steps < step)
+		route_t::max_used_steps = step;
+
+	const grund_t* avoid_ground = welt->lookup(avoid_tile);
+
+	// the fastest route found so far, as the nodes where the searches meet
+	uint64 best_cost = max_cost > 0 ? (uint64)max_cost : 0;
+	ANode *best_forward = NULL;
+	ANode *best_backward = NULL;
+
+	while(  (!queue[0].empty()  ||  !queue[1].empty())  &&  step < MAX_STEP  ) {
+		// advance the search whose best node is the more promising
+		const int s = queue[1].empty() || (!queue[0].empty() && queue[0].front()->f <= queue[1].front()->f) ? 0 : 1;
+
+		ANode *tmp = queue[s].pop();
+		const grund_t *gr = tmp->gr;
+		if(  closed[s].get(gr)  ) {
+			// we were already here on a faster route, thus ignore this branch
+			continue;
+		}
+
+		// no node left can lead to a faster route than the one found
+		if(  tmp->g >= best_cost  ||  (best_forward  &&  (uint64)tmp->f >= best_cost * 10)  ) {
+			break;
+		}
+
+		// the other search has been here: the searches meet
+		if(  ANode *other = closed[1-s].get(gr)  ) {
+			ANode *forward_node = s == 0 ? tmp : other;
+			ANode *backward_node = s == 0 ? other : tmp;
+			// the route must not turn back on this tile
+			if(  forward_node->parent == NULL  ||  backward_node->parent == NULL  ||  backward_node->ribi_from != ribi_t::reverse_single(forward_node->ribi_from)  ) {
+				const uint64 cost = (uint64)forward_node->g + backward_node->g;
+				if(  cost < best_cost  ) {
+					best_cost = cost;
+					best_forward = forward_node;
+					best_backward = backward_node;
+				}
+				// any route through here from this node is already covered
+				closed[s].put(gr, tmp);
+				continue;
+			}
+			// Turning back here is no route, but routes may still pass through this tile. Thus search on from
+			// this node, and leave the tile open, so that this search can meet the other here from another side.
+		}
+		else {
+			closed[s].put(gr, tmp);
+		}
+
+		const ribi_t::ribi *next_ribi = get_next_dirs(gr->get_pos(), goal[s]);
+		for(  int r = 0;  r < 4;  r++  ) {
+			// the tile of the new node and the direction in which it is entered (forwards) or left (backwards)
+			grund_t *to;
+			ribi_t::ribi move_dir;
+			uint32 step_cost;
+
+			if(  s == 0  ) {
+				// a way in our direction, not turning back?
+				const weg_t* way = gr->get_weg(wegtyp);
+				const ribi_t::ribi way_ribi = way && way->has_signal() ? gr->get_weg_ribi_unmasked(wegtyp) : tdriver->get_ribi(gr);
+				move_dir = next_ribi[r];
+				if(  (way_ribi & ~ribi_t::reverse_single(tmp->ribi_from) & move_dir) == 0  ) {
+					continue;
+				}
+				if(  !gr->get_neighbour(to, wegtyp, move_dir)  ||  to == avoid_ground  ||  closed[0].get(to)  ||  !tdriver->check_next_tile(to)  ) {
+					continue;
+				}
+				if(  !check_tile_entry(welt, to, move_dir, tdriver, max_speed, axle_load, convoy_weight, is_tall, tile_length, none, bridge_tile_count[0], step_cost)  ) {
+					continue;
+				}
+			}
+			else {
+				// a tile from which this one is entered, without turning back on this tile?
+				move_dir = ribi_t::reverse_single(next_ribi[r]);
+				if(  tmp->parent != NULL  &&  tmp->ribi_from == next_ribi[r]  ) {
+					continue;
+				}
+				grund_t *prev;
+				if(  !gr->get_neighbour(prev, wegtyp, next_ribi[r])  ||  prev == avoid_ground  ||  closed[1].get(prev)  ||  !tdriver->check_next_tile(prev)  ) {
+					continue;
+				}
+				const weg_t* way = prev->get_weg(wegtyp);
+				const ribi_t::ribi way_ribi = way && way->has_signal() ? prev->get_weg_ribi_unmasked(wegtyp) : tdriver->get_ribi(prev);
+				if(  (way_ribi & move_dir) == 0  ) {
+					continue;
+				}
+				if(  !check_tile_entry(welt, gr, move_dir, tdriver, max_speed, axle_load, convoy_weight, is_tall, tile_length, none, bridge_tile_count[1], step_cost)  ) {
+					continue;
+				}
+				to = prev;
+			}
+
+			uint32 new_g = tmp->g + step_cost;
+
+			// check for curves, as in the forward search
+			uint8 current_dir;
+			if(  tmp->parent != NULL  ) {
+				current_dir = move_dir | tmp->ribi_from;
+				if(  tmp->dir != current_dir  ) {
+					new_g += 30;
+					if(  tmp->parent->dir != tmp->dir  &&  tmp->parent->parent != NULL  ) {
+						// discourage 90 degree turns
+						new_g += 10;
+					}
+					else if(  ribi_t::is_perpendicular(tmp->dir, current_dir)  ) {
+						// discourage v turns heavily
+						new_g += 25;
+					}
+				}
+			}
+			else {
+				current_dir = move_dir;
+			}
+
+			// add new
+			ANode* k = &nodes[step];
+			step ++;
+			if (route_t::max_used_steps < step)
+				route_t::max_used_steps = step;
+
+			k->parent = tmp;
+			k->gr = to;
+			k->g = new_g;
+			k->f = (new_g + calc_distance(to->get_pos(), goal[s])) * 10;
+			k->dir = current_dir;
+			k->ribi_from = move_dir;
+			k->count = tmp->count + 1;
+			k->jps_ribi = ribi_t::all;
+
+			queue[s].insert(k);
+		}
+	}
+
+	if(  best_forward  &&  best_forward->count + best_backward->count > 0  ) {
+		// reached => construct route from both halves
+		const uint32 count = best_forward->count + best_backward->count;
+		route.store_at( count, ziel );
+		for(  ANode *tmp = best_forward;  tmp != NULL;  tmp = tmp->parent  ) {
+			route[ tmp->count ] = tmp->gr->get_pos();
+		}
+		for(  ANode *tmp = best_backward->parent;  tmp != NULL;  tmp = tmp->parent  ) {
+			route[ count - tmp->count ] = tmp->gr->get_pos();
+		}
+		ok = valid_route;
+	}
+	else if(  step >= MAX_STEP  ) {
+		dbg->warning("route_t::intern_calc_route_bidirectional()","Too many steps (%i>=max %i) in route (too long/complex)",step,MAX_STEP);
+		ok = route_too_complex;
+	}
+
+	delete [] closed;
+	RELEASE_NODES(ni);
+	return ok;
+}
+
+
 route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_speed, const sint64 max_cost, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, koord3d avoid_tile, uint8 start_dir, find_route_flags flags)
 {
 	route_result_t ok = no_route;
@@ -1040,7 +1501,6 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 	queue.insert(tmp);
 	ANode* new_top = NULL;
 
-	const uint8 enforce_weight_limits = welt->get_settings().get_enforce_weight_limits();
 #ifndef MULTI_THREAD
 	uint32 beat=1;
 #endif
@@ -1112,135 +1572,12 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 
 			// a way goes here, and it is not marked (i.e. in the closed list)
 			if((to  ||  gr->get_neighbour(to, wegtyp, next_ribi[r]))  &&  tdriver->check_next_tile(to)  &&  !marker.is_marked(to)) {
-				// Do not go on a tile where a one way sign forbids going.
-				// This saves time and fixed the bug in which a oneway sign on the final tile was ignored.
-				ribi_t::ribi last_dir = next_ribi[r];
-				weg_t *w = to->get_weg(wegtyp);
-				ribi_t::ribi go_dir = (w == NULL) ? 0 : w->get_ribi_maske();
-				if ((last_dir&go_dir) != 0)
-				{
-					if (tdriver->get_waytype() == track_wt || tdriver->get_waytype() == narrowgauge_wt || tdriver->get_waytype() == maglev_wt || tdriver->get_waytype() == tram_wt || tdriver->get_waytype() == monorail_wt)
-					{
-						// Unidirectional signals allow routing in both directions but only act in one direction. Check whether this is one of those.
-						if (!w->has_signal())
-						{
-							continue;
-						}
-					}
-					else
-					{
-						continue;
-					}
-				}
-
-				// Low bridges
-				if (is_tall && to->is_height_restricted())
+				uint32 step_cost;
+				if (!check_tile_entry(welt, to, next_ribi[r], tdriver, max_speed, axle_load, convoy_weight, is_tall, tile_length, flags, bridge_tile_count, step_cost))
 				{
 					continue;
 				}
-
-				// Weight limits
-				sint32 is_overweight = not_overweight;
-				if (enforce_weight_limits > 0 && w != NULL)
-				{
-					// Bernd Gabriel, Mar 10, 2010: way limit info
-					if (to->ist_bruecke() || w->get_desc()->get_styp() == type_elevated || w->get_waytype() == air_wt || w->get_waytype() == water_wt)
-					{
-						// Bridges care about convoy weight, whereas other types of way
-						// care about axle weight.
-						bridge_tile_count++;
-
-						// This is actually maximum convoy weight: the name is odd because of the virtual method.
-						uint32 way_max_convoy_weight;
-
-						// Trams need to check the weight of the underlying bridge.
-
-						if (w->get_desc()->get_styp() == type_tram)
-						{
-							const weg_t* underlying_bridge = welt->lookup(w->get_pos())->get_weg(road_wt);
-							if (!underlying_bridge)
-							{
-								goto check_axle_load;
-							}
-							way_max_convoy_weight = underlying_bridge->get_bridge_weight_limit();
-
-						}
-						else
-						{
-							way_max_convoy_weight = w->get_bridge_weight_limit();
-						}
-
-						// This ensures that only that part of the convoy that is actually on the bridge counts.
-						const sint32 proper_tile_length = tile_length > 8888 ? tile_length - 8888 : tile_length;
-						uint32 adjusted_convoy_weight = tile_length == 0 ? convoy_weight : (convoy_weight * max(bridge_tile_count - 2, 1)) / proper_tile_length;
-						const uint32 min_weight = min(adjusted_convoy_weight, convoy_weight);
-						if (min_weight > way_max_convoy_weight)
-						{
-							switch (enforce_weight_limits)
-							{
-							case 1:
-							default:
-
-								is_overweight = slowly_only;
-								break;
-
-							case 2:
-
-								is_overweight = cannot_route;
-								break;
-
-							case 3:
-
-								is_overweight = way_max_convoy_weight == 0 || (min_weight * 100) / way_max_convoy_weight > 110 ? cannot_route : slowly_only;
-								break;
-							}
-						}
-						if (to->ist_bruecke())
-						{
-							// For a real bridge, also check the axle load of the underlying way.
-							goto check_axle_load;
-						}
-					}
-					else
-					{
-					check_axle_load:
-						bridge_tile_count = 0;
-						const uint32 way_max_axle_load = w->get_max_axle_load();
-						max_axle_load = std::min(max_axle_load, way_max_axle_load);
-						if (axle_load > way_max_axle_load)
-						{
-							switch (enforce_weight_limits)
-							{
-							case 1:
-							default:
-
-								is_overweight = slowly_only;
-								break;
-
-							case 2:
-
-								is_overweight = cannot_route;
-								break;
-
-							case 3:
-
-								is_overweight = way_max_axle_load == 0 || (axle_load * 100) / way_max_axle_load > 110 ? cannot_route : slowly_only;
-								break;
-							}
-						}
-					}
-
-					if (is_overweight == cannot_route)
-					{
-						// Avoid routing over ways for which the convoy is overweight.
-						continue;
-					}
-
-				}
-
-				// new values for cost g (without way it is either in the air or in water => no costs)
-				const int way_cost = flags == simple_cost ? 1 : tdriver->get_cost(to, max_speed, next_ribi[r]) + (is_overweight == slowly_only ? 400 : 0);
-				uint32 new_g = tmp->g + (w ? way_cost : flags == simple_cost ? 1 : 10);
+				uint32 new_g = tmp->g + step_cost;
 
 				// check for curves (usually, one would need the lastlast and the last;
 				// if not there, then we could just take the last
@@ -1512,7 +1849,75 @@ void route_t::postprocess_water_route(karte_t *welt)
 	// profiling for routes ...
 	long ms=dr_time();
 #endif
-	route_result_t ok = intern_calc_route(welt, start, ziel, tdriver, max_khm, max_cost, axle_load, convoy_weight, is_tall, max_len, avoid_tile, direction, flags);
+	route_result_t ok = no_route;
+
+	// has the same route been found before?
+	route_cache_t *cache = NULL;
+	route_cache_key_t cache_key;
+	uint32 cache_generation = 0;
+	bool cached = false;
+	const waytype_t wt = tdriver->get_waytype();
+	if(  welt->get_settings().get_route_cache_size() > 0  &&  flags == none  &&  direction == ribi_t::all  &&  avoid_tile == koord3d::invalid  &&  max_cost == SINT64_MAX_VALUE
+		&&  wt >= 0  &&  wt < (int)lengthof(route_caches)  &&  tdriver->get_route_cache_signature(cache_key.signature)  ) {
+		cache = &route_caches[wt];
+		cache_key.start = start;
+		cache_key.ziel = ziel;
+		cache_key.max_speed = max_khm;
+		cache_key.axle_load = axle_load;
+		cache_key.convoy_weight = convoy_weight;
+		cache_key.tile_length = max_len;
+		cache_key.is_tall = is_tall;
+#ifdef MULTI_THREAD
+		pthread_mutex_lock(&route_cache_mutex);
+#endif
+		if(  cache->routes_generation != cache->generation  ) {
+			// the ways have changed since these routes were found
+			cache->clear();
+			cache->routes_generation = cache->generation;
+		}
+		cache_generation = cache->generation;
+		if(  const route_cache_entry_t *entry = cache->routes.get(cache_key)  ) {
+			route = entry->route;
+			max_axle_load = entry->max_axle_load;
+			max_convoy_weight = MAXUINT32;
+			ok = entry->result;
+			cached = true;
+		}
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock(&route_cache_mutex);
+#endif
+	}
+
+	if(  !cached  ) {
+		const uint16 bidirectional_distance = welt->get_settings().get_bidirectional_route_min_distance();
+		if(  bidirectional_distance > 0  &&  flags == none  &&  direction == ribi_t::all  &&  tdriver->get_waytype() != air_wt  &&  tdriver->get_waytype() != water_wt  &&  shortest_distance(start.get_2d(), ziel.get_2d()) >= bidirectional_distance  ) {
+			// aircraft and ships leave their ways, which the backwards search cannot follow
+			ok = intern_calc_route_bidirectional(welt, start, ziel, tdriver, max_khm, max_cost, axle_load, convoy_weight, is_tall, max_len, avoid_tile);
+		}
+		else {
+			ok = intern_calc_route(welt, start, ziel, tdriver, max_khm, max_cost, axle_load, convoy_weight, is_tall, max_len, avoid_tile, direction, flags);
+		}
+
+		if(  cache  ) {
+#ifdef MULTI_THREAD
+			pthread_mutex_lock(&route_cache_mutex);
+#endif
+			// do not keep a route found while the ways were changed
+			if(  cache->generation == cache_generation  &&  !cache->routes.get(cache_key)  ) {
+				if(  cache->routes.get_count() >= welt->get_settings().get_route_cache_size()  ) {
+					cache->clear();
+				}
+				route_cache_entry_t *entry = new route_cache_entry_t();
+				entry->route = route;
+				entry->max_axle_load = max_axle_load;
+				entry->result = ok;
+				cache->routes.put(cache_key, entry);
+			}
+#ifdef MULTI_THREAD
+			pthread_mutex_unlock(&route_cache_mutex);
+#endif
+		}
+	}
 #ifdef DEBUG_ROUTES
 	if(tdriver->get_waytype()==water_wt) {
 		DBG_DEBUG("route_t::calc_route()", "route from %d,%d to %d,%d with %i steps in %u ms found.", start.x, start.y, ziel.x, ziel.y, route.get_count()-1, dr_time()-ms );
@@ -46,6 +46,17 @@ private:
 	 */
 	route_result_t intern_calc_route(karte_t *w, koord3d start, koord3d ziel, test_driver_t* const tdriver, const sint32 max_kmh, const sint64 max_cost, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, const koord3d avoid_tile, uint8 start_dir = ribi_t::all, find_route_flags flags = none);
 
+	/**
+	 * Searches from both ends at once, meeting in the middle: for long routes, far fewer tiles are visited.
+	 * Used instead of intern_calc_route() for unrestricted routes which are long enough.
+	 */
+	route_result_t intern_calc_route_bidirectional(karte_t *w, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_kmh, const sint64 max_cost, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, const koord3d avoid_tile);
+
+	/**
+	 * Checks whether tile @p to may be entered in direction @p dir; if so, sets @p cost to the cost of entering it.
+	 */
+	bool check_tile_entry(karte_t *w, const grund_t *to, const ribi_t::ribi dir, test_driver_t* const tdriver, const sint32 max_kmh, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, find_route_flags flags, sint32 &bridge_tile_count, uint32 &cost);
+
 protected:
 	koord3d_vector_t route;           // The coordinates for the vehicle route
 
@@ -98,6 +109,12 @@ public:
 
 	static bool suspend_private_car_routing;
 
+	/**
+	 * Forgets the routes found for vehicles of waytype @p wt (any_wt: of all waytypes).
+	 * Must be called on every change of ways, signs or signals which may change the outcome of a route search.
+	 */
+	static void invalidate_route_cache(waytype_t wt);
+
 	const koord3d_vector_t &get_route() const { return route; }
 
 	uint32 get_max_axle_load() const { return max_axle_load; }
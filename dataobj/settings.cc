@@ -102,6 +102,7 @@ settings_t::settings_t() :
 	starting_year = 1930;
 	starting_month = 0;
 	bits_per_month = 20;
+	month_rollover_steps = 0;
 	calc_job_replenishment_ticks();
 	meters_per_tile = 1000;
 	base_meters_per_tile = 1000;
@@ -159,6 +160,7 @@ settings_t::settings_t() :
 
 	random_pedestrians = true;
 	stadtauto_duration = 36; // three years
+	sync_step_region_size = 0;
 
 	// to keep names consistent
 	numbered_stations = false;
@@ -168,6 +170,8 @@ settings_t::settings_t() :
 	num_industry_roads = 0;
 
 	max_route_steps = 1000000;
+	bidirectional_route_min_distance = 0;
+	route_cache_size = 0;
 	max_choose_route_steps = 200;
 	max_transfers = 9;
 	max_hops = 2000;
@@ -559,6 +563,10 @@ settings_t::settings_t() :
 
 	path_explorer_time_midpoint = 64;
 	save_path_explorer_data = true;
+	path_explorer_blocked_search = false;
+	path_explorer_parallel_compartments = false;
+	path_explorer_incremental_threshold = 0;
+	path_explorer_hub_label_threshold = 0;
 
 	show_future_vehicle_info = true;
 }
@@ -1955,6 +1963,71 @@ void settings_t::rdwr(loadsave_t *file)
 			file->rdwr_bool(do_not_record_private_car_routes_to_city_buildings);
 		}
 		// otherwise the default values of the last one will be used
+
+		if (file->is_version_ex_atleast(14, 65))
+		{
+			file->rdwr_bool(path_explorer_blocked_search);
+		}
+		else if (file->is_loading())
+		{
+			path_explorer_blocked_search = false;
+		}
+		if (file->is_version_ex_atleast(14, 66))
+		{
+			file->rdwr_bool(path_explorer_parallel_compartments);
+		}
+		else if (file->is_loading())
+		{
+			path_explorer_parallel_compartments = false;
+		}
+		if (file->is_version_ex_atleast(14, 67))
+		{
+			file->rdwr_long(path_explorer_incremental_threshold);
+		}
+		else if (file->is_loading())
+		{
+			path_explorer_incremental_threshold = 0;
+		}
+		if (file->is_version_ex_atleast(14, 68))
+		{
+			file->rdwr_long(path_explorer_hub_label_threshold);
+		}
+		else if (file->is_loading())
+		{
+			path_explorer_hub_label_threshold = 0;
+		}
+		if (file->is_version_ex_atleast(14, 69))
+		{
+			file->rdwr_short(bidirectional_route_min_distance);
+		}
+		else if (file->is_loading())
+		{
+			bidirectional_route_min_distance = 0;
+		}
+		if (file->is_version_ex_atleast(14, 70))
+		{
+			file->rdwr_long(route_cache_size);
+		}
+		else if (file->is_loading())
+		{
+			route_cache_size = 0;
+		}
+		if (file->is_version_ex_atleast(14, 71))
+		{
+			file->rdwr_short(month_rollover_steps);
+		}
+		else if (file->is_loading())
+		{
+			month_rollover_steps = 0;
+		}
+		if (file->is_version_ex_atleast(14, 72))
+		{
+			file->rdwr_short(sync_step_region_size);
+		}
+		else if (file->is_loading())
+		{
+			sync_step_region_size = 0;
+		}
 	}
 
 
@@ -2103,6 +2176,7 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	env_t::fps                         = contents.get_int_clamped( "frames_per_second",              env_t::fps,                       env_t::min_fps, env_t::max_fps );
 	env_t::ff_fps                      = contents.get_int_clamped( "fast_forward_frames_per_second", env_t::ff_fps,                    env_t::min_fps, env_t::max_fps );
 	env_t::num_threads                 = contents.get_int_clamped( "threads",                        env_t::num_threads,               1, MAX_THREADS );
+	env_t::rezoom_cache_size           = contents.get_int_clamped( "rezoom_cache_size",              env_t::rezoom_cache_size,         0, 4096 );
 	env_t::simple_drawing_default      = contents.get_int_clamped( "simple_drawing_tile_size",       env_t::simple_drawing_default,    2, 256 );
 	env_t::simple_drawing_fast_forward = contents.get_int( "simple_drawing_fast_forward", env_t::simple_drawing_fast_forward ) != 0;
 	env_t::visualize_schedule          = contents.get_int( "visualize_schedule",          env_t::visualize_schedule ) != 0;
@@ -2389,6 +2463,8 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	// routing stuff
 	max_route_steps        = contents.get_int_clamped( "max_route_steps",        max_route_steps,        0, INT_MAX );
 	max_choose_route_steps = contents.get_int_clamped( "max_choose_route_steps", max_choose_route_steps, 0, INT_MAX );
+	bidirectional_route_min_distance = contents.get_int_clamped( "bidirectional_route_min_distance", bidirectional_route_min_distance, 0, 65535 );
+	route_cache_size = contents.get_int_clamped( "route_cache_size", route_cache_size, 0, INT_MAX );
 	max_hops               = contents.get_int_clamped( "max_hops",               max_hops,               0, INT_MAX );
 	max_transfers          = contents.get_int_clamped( "max_transfers",          max_transfers,          0, INT_MAX );
 
@@ -2435,6 +2511,7 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	used_vehicle_reduction         = contents.get_int_clamped( "used_vehicle_reduction", used_vehicle_reduction, 0, 1000 );
 	traffic_level                  = contents.get_int_clamped( "citycar_level",          traffic_level,          0, 16);
 	stadtauto_duration             = contents.get_int_clamped( "default_citycar_life",   stadtauto_duration,     0, 1200 );
+	sync_step_region_size          = contents.get_int_clamped( "sync_step_region_size",  sync_step_region_size,  0, 1024 );
 
 	// starting money
 	starting_money = contents.get_int64( "starting_money", starting_money );
@@ -2517,6 +2594,7 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 
 	// time stuff
 	bits_per_month = contents.get_int_clamped( "bits_per_month", bits_per_month, 1, 31 );
+	month_rollover_steps = contents.get_int_clamped( "month_rollover_steps", month_rollover_steps, 0, 1000 );
 	calc_job_replenishment_ticks();
 	use_timeline   = contents.get_int_clamped( "use_timeline",   use_timeline,   0, 3 );
 	starting_year  = contents.get_int_clamped( "starting_year",  starting_year,  0, 0x7FFF);
@@ -2956,6 +3034,10 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 
 	path_explorer_time_midpoint = contents.get_int("path_explorer_time_midpoint", path_explorer_time_midpoint);
 	save_path_explorer_data = contents.get_int("save_path_explorer_data", save_path_explorer_data);
+	path_explorer_blocked_search = contents.get_int("path_explorer_blocked_search", path_explorer_blocked_search);
+	path_explorer_parallel_compartments = contents.get_int("path_explorer_parallel_compartments", path_explorer_parallel_compartments);
+	path_explorer_incremental_threshold = contents.get_int("path_explorer_incremental_threshold", path_explorer_incremental_threshold);
+	path_explorer_hub_label_threshold = contents.get_int("path_explorer_hub_label_threshold", path_explorer_hub_label_threshold);
 
 	show_future_vehicle_info = contents.get_int("show_future_vehicle_information", show_future_vehicle_info);
 
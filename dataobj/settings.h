@@ -189,6 +189,9 @@ private:
 	sint16 starting_month;
 	sint16 bits_per_month;
 
+	// ways, convoys and halts are rolled over into a new month in this many steps after the month change (0: all at once)
+	uint16 month_rollover_steps;
+
 	std::string filename;
 
 	bool beginner_mode;
@@ -233,6 +236,9 @@ private:
 
 	sint32 stadtauto_duration;
 
+	// private cars and pedestrians are stepped in parallel by square regions of this many tiles (0: one after another)
+	uint16 sync_step_region_size;
+
 	bool freeplay;
 
 	sint64 starting_money;
@@ -261,6 +267,12 @@ private:
 	/* maximum number of steps for breath search */
 	sint32 max_route_steps;
 
+	// routes between tiles at least this far apart are searched from both ends at once (0: never)
+	uint16 bidirectional_route_min_distance;
+
+	// the number of routes of vehicles kept for each waytype to be used again (0: none)
+	uint32 route_cache_size;
+
 	// maximum length for route search at signs/signals
 	sint32 max_choose_route_steps;
 
@@ -793,6 +805,22 @@ public:
 	uint32 path_explorer_time_midpoint;
 	bool save_path_explorer_data;
 
+	// Whether the path explorer searches paths with the cache-tiled (blocked) algorithm
+	// rather than by connection clusters. Both give valid routes, but not necessarily identical ones.
+	bool path_explorer_blocked_search;
+
+	// Whether the path explorer fills the matrices and explores the paths of all compartments concurrently,
+	// rather than working on one goods category/class compartment at a time.
+	bool path_explorer_parallel_compartments;
+
+	// The largest number of stops whose routes may have changed for which the path explorer
+	// repairs the existing paths rather than exploring them all again. 0 disables this.
+	uint32 path_explorer_incremental_threshold;
+
+	// The number of stops from which the path explorer stores the routes of a goods category/class
+	// as hub labels rather than as a table of all pairs of stops. 0 disables this.
+	uint32 path_explorer_hub_label_threshold;
+
 	// Whether players can know in advance the vehicle production end date and upgrade availability date
 	// If false, only information up to one year ahead
 	bool show_future_vehicle_info;
@@ -883,6 +911,7 @@ public:
 	sint16 get_starting_month() const {return starting_month;}
 
 	sint16 get_bits_per_month() const {return bits_per_month;}
+	uint16 get_month_rollover_steps() const { return month_rollover_steps; }
 
 	void set_filename(const char *n) {filename=n;}
 	const char* get_filename() const { return filename.c_str(); }
@@ -916,6 +945,9 @@ public:
 	void set_freeplay( bool f ) { freeplay = f; }
 
 	sint32 get_max_route_steps() const { return max_route_steps; }
+	uint16 get_bidirectional_route_min_distance() const { return bidirectional_route_min_distance; }
+	void set_bidirectional_route_min_distance(uint16 distance) { bidirectional_route_min_distance = distance; }
+	uint32 get_route_cache_size() const { return route_cache_size; }
 	sint32 get_max_choose_route_steps() const { return max_choose_route_steps; }
 	sint32 get_max_hops() const { return max_hops; }
 	sint32 get_max_transfers() const { return max_transfers; }
@@ -937,6 +969,8 @@ public:
 
 	sint32 get_stadtauto_duration() const { return stadtauto_duration; }
 
+	uint16 get_sync_step_region_size() const { return sync_step_region_size; }
+
 	sint32 get_beginner_price_factor() const { return beginner_price_factor; }
 
 	const way_desc_t *get_city_road_type( uint16 year );
@@ -1333,6 +1367,10 @@ public:
 
 	uint32 get_path_explorer_time_midpoint() const { return path_explorer_time_midpoint; }
 	bool get_save_path_explorer_data() const { return save_path_explorer_data; }
+	bool get_path_explorer_blocked_search() const { return path_explorer_blocked_search; }
+	bool get_path_explorer_parallel_compartments() const { return path_explorer_parallel_compartments; }
+	uint32 get_path_explorer_incremental_threshold() const { return path_explorer_incremental_threshold; }
+	uint32 get_path_explorer_hub_label_threshold() const { return path_explorer_hub_label_threshold; }
 
 	bool get_show_future_vehicle_info() const { return show_future_vehicle_info; }
 	//void set_show_future_vehicle_info(bool yesno) { show_future_vehicle_info = yesno; }
@@ -39,8 +39,9 @@ public:
 	image_id imageid; ///< set by register_image()
 	uint8 zoomable;   ///< some images may not be zoomed i.e. icons
 	PIXVAL *data;     ///< RLE encoded image data
+	bool external_data; ///< data points into a pak file in memory and is not ours to free
 
-	image_t(size_t len_ = 0) : data(NULL)
+	image_t(size_t len_ = 0) : data(NULL), external_data(false)
 	{
 		if (len_) {
 			alloc(len_);
@@ -49,14 +50,19 @@ public:
 
 	~image_t()
 	{
-		delete[] data;
+		if (!external_data) {
+			delete[] data;
+		}
 	}
 
 	void alloc(size_t len_)
 	{
-		delete[] data;
+		if (!external_data) {
+			delete[] data;
+		}
 		data = new PIXVAL[len_];
 		len = len_;
+		external_data = false;
 	}
 
 	static image_t* copy_image(const image_t& other);
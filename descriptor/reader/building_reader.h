@@ -21,7 +21,7 @@ public:
 	char const* get_type_name() const OVERRIDE { return "tile"; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *desc_buf, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -43,7 +43,7 @@ public:
 	char const* get_type_name() const OVERRIDE { return "building"; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *desc_buf, obj_node_info_t &node) OVERRIDE;
 
 };
 
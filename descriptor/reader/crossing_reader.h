@@ -25,7 +25,7 @@ public:
 	char const* get_type_name() const OVERRIDE { return "crossing"; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *desc_buf, obj_node_info_t &node) OVERRIDE;
 };
 
 #endif
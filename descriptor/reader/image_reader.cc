@@ -24,13 +24,10 @@
 #define skip_reading_pixels_if_no_graphics goto adjust_image
 #endif
 
-obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *image_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
-	ALLOCA(char, desc_buf, node.size);
 	image_t* desc=NULL;
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf+6;
 
 	// always zero in old version, since length was always less than 65535
@@ -96,15 +93,30 @@ obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		desc->w = decode_sint16(p);
 		p++; // skip version information
 		desc->h = decode_sint16(p);
-		desc->alloc((node.size - 10) / 2); // len
+		const size_t len = (node.size - 10) / 2;
 		desc->zoomable = decode_uint8(p);
 		desc->imageid = IMG_EMPTY;
 
-		skip_reading_pixels_if_no_graphics;
-		uint16* dest = desc->data;
-		if (desc->h > 0) {
-			for (uint i = 0; i < desc->len; i++) {
-				*dest++ = decode_uint16(p);
+#if COLOUR_DEPTH != 0  &&  !defined(SIM_BIG_ENDIAN)
+		if(  ((size_t)p & (sizeof(PIXVAL) - 1)) == 0  ) {
+			// the pixels in the file are already in our byte order, so use them in place;
+			// the pages of the mapped file are only loaded when needed
+			desc->data = (PIXVAL *)p;
+			desc->len = len;
+			desc->external_data = true;
+			keep_node_data();
+		}
+		else
+#endif
+		{
+			desc->alloc(len);
+
+			skip_reading_pixels_if_no_graphics;
+			uint16* dest = desc->data;
+			if (desc->h > 0) {
+				for (uint i = 0; i < desc->len; i++) {
+					*dest++ = decode_uint16(p);
+				}
 			}
 		}
 	}
@@ -21,13 +21,16 @@
 #include "../../dataobj/translator.h"
 #include "../../dataobj/environment.h"
 
+#include "../../utils/mapped_file.h"
 #include "../../utils/searchfolder.h"
 #include "../../utils/simstring.h"
 
 #include "../../tpl/inthashtable_tpl.h"
 #include "../../tpl/ptrhashtable_tpl.h"
 #include "../../tpl/stringhashtable_tpl.h"
+#include "../../tpl/vector_tpl.h"
 #include "../../simdebug.h"
+#include "../../utils/simthread.h"
 
 #include "../obj_desc.h"
 #include "../obj_node_info.h"
@@ -39,6 +42,77 @@ obj_reader_t::obj_map*                                        obj_reader_t::obj_
 inthashtable_tpl<obj_type, stringhashtable_tpl<obj_desc_t*, N_BAGS_LARGE>, N_BAGS_LARGE> obj_reader_t::loaded;
 obj_reader_t::unresolved_map                                  obj_reader_t::unresolved;
 ptrhashtable_tpl<obj_desc_t**, int, N_BAGS_SMALL>             obj_reader_t::fatals;
+vector_tpl<mapped_file_t *>                                   obj_reader_t::kept_files;
+bool                                                          obj_reader_t::keep_file = false;
+
+
+/**
+ * Header and position of a node in a pak file
+ */
+struct pak_node_t
+{
+	obj_node_info_t info;
+	size_t data; ///< offset of the node data in the file
+	uint32 next; ///< index of the next node after all children of this one
+};
+
+
+/**
+ * A pak file in memory and the index of its nodes
+ */
+struct pak_file_t
+{
+	const char *name;
+	mapped_file_t *file; ///< NULL if it could not be read
+	vector_tpl<pak_node_t> index;
+
+	pak_file_t() : name(NULL), file(NULL) {}
+	~pak_file_t() { delete file; }
+};
+
+
+static void open_pak(pak_file_t &pak, bool prefetch);
+
+#ifdef MULTI_THREAD
+/*
+ * With several threads, the files are opened and indexed by loader threads ahead of the main thread.
+ * Only the main thread reads nodes, since the readers register images and descriptors.
+ * So they are still read in the order of the files and the pakset checksum does not change.
+ */
+#define PAK_OPEN_AHEAD (64)
+
+static pthread_mutex_t pak_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pak_cond = PTHREAD_COND_INITIALIZER;
+static pak_file_t *pak_files;
+static bool *pak_opened;
+static uint32 pak_count;
+static uint32 pak_next_open; // next file to open by a loader thread
+static uint32 pak_next_read; // next file to read by the main thread
+
+static void *open_pak_thread( void * )
+{
+	pthread_mutex_lock( &pak_mutex );
+	while(  true  ) {
+		// do not map the whole pakset at once
+		while(  pak_next_open < pak_count  &&  pak_next_open >= pak_next_read + PAK_OPEN_AHEAD  ) {
+			pthread_cond_wait( &pak_cond, &pak_mutex );
+		}
+		if(  pak_next_open >= pak_count  ) {
+			break;
+		}
+		const uint32 i = pak_next_open++;
+		pthread_mutex_unlock( &pak_mutex );
+
+		open_pak( pak_files[i], true );
+
+		pthread_mutex_lock( &pak_mutex );
+		pak_opened[i] = true;
+		pthread_cond_broadcast( &pak_cond );
+	}
+	pthread_mutex_unlock( &pak_mutex );
+	return NULL;
+}
+#endif
 
 void obj_reader_t::register_reader()
 {
@@ -147,99 +221,218 @@ DBG_MESSAGE("obj_reader_t::load()","big logo %p", skinverwaltung_t::biglogosymbo
 
 DBG_MESSAGE("obj_reader_t::load()", "reading from '%s'", name.c_str());
 
+		pak_file_t *paks = new pak_file_t[max];
 		uint n = 0;
 		for(char* const& i : find) {
-			read_file(i);
-			if ((n++ & step) == 0 && drawing) {
-				ls.set_progress(n);
+			paks[n++].name = i;
+		}
+
+#ifdef MULTI_THREAD
+		int threads = 0;
+		pthread_t thread[MAX_THREADS];
+		pak_files = paks;
+		pak_opened = new bool[max]();
+		pak_count = max;
+		pak_next_open = 0;
+		pak_next_read = 0;
+		while(  threads < env_t::num_threads - 1  &&  pthread_create( &thread[threads], NULL, open_pak_thread, NULL ) == 0  ) {
+			threads++;
+		}
+#endif
+
+		for(  n = 0;  n < (uint)max;  n++  ) {
+#ifdef MULTI_THREAD
+			if(  threads > 0  ) {
+				pthread_mutex_lock( &pak_mutex );
+				pak_next_read = n;
+				pthread_cond_broadcast( &pak_cond );
+				while(  !pak_opened[n]  ) {
+					pthread_cond_wait( &pak_cond, &pak_mutex );
+				}
+				pthread_mutex_unlock( &pak_mutex );
+			}
+			else
+#endif
+			{
+				open_pak( paks[n], false );
+			}
+			read_pak( paks[n] );
+
+			if ((n & step) == 0 && drawing) {
+				ls.set_progress(n+1);
 			}
 		}
 		ls.set_progress(max);
 
+#ifdef MULTI_THREAD
+		for(  int t = 0;  t < threads;  t++  ) {
+			pthread_join( thread[t], NULL );
+		}
+		delete [] pak_opened;
+		pak_files = NULL;
+		pak_opened = NULL;
+#endif
+		delete [] paks;
+
 		return find.begin()!=find.end();
 	}
 	return false;
 }
 
 
-void obj_reader_t::read_file(const char *name)
+/**
+ * Reads a node header at @p pos and advances it to the node data.
+ * @returns false if the header or the data do not fit into the file
+ */
+static bool read_node_info(obj_node_info_t& node, char *file, size_t file_size, size_t &pos, uint32 const version)
 {
-	// added trace
-	DBG_DEBUG("obj_reader_t::read_file()", "filename='%s'", name);
+	if(  file_size - pos < OBJ_NODE_INFO_SIZE  ) {
+		return false;
+	}
+	char* p = file + pos;
+	node.type     = decode_uint32(p);
+	node.children = decode_uint16(p);
+	node.size     = decode_uint16(p);
+	// can have larger records
+	if (version != COMPILER_VERSION_CODE_11 && node.size == LARGE_RECORD_SIZE) {
+		if(  file_size - pos < EXT_OBJ_NODE_INFO_SIZE  ) {
+			return false;
+		}
+		node.size = decode_uint32(p);
+	}
+	pos = p - file;
+	return node.size <= file_size - pos;
+}
 
-	if (FILE* const fp = dr_fopen(name, "rb")) {
-		sint32 n = 0;
 
-		// This is the normal header reading code
-		int c;
-		do {
-			c = fgetc(fp);
-			n ++;
-		} while(!feof(fp) && c != 0x1a);
+/**
+ * Appends a node and all its children to @p index, in the order they are stored.
+ * Only the headers are read, so the data of unknown or skipped nodes is never touched.
+ * @returns false if the file ends early
+ */
+static bool index_nodes(char *file, size_t file_size, size_t &pos, uint32 version, vector_tpl<pak_node_t> &index)
+{
+	pak_node_t node;
+	if(  !read_node_info(node.info, file, file_size, pos, version)  ) {
+		return false;
+	}
+	node.data = pos;
+	pos += node.info.size;
 
-		if(feof(fp)) {
-			dbg->error("obj_reader_t::read_file()", "unexpected end of file after %d bytes while reading '%s'!",n, name);
-		}
-		else {
-//			DBG_DEBUG("obj_reader_t::read_file()", "skipped %d header bytes", n);
+	const uint32 n = index.get_count();
+	index.append(node);
+	for(  uint16 i = 0;  i < node.info.children;  i++  ) {
+		if(  !index_nodes(file, file_size, pos, version, index)  ) {
+			return false;
 		}
+	}
+	index[n].next = index.get_count();
+	return true;
+}
 
-		// Compiled Version
-		uint32 version = 0;
-		char dummy[4], *p;
-		p = dummy;
 
-		n = fread(dummy, 4, 1, fp);
-		version = decode_uint32(p);
+/**
+ * Maps a pak file and builds the index of its nodes.
+ * Does not touch any global state, so loader threads can open files.
+ */
+static void open_pak(pak_file_t &pak, bool prefetch)
+{
+	// added trace
+	DBG_DEBUG("obj_reader_t::read_file()", "filename='%s'", pak.name);
 
-		DBG_DEBUG("obj_reader_t::read_file()", "read %d blocks, file version is %x", n, version);
+	mapped_file_t *file = new mapped_file_t();
+	if(  !file->open(pak.name)  ) {
+		dbg->error("obj_reader_t::read_file()", "reading '%s' failed!", pak.name);
+		delete file;
+		return;
+	}
+	char *const data = file->get_data();
+	const size_t size = file->get_size();
 
-		if(version <= COMPILER_VERSION_CODE) {
-			obj_desc_t *data = NULL;
-			read_nodes(fp, data, 0, version );
-		}
-		else {
-			DBG_DEBUG("obj_reader_t::read_file()","version of '%s' is too old, %d instead of %d", name, version, COMPILER_VERSION_CODE );
-		}
-		fclose(fp);
+	// This is the normal header reading code
+	size_t pos = 0;
+	while(  pos < size  &&  data[pos] != 0x1a  ) {
+		pos++;
 	}
-	else {
-		dbg->error("obj_reader_t::read_file()", "reading '%s' failed!", name);
+	pos++;
+
+	if(  pos + 4 > size  ) {
+		dbg->error("obj_reader_t::read_file()", "unexpected end of file after %d bytes while reading '%s'!", (int)size, pak.name);
+		delete file;
+		return;
+	}
+
+	// Compiled Version
+	char *p = data + pos;
+	const uint32 version = decode_uint32(p);
+	pos += 4;
+
+	DBG_DEBUG("obj_reader_t::read_file()", "file version is %x", version);
+
+	if(  version > COMPILER_VERSION_CODE  ) {
+		DBG_DEBUG("obj_reader_t::read_file()","version of '%s' is too old, %d instead of %d", pak.name, version, COMPILER_VERSION_CODE );
+		delete file;
+		return;
+	}
+
+	// find all nodes first, so a damaged file is not read at all
+	if(  !index_nodes(data, size, pos, version, pak.index)  ) {
+		dbg->error("obj_reader_t::read_file()", "'%s' is truncated or damaged!", pak.name);
+		pak.index.clear();
+		delete file;
+		return;
 	}
+
+	if(  prefetch  ) {
+		file->prefetch();
+	}
+	pak.file = file;
 }
 
 
-static void read_node_info(obj_node_info_t& node, FILE* const f, uint32 const version)
+void obj_reader_t::read_pak(pak_file_t &pak)
 {
-	char data[EXT_OBJ_NODE_INFO_SIZE];
-
-	char* p = data;
-	fread(p, OBJ_NODE_INFO_SIZE, 1, f);
-	node.type     = decode_uint32(p);
-	node.children = decode_uint16(p);
-	node.size     = decode_uint16(p);
-	// can have larger records
-	if (version != COMPILER_VERSION_CODE_11 && node.size == LARGE_RECORD_SIZE) {
-		fread(p, sizeof(data) - OBJ_NODE_INFO_SIZE, 1, f);
-		node.size = decode_uint32(p);
+	if(  pak.file  &&  !pak.index.empty()  ) {
+		obj_desc_t *desc = NULL;
+		uint32 n = 0;
+		keep_file = false;
+		read_nodes(pak.file->get_data(), pak.index, n, desc, 0);
+		if(  keep_file  ) {
+			kept_files.append(pak.file);
+			pak.file = NULL;
+		}
 	}
+	// no longer needed
+	delete pak.file;
+	pak.file = NULL;
+	vector_tpl<pak_node_t> no_index;
+	swap(pak.index, no_index);
+}
+
+
+void obj_reader_t::read_file(const char *name)
+{
+	pak_file_t pak;
+	pak.name = name;
+	open_pak(pak, false);
+	read_pak(pak);
 }
 
 
-void obj_reader_t::read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes, uint32 version )
+void obj_reader_t::read_nodes(char *file, const vector_tpl<pak_node_t> &index, uint32 &n, obj_desc_t*& data, int register_nodes)
 {
-	obj_node_info_t node;
-	read_node_info(node, fp, version);
+	const pak_node_t &entry = index[n++];
+	obj_node_info_t node = entry.info;
 
 	obj_reader_t *reader = obj_reader->get(static_cast<obj_type>(node.type));
 	if(reader) {
 
 //DBG_DEBUG("obj_reader_t::read_nodes()","Reading %.4s-node of length %d with '%s'", reinterpret_cast<const char *>(&node.type), node.size, reader->get_type_name());
-		data = reader->read_node(fp, node);
+		data = reader->read_node(file + entry.data, node);
 		if (node.children != 0) {
 			data->children = new obj_desc_t*[node.children];
 			for (int i = 0; i < node.children; i++) {
-				read_nodes(fp, data->children[i], register_nodes + 1, version);
+				read_nodes(file, index, n, data->children[i], register_nodes + 1);
 			}
 		}
 
@@ -252,27 +445,12 @@ void obj_reader_t::read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes, u
 	else {
 		// no reader found ...
 		dbg->warning("obj_reader_t::read_nodes()","skipping unknown %.4s-node\n",reinterpret_cast<const char *>(&node.type));
-		fseek(fp, node.size, SEEK_CUR);
-		for(int i = 0; i < node.children; i++) {
-			skip_nodes(fp,version);
-		}
+		n = entry.next;
 		data = NULL;
 	}
 }
 
 
-void obj_reader_t::skip_nodes(FILE *fp,uint32 version)
-{
-	obj_node_info_t node;
-	read_node_info(node, fp, version);
-
-	fseek(fp, node.size, SEEK_CUR);
-	for(int i = 0; i < node.children; i++) {
-		skip_nodes(fp,version);
-	}
-}
-
-
 void obj_reader_t::resolve_xrefs()
 {
 	slist_tpl<obj_desc_t *> xref_nodes;
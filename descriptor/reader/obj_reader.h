@@ -21,6 +21,10 @@ template<class key_t, class value_t, size_t n_bags> class inthashtable_tpl;
 template<class value_t, size_t n_bags> class stringhashtable_tpl;
 template<class key_t, class value_t, size_t n_bags> class ptrhashtable_tpl;
 template<class T> class slist_tpl;
+template<class T> class vector_tpl;
+struct pak_node_t;
+struct pak_file_t;
+class mapped_file_t;
 
 
 
@@ -80,8 +84,13 @@ class obj_reader_t
 	static unresolved_map unresolved;
 	static ptrhashtable_tpl<obj_desc_t **, int, N_BAGS_SMALL>  fatals;
 
-	static void read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes,uint32 version);
-	static void skip_nodes(FILE *fp,uint32 version);
+	/// pak files, which must stay in memory as descriptors use their data
+	static vector_tpl<mapped_file_t *> kept_files;
+	static bool keep_file;
+
+	static void read_nodes(char *file, const vector_tpl<pak_node_t> &index, uint32 &n, obj_desc_t*& data, int register_nodes);
+	/// Reads the nodes of a file opened by open_pak(), must be done in the order of the files
+	static void read_pak(pak_file_t &pak);
 
 protected:
 	obj_reader_t() { /* Beware: Cannot register here! */}
@@ -91,9 +100,13 @@ protected:
 	static void xref_to_resolve(obj_type type, const char *name, obj_desc_t **dest, bool fatal);
 	static void resolve_xrefs();
 
-	/// Read a descriptor from @p fp. Does version check and compatibility transformations.
+	/// Read a descriptor from the node.size bytes at @p data. Does version check and compatibility transformations.
 	/// @returns The descriptor on success, or NULL on failure
-	virtual obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) = 0;
+	virtual obj_desc_t *read_node(char *data, obj_node_info_t &node) = 0;
+
+	/// Called by readers, if their descriptor points into the node data.
+	/// Then the pak file is kept in memory.
+	static void keep_node_data() { keep_file = true; }
 
 	/// Register descriptor so the object described by the descriptor can be built in-game.
 	virtual void register_obj(obj_desc_t *&/*desc*/) {}
@@ -29,13 +29,9 @@ void pier_reader_t::shufflemask(uint64 &mask){
     mask|= (tmp & 0x00FF000000000000) >> 8;
 }
 
-obj_desc_t * pier_reader_t::read_node(FILE *fp, obj_node_info_t &node){
-    ALLOCA(char, desc_buf, node.size);
-
+obj_desc_t * pier_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/){
     pier_desc_t *desc = new pier_desc_t();
 
-    fread(desc_buf, node.size, 1, fp);
-
     char * p = desc_buf;
 
     //read version
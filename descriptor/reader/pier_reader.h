@@ -22,7 +22,7 @@ protected:
 public:
     static pier_reader_t *instance() {return &the_instance; }
 
-    obj_desc_t * read_node(FILE *fp, obj_node_info_t &node) override;
+    obj_desc_t * read_node(char *desc_buf, obj_node_info_t &node) override;
 
     obj_type get_type() const override {return obj_pier; }
     char const* get_type_name() const override {return "pier";}
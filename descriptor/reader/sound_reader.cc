@@ -22,14 +22,10 @@ void sound_reader_t::register_obj(obj_desc_t *&data)
 }
 
 
-obj_desc_t * sound_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * sound_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	sound_desc_t *desc = new sound_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	const uint16 v = decode_uint16(p);
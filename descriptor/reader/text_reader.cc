@@ -3,7 +3,7 @@
  * (see LICENSE.txt)
  */
 
-#include <stdio.h>
+#include <string.h>
 #include "../../simdebug.h"
 
 #include "../text_desc.h"
@@ -12,15 +12,11 @@
 #include "../obj_node_info.h"
 
 
-obj_desc_t *text_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *text_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
 	text_desc_t *desc = new(node.size) text_desc_t();
 
-	// Read data
-	if (fread(desc->text, node.size, 1, fp) != 1) {
-		delete desc;
-		return NULL;
-	}
+	memcpy(desc->text, desc_buf, node.size);
 
 //	DBG_DEBUG("text_reader_t::read_node()", "%s",desc->get_text() );
 
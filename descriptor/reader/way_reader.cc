@@ -35,15 +35,11 @@ bool way_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t * way_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * way_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	way_desc_t *desc = new way_desc_t();
 	// DBG_DEBUG("way_reader_t::read_node()", "node size = %d", node.size);
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	// old versions of PAK files have no version stamp.
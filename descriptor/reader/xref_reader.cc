@@ -3,7 +3,7 @@
  * (see LICENSE.txt)
  */
 
-#include <stdio.h>
+#include <string.h>
 #include "../../simdebug.h"
 #include "../xref_desc.h"
 #include "xref_reader.h"
@@ -11,24 +11,20 @@
 #include "../obj_node_info.h"
 
 
-obj_desc_t *xref_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *xref_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
-	char buf[4 + 1];
-	if (fread(buf, 1, 5, fp) != 5) {
+	if (node.size < 4 + 1) {
 		return NULL;
 	}
 
 	const uint32 name_len = node.size - 4 - 1;
-	char *p = buf;
+	char *p = desc_buf;
 	xref_desc_t* desc = new(name_len) xref_desc_t();
 
 	desc->type = static_cast<obj_type>(decode_uint32(p));
 	desc->fatal = (decode_uint8(p) != 0);
 
-	if (fread(desc->name, 1, name_len, fp) != name_len) {
-		delete desc;
-		return NULL;
-	}
+	memcpy(desc->name, p, name_len);
 
 //	DBG_DEBUG("xref_reader_t::read_node()", "%s",desc->get_text() );
 
@@ -181,6 +181,12 @@ void display_mark_img_dirty( image_id image, scr_coord_val x, scr_coord_val y );
 void mark_rect_dirty_wc(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2, scr_coord_val y2); // clips to screen only
 void mark_rect_dirty_clip(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2, scr_coord_val y2  CLIP_NUM_DEF); // clips to clip_rect
 void mark_screen_dirty();
+bool display_is_rect_dirty(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2, scr_coord_val y2);
+
+// copy of the world view without overlays and windows, see main_view_t::display()
+void display_store_static_layer(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, scr_coord_val h, bool whole_view);
+bool display_restore_static_layer(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, scr_coord_val h);
+bool display_static_layer_valid();
 
 scr_coord_val display_get_width();
 scr_coord_val display_get_height();
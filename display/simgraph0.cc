@@ -75,6 +75,25 @@ void mark_screen_dirty()
 {
 }
 
+bool display_is_rect_dirty(scr_coord_val, scr_coord_val, scr_coord_val, scr_coord_val)
+{
+	return false;
+}
+
+void display_store_static_layer(scr_coord_val, scr_coord_val, scr_coord_val, scr_coord_val, bool)
+{
+}
+
+bool display_restore_static_layer(scr_coord_val, scr_coord_val, scr_coord_val, scr_coord_val)
+{
+	return false;
+}
+
+bool display_static_layer_valid()
+{
+	return false;
+}
+
 void display_mark_img_dirty(image_id, scr_coord_val, scr_coord_val)
 {
 }
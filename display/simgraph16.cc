@@ -44,6 +44,12 @@
 #	include <unistd.h>
 #endif
 
+// SSE2 is part of every x86-64 processor; other targets use the plain C loops
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define USE_SSE2_BLITTERS
+#	include <emmintrin.h>
+#endif
+
 #ifdef MULTI_THREAD
 #include "../utils/simthread.h"
 
@@ -284,6 +290,28 @@ inline PIXVAL blue(PIXVAL rgb) { return  rgb & 0x1F; }
 inline PIXVAL rgb_shr1(PIXVAL c) { return (c >> 1) & ONE_OUT; }
 inline PIXVAL rgb_shr2(PIXVAL c) { return (c >> 2) & TWO_OUT; }
 
+#ifdef USE_SSE2_BLITTERS
+/*
+ * The same for eight pixels at once.
+ * All of these give exactly the same pixels as the functions above.
+ */
+static inline __m128i rgb_shr1_sse2(__m128i c) { return _mm_and_si128( _mm_srli_epi16(c, 1), _mm_set1_epi16(ONE_OUT) ); }
+static inline __m128i rgb_shr2_sse2(__m128i c) { return _mm_and_si128( _mm_srli_epi16(c, 2), _mm_set1_epi16(TWO_OUT) ); }
+#ifdef RGB555
+static inline __m128i red_sse2(__m128i c) { return _mm_srli_epi16(c, 10); }
+static inline __m128i green_sse2(__m128i c) { return _mm_and_si128( _mm_srli_epi16(c, 5), _mm_set1_epi16(0x1F) ); }
+static inline __m128i rgb_sse2(__m128i r, __m128i g, __m128i b) { return _mm_or_si128( _mm_or_si128( _mm_slli_epi16(r, 10), _mm_slli_epi16(g, 5) ), b ); }
+#else
+static inline __m128i red_sse2(__m128i c) { return _mm_srli_epi16(c, 11); }
+static inline __m128i green_sse2(__m128i c) { return _mm_and_si128( _mm_srli_epi16(c, 5), _mm_set1_epi16(0x3F) ); }
+static inline __m128i rgb_sse2(__m128i r, __m128i g, __m128i b) { return _mm_or_si128( _mm_or_si128( _mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5) ), b ); }
+#endif
+static inline __m128i blue_sse2(__m128i c) { return _mm_and_si128( c, _mm_set1_epi16(0x1F) ); }
+
+static inline __m128i load_pixels_sse2(const PIXVAL *p) { return _mm_loadu_si128( (const __m128i *)p ); }
+static inline void store_pixels_sse2(PIXVAL *p, __m128i c) { _mm_storeu_si128( (__m128i *)p, c ); }
+#endif
+
 
 /*
  * mapping tables for RGB 555 to actual output format
@@ -331,6 +359,8 @@ PIXVAL specialcolormap_all_day[256];
 static uint8 player_offsets[MAX_PLAYER_COUNT][2];
 
 
+struct zoom_cache_entry_t;
+
 /*
  * Image map descriptor structure
  */
@@ -354,6 +384,8 @@ struct imd {
 	sint16 base_h; // height
 
 	PIXVAL* base_data; // original image data
+
+	zoom_cache_entry_t *zoom_cache; // zoomed data kept for other zoom levels
 };
 
 // Flags for recoding
@@ -373,9 +405,45 @@ static scr_coord_val disp_height = 480;
 /*
  * Static buffers for rezoom_img()
  */
-static uint8 *rezoom_baseimage[MAX_THREADS];
-static PIXVAL *rezoom_baseimage2[MAX_THREADS];
-static size_t rezoom_size[MAX_THREADS];
+struct rezoom_buffer_t {
+	uint8 *baseimage;
+	PIXVAL *baseimage2;
+	size_t size;
+};
+static rezoom_buffer_t rezoom_buffers[MAX_THREADS];
+
+/*
+ * Zoomed image data for one zoom level
+ */
+struct zoomed_image_t {
+	sint16 x, y, w, h;
+	uint32 len;
+	PIXVAL *data; // NULL if nothing is left after zooming
+};
+
+/*
+ * Zoomed data of other zoom levels than the current one.
+ * rezoom() moves the data of the old level in here and rezoom_img() takes it
+ * out again, so zooming back and forth does not rezoom the same images again.
+ * With MULTI_THREAD, a background thread adds the images shown before the zoom
+ * change for the new and the neighbouring zoom levels. The oldest entries are
+ * dropped when more than env_t::rezoom_cache_size MB are used.
+ */
+struct zoom_cache_entry_t {
+	zoomed_image_t zoomed;
+	image_id n;
+	uint8 zoom;
+	zoom_cache_entry_t *next_of_image; // other zoom levels of the same image
+	zoom_cache_entry_t *newer, *older;
+};
+
+static zoom_cache_entry_t *zoom_cache_newest = NULL;
+static zoom_cache_entry_t *zoom_cache_oldest = NULL;
+static size_t zoom_cache_bytes = 0;
+
+#ifdef MULTI_THREAD
+static pthread_mutex_t zoom_cache_mutex;
+#endif
 
 /*
  * Image table
@@ -399,6 +467,12 @@ static image_id alloc_images = 0;
  */
 static PIXVAL* textur = NULL;
 
+/*
+ * Copy of the world view without overlays and windows, see main_view_t::display()
+ */
+static PIXVAL* static_layer = NULL;
+static bool static_layer_valid = false;
+
 
 /*
  * dirty tile management structures
@@ -1116,6 +1190,97 @@ void mark_rect_dirty_clip(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2,
 void mark_screen_dirty()
 {
 	memset( tile_dirty, 0xFFFFFFFF, sizeof(uint32) * tile_buffer_length );
+	static_layer_valid = false;
+}
+
+
+/**
+ * Checks for tiles in a rectangle, which were marked dirty since the last display_flush_buffer()
+ */
+bool display_is_rect_dirty(scr_coord_val x1, scr_coord_val y1, scr_coord_val x2, scr_coord_val y2)
+{
+	x1 = max( x1, 0 );
+	y1 = max( y1, 0 );
+	x2 = min( x2, (scr_coord_val)(disp_width - 1) );
+	y2 = min( y2, (scr_coord_val)(disp_height - 1) );
+	if(  x1 > x2  ||  y1 > y2  ) {
+		return false;
+	}
+
+	x1 >>= DIRTY_TILE_SHIFT;
+	y1 >>= DIRTY_TILE_SHIFT;
+	x2 >>= DIRTY_TILE_SHIFT;
+	y2 >>= DIRTY_TILE_SHIFT;
+	for(  ;  y1 <= y2;  y1++  ) {
+		for(  int bit = y1 * tile_buffer_per_line + x1;  bit <= y1 * tile_buffer_per_line + x2;  bit++  ) {
+			if(  (tile_dirty[bit >> 5] >> (bit & 31)) & 1  ) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+// ------------------------- static layer of the world view ------------------------
+
+static bool clip_to_screen(scr_coord_val &xp, scr_coord_val &yp, scr_coord_val &w, scr_coord_val &h)
+{
+	if(  xp < 0  ) {
+		w += xp;
+		xp = 0;
+	}
+	if(  yp < 0  ) {
+		h += yp;
+		yp = 0;
+	}
+	w = min( w, (scr_coord_val)(disp_width - xp) );
+	h = min( h, (scr_coord_val)(disp_height - yp) );
+	return w > 0  &&  h > 0;
+}
+
+
+/**
+ * Copies a part of the screen into the static layer.
+ * @param whole_view true if this is the whole world view, which makes the layer valid
+ */
+void display_store_static_layer(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, scr_coord_val h, bool whole_view)
+{
+	if(  static_layer == NULL  ) {
+		static_layer = MALLOCN( PIXVAL, disp_width * disp_height );
+	}
+	if(  whole_view  ) {
+		static_layer_valid = true;
+	}
+	if(  clip_to_screen( xp, yp, w, h )  ) {
+		for(  scr_coord_val y = yp;  y < yp + h;  y++  ) {
+			memcpy( static_layer + y * disp_width + xp, textur + y * disp_width + xp, w * sizeof(PIXVAL) );
+		}
+	}
+}
+
+
+/**
+ * Copies a part of the static layer back to the screen
+ * @return false if the static layer is outdated, i.e. nothing was copied
+ */
+bool display_restore_static_layer(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, scr_coord_val h)
+{
+	if(  !static_layer_valid  ) {
+		return false;
+	}
+	if(  clip_to_screen( xp, yp, w, h )  ) {
+		for(  scr_coord_val y = yp;  y < yp + h;  y++  ) {
+			memcpy( textur + y * disp_width + xp, static_layer + y * disp_width + xp, w * sizeof(PIXVAL) );
+		}
+	}
+	return true;
+}
+
+
+bool display_static_layer_valid()
+{
+	return static_layer_valid;
 }
 
 
@@ -1142,16 +1307,152 @@ void display_mark_img_dirty(image_id image, scr_coord_val xp, scr_coord_val yp)
  * They are derived from a base image, which may need zooming too
  */
 
+/*
+ * The zoom cache; with MULTI_THREAD, zoom_cache_mutex must be held for all of these
+ */
+static size_t zoom_cache_entry_bytes(const zoom_cache_entry_t *entry)
+{
+	return sizeof(zoom_cache_entry_t) + entry->zoomed.len * sizeof(PIXVAL);
+}
+
+
+static zoom_cache_entry_t *zoom_cache_find(const image_id n, const uint8 zoom)
+{
+	for(  zoom_cache_entry_t *entry = images[n].zoom_cache;  entry != NULL;  entry = entry->next_of_image  ) {
+		if(  entry->zoom == zoom  ) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+
+static void zoom_cache_unlink(zoom_cache_entry_t *entry)
+{
+	for(  zoom_cache_entry_t **link = &images[entry->n].zoom_cache;  *link != NULL;  link = &(*link)->next_of_image  ) {
+		if(  *link == entry  ) {
+			*link = entry->next_of_image;
+			break;
+		}
+	}
+	if(  entry->newer  ) {
+		entry->newer->older = entry->older;
+	}
+	else {
+		zoom_cache_newest = entry->older;
+	}
+	if(  entry->older  ) {
+		entry->older->newer = entry->newer;
+	}
+	else {
+		zoom_cache_oldest = entry->newer;
+	}
+	zoom_cache_bytes -= zoom_cache_entry_bytes(entry);
+}
+
+
+// takes over zoomed.data
+static void zoom_cache_store(const image_id n, const uint8 zoom, const zoomed_image_t &zoomed)
+{
+	if(  env_t::rezoom_cache_size == 0  ||  zoom_cache_find(n, zoom) != NULL  ) {
+		free( zoomed.data );
+		return;
+	}
+
+	zoom_cache_entry_t *entry = new zoom_cache_entry_t;
+	entry->zoomed = zoomed;
+	entry->n = n;
+	entry->zoom = zoom;
+	entry->next_of_image = images[n].zoom_cache;
+	images[n].zoom_cache = entry;
+	entry->newer = NULL;
+	entry->older = zoom_cache_newest;
+	if(  zoom_cache_newest  ) {
+		zoom_cache_newest->newer = entry;
+	}
+	else {
+		zoom_cache_oldest = entry;
+	}
+	zoom_cache_newest = entry;
+	zoom_cache_bytes += zoom_cache_entry_bytes(entry);
+
+	// drop the oldest ones if too large
+	const size_t max_bytes = (size_t)env_t::rezoom_cache_size << 20;
+	while(  zoom_cache_bytes > max_bytes  ) {
+		zoom_cache_entry_t *oldest = zoom_cache_oldest;
+		zoom_cache_unlink(oldest);
+		free( oldest->zoomed.data );
+		delete oldest;
+	}
+}
+
+
+// moves the cached data into zoomed, if there is any
+static bool zoom_cache_take(const image_id n, const uint8 zoom, zoomed_image_t &zoomed)
+{
+	zoom_cache_entry_t *entry = zoom_cache_find(n, zoom);
+	if(  entry == NULL  ) {
+		return false;
+	}
+	zoom_cache_unlink(entry);
+	zoomed = entry->zoomed;
+	delete entry;
+	return true;
+}
+
+
+static void zoom_cache_clear()
+{
+	while(  zoom_cache_oldest  ) {
+		zoom_cache_entry_t *oldest = zoom_cache_oldest;
+		zoom_cache_unlink(oldest);
+		free( oldest->zoomed.data );
+		delete oldest;
+	}
+}
+
+
+#ifdef MULTI_THREAD
+static void start_prezoom(image_id *working_set, uint32 count, uint8 old_zoom);
+static void stop_prezoom();
+#endif
+
 /**
  * Flag all images for rezoom on next draw
+ * The zoomed data of the images drawn at old_zoom is kept in the zoom cache.
  */
-static void rezoom()
+static void rezoom(const uint8 old_zoom)
 {
+#ifdef MULTI_THREAD
+	stop_prezoom();
+	pthread_mutex_lock( &zoom_cache_mutex );
+#endif
+	static_layer_valid = false;
+	image_id *working_set = MALLOCN( image_id, max(anz_images, (image_id)1) );
+	uint32 working_set_count = 0;
+
 	for(  image_id n = 0;  n < anz_images;  n++  ) {
 		if(  (images[n].recode_flags & FLAG_ZOOMABLE) != 0  &&  images[n].base_h > 0  ) {
+			if(  (images[n].recode_flags & FLAG_REZOOM) == 0  ) {
+				// this image was drawn at old_zoom
+				if(  images[n].zoom_data != NULL  ) {
+					zoomed_image_t zoomed = { images[n].x, images[n].y, images[n].w, images[n].h, images[n].len, images[n].zoom_data };
+					zoom_cache_store( n, old_zoom, zoomed );
+					images[n].zoom_data = NULL;
+				}
+				working_set[working_set_count++] = n;
+			}
 			images[n].recode_flags |= FLAG_REZOOM;
 		}
 	}
+
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &zoom_cache_mutex );
+	// takes over working_set
+	start_prezoom( working_set, working_set_count, old_zoom );
+#else
+	free( working_set );
+#endif
 }
 
 int get_zoom_factor()
@@ -1163,10 +1464,11 @@ void set_zoom_factor(int z)
 {
 	// do not zoom beyond 4 pixels
 	if(  (base_tile_raster_width * zoom_num[z]) / zoom_den[z] > 4  ) {
+		const uint8 old_zoom = zoom_factor;
 		zoom_factor = z;
 		tile_raster_width = (base_tile_raster_width * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
 		dbg->message("set_zoom_factor()", "Zoom level now %d (%i/%i)", zoom_factor, zoom_num[zoom_factor], zoom_den[zoom_factor] );
-		rezoom();
+		rezoom(old_zoom);
 	}
 }
 
@@ -1369,10 +1671,437 @@ PIXVAL inline zoomin_pixel(uint8 *p, uint8* pab, uint8 *prl, uint8* pdia)
 
 
 /**
- * Convert base image data to actual image size
+ * Convert base image data of img to the size of the zoom level
  * Uses averages of all sampled points to get the "real" value
  * Blurs a bit
  */
+static void zoom_image_data(const imd &img, const uint32 zoom, rezoom_buffer_t &buf, zoomed_image_t &zoomed)
+{
+	zoomed.len = 0;
+	zoomed.data = NULL;
+
+	// now we want to downsize the image
+	// just divide the sizes
+	zoomed.x = (img.base_x * zoom_num[zoom]) / zoom_den[zoom];
+	zoomed.y = (img.base_y * zoom_num[zoom]) / zoom_den[zoom];
+	zoomed.w = (img.base_w * zoom_num[zoom]) / zoom_den[zoom];
+	zoomed.h = (img.base_h * zoom_num[zoom]) / zoom_den[zoom];
+
+	if(  zoomed.h > 0  &&  zoomed.w > 0  ) {
+		// just recalculate the image in the new size
+		PIXVAL *src = img.base_data;
+		PIXVAL *dest = NULL;
+		// embed the baseimage in an image with margin ~ remainder
+		const sint16 x_rem = (img.base_x * zoom_num[zoom]) % zoom_den[zoom];
+		const sint16 y_rem = (img.base_y * zoom_num[zoom]) % zoom_den[zoom];
+		const sint16 xl_margin = max( x_rem, 0);
+		const sint16 xr_margin = max(-x_rem, 0);
+		const sint16 yl_margin = max( y_rem, 0);
+		const sint16 yr_margin = max(-y_rem, 0);
+		// baseimage top-left  corner is at (xl_margin, yl_margin)
+		// ...       low-right corner is at (xr_margin, yr_margin)
+
+		sint32 orgzoomwidth = ((img.base_w + zoom_den[zoom] - 1 ) / zoom_den[zoom]) * zoom_den[zoom];
+		sint32 newzoomwidth = (orgzoomwidth*zoom_num[zoom])/zoom_den[zoom];
+		sint32 orgzoomheight = ((img.base_h + zoom_den[zoom] - 1 ) / zoom_den[zoom]) * zoom_den[zoom];
+		sint32 newzoomheight = (orgzoomheight * zoom_num[zoom]) / zoom_den[zoom];
+
+		// we will unpack, re-sample, pack it
+
+		// thus the unpack buffer must at least fit the window => find out maximum size
+		// Note: This value is certainly way bigger than the average size we'll get,
+		// but it's the worst scenario possible, a succession of solid - transparent - solid - transparent
+		// pattern.
+		// This would encode EACH LINE as:
+		// 0x0000 (0 transparent) 0x0001 PIXWORD 0x0001 (every 2 pixels, 3 words) 0x0000 (EOL)
+		// The extra +1 is to make sure we cover divisions with module != 0
+		// We end with an over sized buffer for the normal usage, but since it's re-used for all re-zooms,
+		// it's not performance critical and we are safe from all possible inputs.
+
+		size_t new_size = ( ( (newzoomwidth * 3) / 2 ) + 1 + 2) * newzoomheight * sizeof(PIXVAL);
+		size_t unpack_size = (xl_margin + orgzoomwidth + xr_margin) * (yl_margin + orgzoomheight + yr_margin) * 4;
+		if(  unpack_size > new_size  ) {
+			new_size = unpack_size;
+		}
+		new_size = ((new_size * 128) + 127) / 128; // enlarge slightly to try and keep buffers on their own cacheline for multithreaded access. A portable aligned_alloc would be better.
+		if(  buf.size < new_size  ) {
+			free( buf.baseimage2 );
+			free( buf.baseimage );
+			buf.size = new_size;
+			buf.baseimage  = MALLOCN( uint8, new_size );
+			buf.baseimage2 = (PIXVAL *)MALLOCN( uint8, new_size );
+		}
+		memset( buf.baseimage, 255, new_size ); // fill with invalid data to mark transparent regions
+
+		// index of top-left corner
+		uint32 baseoff = 4 * (yl_margin * (xl_margin + orgzoomwidth + xr_margin) + xl_margin);
+		sint32 basewidth = xl_margin + orgzoomwidth + xr_margin;
+
+		// now: unpack the image
+		for(  sint32 y = 0;  y < img.base_h;  ++y  ) {
+			uint16 runlen;
+			uint8 *p = buf.baseimage + baseoff + y * (basewidth * 4);
+
+			// decode line
+			runlen = *src++;
+			do {
+				// clear run
+				p += (runlen & ~TRANSPARENT_RUN) * 4;
+				// color pixel
+				runlen = (*src++) & ~TRANSPARENT_RUN;
+				while(  runlen--  ) {
+					// get rgb components
+					PIXVAL s = *src++;
+					*p++ = (s>>15);
+					*p++ = (s & 31);
+					s >>= 5;
+					*p++ = (s & 31);
+					s >>= 5;
+					*p++ = (s & 31);
+				}
+				runlen = *src++;
+			} while(  runlen != 0  );
+		}
+
+		// now we have the image, we do a repack then
+		dest = buf.baseimage2;
+		switch(  zoom_den[zoom]  ) {
+			case 1: {
+				assert(zoom_num[zoom]==2);
+
+				// first half row - just copy values, do not fiddle with neighbor colors
+				uint8 *p1 = buf.baseimage + baseoff;
+				for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
+					PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
+					// now set the pixel ...
+					dest[x * 2] = c1;
+					dest[x * 2 + 1] = c1;
+				}
+				// skip one line
+				dest += newzoomwidth;
+
+				for(  sint16 y = 0;  y < orgzoomheight - 1;  y++  ) {
+					uint8 *p1 = buf.baseimage + baseoff + y * (basewidth * 4);
+					// copy leftmost pixels
+					dest[0] = compress_pixel_transparent( p1 );
+					dest[newzoomwidth] = compress_pixel_transparent( p1 + basewidth * 4 );
+					for(  sint16 x = 0;  x < orgzoomwidth - 1;  x++  ) {
+						uint8 *px1 = p1 + (x * 4);
+						// pixel at 2,2 in 2x2 superpixel
+						dest[x * 2 + 1] = zoomin_pixel( px1, px1 + 4, px1 + basewidth * 4, px1 + basewidth * 4 + 4 );
+
+						// 2x2 superpixel is transparent but original pixel was not
+						// preserve one pixel
+						if(  dest[x * 2 + 1] == 0x73FE  &&  px1[0] != 255  &&  dest[x * 2] == 0x73FE  &&  dest[x * 2 - newzoomwidth] == 0x73FE  &&  dest[x * 2 - newzoomwidth - 1] == 0x73FE  ) {
+							// preserve one pixel
+							dest[x * 2 + 1] = compress_pixel( px1 );
+						}
+
+						// pixel at 2,1 in next 2x2 superpixel
+						dest[x * 2 + 2] = zoomin_pixel( px1 + 4, px1, px1 + basewidth * 4 + 4, px1 + basewidth * 4 );
+
+						// pixel at 1,2 in next row 2x2 superpixel
+						dest[x * 2 + newzoomwidth + 1] = zoomin_pixel( px1 + basewidth * 4, px1 + basewidth * 4 + 4, px1, px1 + 4 );
+
+						// pixel at 1,1 in next row next 2x2 superpixel
+						dest[x * 2 + newzoomwidth + 2] = zoomin_pixel( px1 + basewidth * 4 + 4, px1 + basewidth * 4, px1 + 4, px1 );
+					}
+					// copy rightmost pixels
+					dest[2 * orgzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) );
+					dest[2 * orgzoomwidth + newzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) + basewidth * 4 );
+					// skip two lines
+					dest += 2 * newzoomwidth;
+				}
+				// last half row - just copy values, do not fiddle with neighbor colors
+				p1 = buf.baseimage + baseoff + (orgzoomheight - 1) * (basewidth * 4);
+				for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
+					PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
+					// now set the pixel ...
+					dest[x * 2]   = c1;
+					dest[x * 2 + 1] = c1;
+				}
+				break;
+			}
+			case 2:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 0 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p2 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 1 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint8 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zoom] + 0 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zoom] + 1 - x_rem) / zoom_num[zoom]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) + (((uint16)(g/valid))<<5) + (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 3:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 0 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p2 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 1 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p3 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 2 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zoom] + 0 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zoom] + 1 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zoom] + 2 - x_rem) / zoom_num[zoom]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 4:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 0 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p2 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 1 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p3 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 2 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p4 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 3 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zoom] + 0 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zoom] + 1 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zoom] + 2 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal4 = ((x * zoom_den[zoom] + 3 - x_rem) / zoom_num[zoom]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p1 + xreal4 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p2 + xreal4 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						SumSubpixel( p3 + xreal4 );
+						SumSubpixel( p4 + xreal1 );
+						SumSubpixel( p4 + xreal2 );
+						SumSubpixel( p4 + xreal3 );
+						SumSubpixel( p4 + xreal4 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 8:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 0 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p2 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 1 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p3 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 2 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p4 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 3 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p5 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 4 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p6 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 5 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p7 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 6 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					uint8 *p8 = buf.baseimage + baseoff + ((y * zoom_den[zoom] + 7 - y_rem) / zoom_num[zoom]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zoom] + 0 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zoom] + 1 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zoom] + 2 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal4 = ((x * zoom_den[zoom] + 3 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal5 = ((x * zoom_den[zoom] + 4 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal6 = ((x * zoom_den[zoom] + 5 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal7 = ((x * zoom_den[zoom] + 6 - x_rem) / zoom_num[zoom]) * 4;
+						sint16 xreal8 = ((x * zoom_den[zoom] + 7 - x_rem) / zoom_num[zoom]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p1 + xreal4 );
+						SumSubpixel( p1 + xreal5 );
+						SumSubpixel( p1 + xreal6 );
+						SumSubpixel( p1 + xreal7 );
+						SumSubpixel( p1 + xreal8 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p2 + xreal4 );
+						SumSubpixel( p2 + xreal5 );
+						SumSubpixel( p2 + xreal6 );
+						SumSubpixel( p2 + xreal7 );
+						SumSubpixel( p2 + xreal8 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						SumSubpixel( p3 + xreal4 );
+						SumSubpixel( p3 + xreal5 );
+						SumSubpixel( p3 + xreal6 );
+						SumSubpixel( p3 + xreal7 );
+						SumSubpixel( p3 + xreal8 );
+						SumSubpixel( p4 + xreal1 );
+						SumSubpixel( p4 + xreal2 );
+						SumSubpixel( p4 + xreal3 );
+						SumSubpixel( p4 + xreal4 );
+						SumSubpixel( p4 + xreal5 );
+						SumSubpixel( p4 + xreal6 );
+						SumSubpixel( p4 + xreal7 );
+						SumSubpixel( p4 + xreal8 );
+						SumSubpixel( p5 + xreal1 );
+						SumSubpixel( p5 + xreal2 );
+						SumSubpixel( p5 + xreal3 );
+						SumSubpixel( p5 + xreal4 );
+						SumSubpixel( p5 + xreal5 );
+						SumSubpixel( p5 + xreal6 );
+						SumSubpixel( p5 + xreal7 );
+						SumSubpixel( p5 + xreal8 );
+						SumSubpixel( p6 + xreal1 );
+						SumSubpixel( p6 + xreal2 );
+						SumSubpixel( p6 + xreal3 );
+						SumSubpixel( p6 + xreal4 );
+						SumSubpixel( p6 + xreal5 );
+						SumSubpixel( p6 + xreal6 );
+						SumSubpixel( p6 + xreal7 );
+						SumSubpixel( p6 + xreal8 );
+						SumSubpixel( p7 + xreal1 );
+						SumSubpixel( p7 + xreal2 );
+						SumSubpixel( p7 + xreal3 );
+						SumSubpixel( p7 + xreal4 );
+						SumSubpixel( p7 + xreal5 );
+						SumSubpixel( p7 + xreal6 );
+						SumSubpixel( p7 + xreal7 );
+						SumSubpixel( p7 + xreal8 );
+						SumSubpixel( p8 + xreal1 );
+						SumSubpixel( p8 + xreal2 );
+						SumSubpixel( p8 + xreal3 );
+						SumSubpixel( p8 + xreal4 );
+						SumSubpixel( p8 + xreal5 );
+						SumSubpixel( p8 + xreal6 );
+						SumSubpixel( p8 + xreal7 );
+						SumSubpixel( p8 + xreal8 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			default: assert(0);
+		}
+
+		// now encode the image again
+		dest = (PIXVAL*)buf.baseimage;
+		for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+			PIXVAL *line = ((PIXVAL *)buf.baseimage2) + (y * newzoomwidth);
+			PIXVAL count;
+			sint16 x = 0;
+			uint16 clear_colored_run_pair_count = 0;
+
+			do {
+				// check length of transparent pixels
+				for(  count = 0;  x < newzoomwidth  &&  line[x] == 0x73FE;  count++, x++  )
+					{}
+				// first runlength: transparent pixels
+				*dest++ = count;
+				uint16 has_alpha = 0;
+				// copy for non-transparent
+				count = 0;
+				while(  x < newzoomwidth  &&  line[x] != 0x73FE  ) {
+					PIXVAL pixval = line[x++];
+					if(  pixval >= 0x8020  &&  !has_alpha  ) {
+						if(  count  ) {
+							*dest++ = count;
+							dest += count;
+							count = 0;
+							*dest++ = TRANSPARENT_RUN;
+						}
+						has_alpha = TRANSPARENT_RUN;
+					}
+					else if(  pixval < 0x8020  &&  has_alpha  ) {
+						if(  count  ) {
+							*dest++ = count+TRANSPARENT_RUN;
+							dest += count;
+							count = 0;
+							*dest++ = TRANSPARENT_RUN;
+						}
+						has_alpha = 0;
+					}
+					count++;
+					dest[count] = pixval;
+				}
+
+				/*
+				 * If it is not the first clear-colored-run pair and its colored run is empty
+				 * --> it is superfluous and can be removed by rolling back the pointer
+				 */
+				if(  clear_colored_run_pair_count > 0  &&  count == 0  ) {
+					dest--;
+					// this only happens at the end of a line, so no need to increment clear_colored_run_pair_count
+				}
+				else {
+					*dest++ = count+has_alpha; // number of colored pixels
+					dest += count; // skip them
+					clear_colored_run_pair_count++;
+				}
+			} while(  x < newzoomwidth  );
+			*dest++ = 0; // mark line end
+		}
+
+		// something left?
+		zoomed.w = newzoomwidth;
+		zoomed.h = newzoomheight;
+		if(  newzoomheight > 0  ) {
+			const size_t zoom_len = (size_t)(((uint8 *)dest) - ((uint8 *)buf.baseimage));
+			zoomed.len = (uint32)(zoom_len / sizeof(PIXVAL));
+			zoomed.data = MALLOCN(PIXVAL, zoomed.len);
+			assert( zoomed.data );
+			memcpy( zoomed.data, buf.baseimage, zoom_len );
+		}
+	}
+	else {
+//		if (zoomed.w <= 0) {
+//			// h=0 will be ignored, with w=0 there was an error!
+//			printf("WARNING: image%d w=0!\n", n);
+//		}
+		zoomed.h = 0;
+	}
+}
+
+
+/**
+ * Convert base image data to actual image size
+ */
 static void rezoom_img(const image_id n)
 {
 	// may this image be zoomed
@@ -1429,428 +2158,129 @@ static void rezoom_img(const image_id n)
 			return;
 		}
 
-		// now we want to downsize the image
-		// just divide the sizes
-		images[n].x = (images[n].base_x * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].y = (images[n].base_y * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].w = (images[n].base_w * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].h = (images[n].base_h * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-
-		if(  images[n].h > 0  &&  images[n].w > 0  ) {
-			// just recalculate the image in the new size
-			PIXVAL *src = images[n].base_data;
-			PIXVAL *dest = NULL;
-			// embed the baseimage in an image with margin ~ remainder
-			const sint16 x_rem = (images[n].base_x * zoom_num[zoom_factor]) % zoom_den[zoom_factor];
-			const sint16 y_rem = (images[n].base_y * zoom_num[zoom_factor]) % zoom_den[zoom_factor];
-			const sint16 xl_margin = max( x_rem, 0);
-			const sint16 xr_margin = max(-x_rem, 0);
-			const sint16 yl_margin = max( y_rem, 0);
-			const sint16 yr_margin = max(-y_rem, 0);
-			// baseimage top-left  corner is at (xl_margin, yl_margin)
-			// ...       low-right corner is at (xr_margin, yr_margin)
-
-			sint32 orgzoomwidth = ((images[n].base_w + zoom_den[zoom_factor] - 1 ) / zoom_den[zoom_factor]) * zoom_den[zoom_factor];
-			sint32 newzoomwidth = (orgzoomwidth*zoom_num[zoom_factor])/zoom_den[zoom_factor];
-			sint32 orgzoomheight = ((images[n].base_h + zoom_den[zoom_factor] - 1 ) / zoom_den[zoom_factor]) * zoom_den[zoom_factor];
-			sint32 newzoomheight = (orgzoomheight * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-
-			// we will unpack, re-sample, pack it
-
-			// thus the unpack buffer must at least fit the window => find out maximum size
-			// Note: This value is certainly way bigger than the average size we'll get,
-			// but it's the worst scenario possible, a succession of solid - transparent - solid - transparent
-			// pattern.
-			// This would encode EACH LINE as:
-			// 0x0000 (0 transparent) 0x0001 PIXWORD 0x0001 (every 2 pixels, 3 words) 0x0000 (EOL)
-			// The extra +1 is to make sure we cover divisions with module != 0
-			// We end with an over sized buffer for the normal usage, but since it's re-used for all re-zooms,
-			// it's not performance critical and we are safe from all possible inputs.
-
-			size_t new_size = ( ( (newzoomwidth * 3) / 2 ) + 1 + 2) * newzoomheight * sizeof(PIXVAL);
-			size_t unpack_size = (xl_margin + orgzoomwidth + xr_margin) * (yl_margin + orgzoomheight + yr_margin) * 4;
-			if(  unpack_size > new_size  ) {
-				new_size = unpack_size;
-			}
-			new_size = ((new_size * 128) + 127) / 128; // enlarge slightly to try and keep buffers on their own cacheline for multithreaded access. A portable aligned_alloc would be better.
-			if(  rezoom_size[n % env_t::num_threads] < new_size  ) {
-				free( rezoom_baseimage2[n % env_t::num_threads] );
-				free( rezoom_baseimage[n % env_t::num_threads] );
-				rezoom_size[n % env_t::num_threads] = new_size;
-				rezoom_baseimage[n % env_t::num_threads]  = MALLOCN( uint8, new_size );
-				rezoom_baseimage2[n % env_t::num_threads] = (PIXVAL *)MALLOCN( uint8, new_size );
-			}
-			memset( rezoom_baseimage[n % env_t::num_threads], 255, new_size ); // fill with invalid data to mark transparent regions
+		// already zoomed before or by the background thread?
+		zoomed_image_t zoomed;
+#ifdef MULTI_THREAD
+		pthread_mutex_lock( &zoom_cache_mutex );
+#endif
+		const bool cached = zoom_cache_take( n, zoom_factor, zoomed );
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock( &zoom_cache_mutex );
+#endif
+		if(  !cached  ) {
+			zoom_image_data( images[n], zoom_factor, rezoom_buffers[n % env_t::num_threads], zoomed );
+		}
 
-			// index of top-left corner
-			uint32 baseoff = 4 * (yl_margin * (xl_margin + orgzoomwidth + xr_margin) + xl_margin);
-			sint32 basewidth = xl_margin + orgzoomwidth + xr_margin;
+		images[n].x = zoomed.x;
+		images[n].y = zoomed.y;
+		images[n].w = zoomed.w;
+		images[n].h = zoomed.h;
+		if(  zoomed.data != NULL  ) {
+			images[n].len = zoomed.len;
+			images[n].zoom_data = zoomed.data;
+		}
+		images[n].recode_flags &= ~FLAG_REZOOM;
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
+#endif
+	}
+}
 
-			// now: unpack the image
-			for(  sint32 y = 0;  y < images[n].base_h;  ++y  ) {
-				uint16 runlen;
-				uint8 *p = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
 
-				// decode line
-				runlen = *src++;
-				do {
-					// clear run
-					p += (runlen & ~TRANSPARENT_RUN) * 4;
-					// color pixel
-					runlen = (*src++) & ~TRANSPARENT_RUN;
-					while(  runlen--  ) {
-						// get rgb components
-						PIXVAL s = *src++;
-						*p++ = (s>>15);
-						*p++ = (s & 31);
-						s >>= 5;
-						*p++ = (s & 31);
-						s >>= 5;
-						*p++ = (s & 31);
-					}
-					runlen = *src++;
-				} while(  runlen != 0  );
+#ifdef MULTI_THREAD
+/*
+ * Background pre-zooming of the working set after a zoom change
+ */
+static pthread_t prezoom_thread;
+static bool prezoom_running = false; // only used by the main thread
+static bool prezoom_abort = false; // protected by zoom_cache_mutex
+static image_id *prezoom_images = NULL;
+static uint32 prezoom_count = 0;
+static uint8 prezoom_levels[3];
+static uint8 prezoom_level_count = 0;
+static uint8 prezoom_current_level;
+static rezoom_buffer_t prezoom_buffer = { NULL, NULL, 0 };
+
+
+static void *prezoom_threaded(void *)
+{
+	for(  uint8 l = 0;  l < prezoom_level_count;  l++  ) {
+		const uint8 zoom = prezoom_levels[l];
+		for(  uint32 i = 0;  i < prezoom_count;  i++  ) {
+			const image_id n = prezoom_images[i];
+
+			pthread_mutex_lock( &zoom_cache_mutex );
+			const bool abort = prezoom_abort;
+			bool done = zoom_cache_find( n, zoom ) != NULL;
+			pthread_mutex_unlock( &zoom_cache_mutex );
+			if(  abort  ) {
+				return NULL;
+			}
+			if(  !done  &&  zoom == prezoom_current_level  ) {
+				// the display threads may have been faster
+				pthread_mutex_lock( &rezoom_img_mutex[n % env_t::num_threads] );
+				done = (images[n].recode_flags & FLAG_REZOOM) == 0;
+				pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
+			}
+			if(  done  ) {
+				continue;
 			}
 
-			// now we have the image, we do a repack then
-			dest = rezoom_baseimage2[n % env_t::num_threads];
-			switch(  zoom_den[zoom_factor]  ) {
-				case 1: {
-					assert(zoom_num[zoom_factor]==2);
-
-					// first half row - just copy values, do not fiddle with neighbor colors
-					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff;
-					for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
-						PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
-						// now set the pixel ...
-						dest[x * 2] = c1;
-						dest[x * 2 + 1] = c1;
-					}
-					// skip one line
-					dest += newzoomwidth;
-
-					for(  sint16 y = 0;  y < orgzoomheight - 1;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
-						// copy leftmost pixels
-						dest[0] = compress_pixel_transparent( p1 );
-						dest[newzoomwidth] = compress_pixel_transparent( p1 + basewidth * 4 );
-						for(  sint16 x = 0;  x < orgzoomwidth - 1;  x++  ) {
-							uint8 *px1 = p1 + (x * 4);
-							// pixel at 2,2 in 2x2 superpixel
-							dest[x * 2 + 1] = zoomin_pixel( px1, px1 + 4, px1 + basewidth * 4, px1 + basewidth * 4 + 4 );
-
-							// 2x2 superpixel is transparent but original pixel was not
-							// preserve one pixel
-							if(  dest[x * 2 + 1] == 0x73FE  &&  px1[0] != 255  &&  dest[x * 2] == 0x73FE  &&  dest[x * 2 - newzoomwidth] == 0x73FE  &&  dest[x * 2 - newzoomwidth - 1] == 0x73FE  ) {
-								// preserve one pixel
-								dest[x * 2 + 1] = compress_pixel( px1 );
-							}
+			zoomed_image_t zoomed;
+			zoom_image_data( images[n], zoom, prezoom_buffer, zoomed );
+			if(  zoomed.data != NULL  ) {
+				pthread_mutex_lock( &zoom_cache_mutex );
+				zoom_cache_store( n, zoom, zoomed );
+				pthread_mutex_unlock( &zoom_cache_mutex );
+			}
+		}
+	}
+	return NULL;
+}
 
-							// pixel at 2,1 in next 2x2 superpixel
-							dest[x * 2 + 2] = zoomin_pixel( px1 + 4, px1, px1 + basewidth * 4 + 4, px1 + basewidth * 4 );
 
-							// pixel at 1,2 in next row 2x2 superpixel
-							dest[x * 2 + newzoomwidth + 1] = zoomin_pixel( px1 + basewidth * 4, px1 + basewidth * 4 + 4, px1, px1 + 4 );
+// takes over working_set
+static void start_prezoom(image_id *working_set, uint32 count, uint8 old_zoom)
+{
+	free( prezoom_images );
+	prezoom_images = working_set;
+	prezoom_count = count;
 
-							// pixel at 1,1 in next row next 2x2 superpixel
-							dest[x * 2 + newzoomwidth + 2] = zoomin_pixel( px1 + basewidth * 4 + 4, px1 + basewidth * 4, px1 + 4, px1 );
-						}
-						// copy rightmost pixels
-						dest[2 * orgzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) );
-						dest[2 * orgzoomwidth + newzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) + basewidth * 4 );
-						// skip two lines
-						dest += 2 * newzoomwidth;
-					}
-					// last half row - just copy values, do not fiddle with neighbor colors
-					p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + (orgzoomheight - 1) * (basewidth * 4);
-					for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
-						PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
-						// now set the pixel ...
-						dest[x * 2]   = c1;
-						dest[x * 2 + 1] = c1;
-					}
-					break;
-				}
-				case 2:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint8 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) + (((uint16)(g/valid))<<5) + (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 3:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 4:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 3 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal4 = ((x * zoom_den[zoom_factor] + 3 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p1 + xreal4 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p2 + xreal4 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							SumSubpixel( p3 + xreal4 );
-							SumSubpixel( p4 + xreal1 );
-							SumSubpixel( p4 + xreal2 );
-							SumSubpixel( p4 + xreal3 );
-							SumSubpixel( p4 + xreal4 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 8:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 3 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p5 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 4 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p6 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 5 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p7 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 6 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p8 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 7 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal4 = ((x * zoom_den[zoom_factor] + 3 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal5 = ((x * zoom_den[zoom_factor] + 4 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal6 = ((x * zoom_den[zoom_factor] + 5 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal7 = ((x * zoom_den[zoom_factor] + 6 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal8 = ((x * zoom_den[zoom_factor] + 7 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p1 + xreal4 );
-							SumSubpixel( p1 + xreal5 );
-							SumSubpixel( p1 + xreal6 );
-							SumSubpixel( p1 + xreal7 );
-							SumSubpixel( p1 + xreal8 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p2 + xreal4 );
-							SumSubpixel( p2 + xreal5 );
-							SumSubpixel( p2 + xreal6 );
-							SumSubpixel( p2 + xreal7 );
-							SumSubpixel( p2 + xreal8 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							SumSubpixel( p3 + xreal4 );
-							SumSubpixel( p3 + xreal5 );
-							SumSubpixel( p3 + xreal6 );
-							SumSubpixel( p3 + xreal7 );
-							SumSubpixel( p3 + xreal8 );
-							SumSubpixel( p4 + xreal1 );
-							SumSubpixel( p4 + xreal2 );
-							SumSubpixel( p4 + xreal3 );
-							SumSubpixel( p4 + xreal4 );
-							SumSubpixel( p4 + xreal5 );
-							SumSubpixel( p4 + xreal6 );
-							SumSubpixel( p4 + xreal7 );
-							SumSubpixel( p4 + xreal8 );
-							SumSubpixel( p5 + xreal1 );
-							SumSubpixel( p5 + xreal2 );
-							SumSubpixel( p5 + xreal3 );
-							SumSubpixel( p5 + xreal4 );
-							SumSubpixel( p5 + xreal5 );
-							SumSubpixel( p5 + xreal6 );
-							SumSubpixel( p5 + xreal7 );
-							SumSubpixel( p5 + xreal8 );
-							SumSubpixel( p6 + xreal1 );
-							SumSubpixel( p6 + xreal2 );
-							SumSubpixel( p6 + xreal3 );
-							SumSubpixel( p6 + xreal4 );
-							SumSubpixel( p6 + xreal5 );
-							SumSubpixel( p6 + xreal6 );
-							SumSubpixel( p6 + xreal7 );
-							SumSubpixel( p6 + xreal8 );
-							SumSubpixel( p7 + xreal1 );
-							SumSubpixel( p7 + xreal2 );
-							SumSubpixel( p7 + xreal3 );
-							SumSubpixel( p7 + xreal4 );
-							SumSubpixel( p7 + xreal5 );
-							SumSubpixel( p7 + xreal6 );
-							SumSubpixel( p7 + xreal7 );
-							SumSubpixel( p7 + xreal8 );
-							SumSubpixel( p8 + xreal1 );
-							SumSubpixel( p8 + xreal2 );
-							SumSubpixel( p8 + xreal3 );
-							SumSubpixel( p8 + xreal4 );
-							SumSubpixel( p8 + xreal5 );
-							SumSubpixel( p8 + xreal6 );
-							SumSubpixel( p8 + xreal7 );
-							SumSubpixel( p8 + xreal8 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				default: assert(0);
-			}
+	// the current zoom level first, then the neighbours, which are the next ones zoomed to
+	prezoom_current_level = zoom_factor;
+	prezoom_level_count = 0;
+	const sint16 candidates[3] = { (sint16)zoom_factor, (sint16)(zoom_factor - 1), (sint16)(zoom_factor + 1) };
+	for(  int i = 0;  i < 3;  i++  ) {
+		if(  candidates[i] >= 0  &&  candidates[i] <= MAX_ZOOM_FACTOR  &&  candidates[i] != ZOOM_NEUTRAL  &&  candidates[i] != old_zoom  ) {
+			prezoom_levels[prezoom_level_count++] = (uint8)candidates[i];
+		}
+	}
 
-			// now encode the image again
-			dest = (PIXVAL*)rezoom_baseimage[n % env_t::num_threads];
-			for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-				PIXVAL *line = ((PIXVAL *)rezoom_baseimage2[n % env_t::num_threads]) + (y * newzoomwidth);
-				PIXVAL count;
-				sint16 x = 0;
-				uint16 clear_colored_run_pair_count = 0;
+	if(  env_t::rezoom_cache_size == 0  ||  prezoom_count == 0  ||  prezoom_level_count == 0  ) {
+		return;
+	}
 
-				do {
-					// check length of transparent pixels
-					for(  count = 0;  x < newzoomwidth  &&  line[x] == 0x73FE;  count++, x++  )
-						{}
-					// first runlength: transparent pixels
-					*dest++ = count;
-					uint16 has_alpha = 0;
-					// copy for non-transparent
-					count = 0;
-					while(  x < newzoomwidth  &&  line[x] != 0x73FE  ) {
-						PIXVAL pixval = line[x++];
-						if(  pixval >= 0x8020  &&  !has_alpha  ) {
-							if(  count  ) {
-								*dest++ = count;
-								dest += count;
-								count = 0;
-								*dest++ = TRANSPARENT_RUN;
-							}
-							has_alpha = TRANSPARENT_RUN;
-						}
-						else if(  pixval < 0x8020  &&  has_alpha  ) {
-							if(  count  ) {
-								*dest++ = count+TRANSPARENT_RUN;
-								dest += count;
-								count = 0;
-								*dest++ = TRANSPARENT_RUN;
-							}
-							has_alpha = 0;
-						}
-						count++;
-						dest[count] = pixval;
-					}
+	prezoom_abort = false;
+	pthread_attr_t attr;
+	pthread_attr_init( &attr );
+	pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_JOINABLE );
+	prezoom_running = pthread_create( &prezoom_thread, &attr, prezoom_threaded, NULL ) == 0;
+	pthread_attr_destroy( &attr );
+}
 
-					/*
-					 * If it is not the first clear-colored-run pair and its colored run is empty
-					 * --> it is superfluous and can be removed by rolling back the pointer
-					 */
-					if(  clear_colored_run_pair_count > 0  &&  count == 0  ) {
-						dest--;
-						// this only happens at the end of a line, so no need to increment clear_colored_run_pair_count
-					}
-					else {
-						*dest++ = count+has_alpha; // number of colored pixels
-						dest += count; // skip them
-						clear_colored_run_pair_count++;
-					}
-				} while(  x < newzoomwidth  );
-				*dest++ = 0; // mark line end
-			}
 
-			// something left?
-			images[n].w = newzoomwidth;
-			images[n].h = newzoomheight;
-			if(  newzoomheight > 0  ) {
-				const size_t zoom_len = (size_t)(((uint8 *)dest) - ((uint8 *)rezoom_baseimage[n % env_t::num_threads]));
-				images[n].len = (uint32)(zoom_len / sizeof(PIXVAL));
-				images[n].zoom_data = MALLOCN(PIXVAL, images[n].len);
-				assert( images[n].zoom_data );
-				memcpy( images[n].zoom_data, rezoom_baseimage[n % env_t::num_threads], zoom_len );
-			}
-		}
-		else {
-//			if (images[n].w <= 0) {
-//				// h=0 will be ignored, with w=0 there was an error!
-//				printf("WARNING: image%d w=0!\n", n);
-//			}
-			images[n].h = 0;
-		}
-		images[n].recode_flags &= ~FLAG_REZOOM;
-#ifdef MULTI_THREAD
-		pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
-#endif
+// must be called before the image table changes
+static void stop_prezoom()
+{
+	if(  prezoom_running  ) {
+		pthread_mutex_lock( &zoom_cache_mutex );
+		prezoom_abort = true;
+		pthread_mutex_unlock( &zoom_cache_mutex );
+		pthread_join( prezoom_thread, NULL );
+		prezoom_running = false;
 	}
 }
+#endif
 
 
 // force a certain size on a image (for rescaling tool images)
@@ -1877,6 +2307,7 @@ void display_fit_img_to_width( const image_id n, sint16 new_w )
 
 static void calc_base_pal_from_night_shift(const int night)
 {
+	static_layer_valid = false;
 	const int night2 = min(night, 4);
 	const int day = 4 - night2;
 	unsigned int i;
@@ -2015,6 +2446,11 @@ void register_image(image_t *image_in)
 		return;
 	}
 
+#ifdef MULTI_THREAD
+	// the background thread reads the image table
+	stop_prezoom();
+#endif
+
 	if(  anz_images == alloc_images  ) {
 		if(  images==NULL  ) {
 			alloc_images = 510;
@@ -2074,6 +2510,7 @@ void register_image(image_t *image_in)
 	}
 
 	image->zoom_data = NULL;
+	image->zoom_cache = NULL;
 	image->len = image_in->len;
 
 	image->base_x = image_in->x;
@@ -2093,6 +2530,12 @@ void register_image(image_t *image_in)
 // (mostly needed when changing climate zones)
 void display_free_all_images_above( image_id above )
 {
+#ifdef MULTI_THREAD
+	stop_prezoom();
+#endif
+	zoom_cache_clear();
+	static_layer_valid = false;
+
 	while(  above < anz_images  ) {
 		anz_images--;
 		if(  images[anz_images].zoom_data != NULL  ) {
@@ -2975,14 +3418,50 @@ PIXVAL display_blend_colors(PIXVAL background, PIXVAL foreground, int percent_bl
 typedef void (*blend_proc)(PIXVAL *dest, const PIXVAL *src, const PIXVAL colour, const PIXVAL len);
 
 // templated structures to specialize for the different blend modes: 25/50/75 percent
-struct blend25_t { static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return 3 * rgb_shr2(background) + rgb_shr2(foreground); } };
-struct blend50_t { static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return rgb_shr1(background) + rgb_shr1(foreground); }     };
-struct blend75_t { static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return rgb_shr2(background) + 3 * rgb_shr2(foreground); } };
+struct blend25_t {
+	static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return 3 * rgb_shr2(background) + rgb_shr2(foreground); }
+#ifdef USE_SSE2_BLITTERS
+	static inline __m128i blend8(__m128i background, __m128i foreground) {
+		const __m128i b = rgb_shr2_sse2(background);
+		return _mm_add_epi16( _mm_add_epi16( _mm_add_epi16(b, b), b ), rgb_shr2_sse2(foreground) );
+	}
+#endif
+};
+struct blend50_t {
+	static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return rgb_shr1(background) + rgb_shr1(foreground); }
+#ifdef USE_SSE2_BLITTERS
+	static inline __m128i blend8(__m128i background, __m128i foreground) { return _mm_add_epi16( rgb_shr1_sse2(background), rgb_shr1_sse2(foreground) ); }
+#endif
+};
+struct blend75_t {
+	static inline PIXVAL blend(PIXVAL background, PIXVAL foreground) { return rgb_shr2(background) + 3 * rgb_shr2(foreground); }
+#ifdef USE_SSE2_BLITTERS
+	static inline __m128i blend8(__m128i background, __m128i foreground) {
+		const __m128i f = rgb_shr2_sse2(foreground);
+		return _mm_add_epi16( rgb_shr2_sse2(background), _mm_add_epi16( _mm_add_epi16(f, f), f ) );
+	}
+#endif
+};
+
+
+#ifdef USE_SSE2_BLITTERS
+// looks up eight pixels in the colour map; there is no gather in SSE2
+static inline __m128i recode_pixels_sse2(const PIXVAL *src)
+{
+	return _mm_setr_epi16( rgbmap_current[src[0]], rgbmap_current[src[1]], rgbmap_current[src[2]], rgbmap_current[src[3]],
+		rgbmap_current[src[4]], rgbmap_current[src[5]], rgbmap_current[src[6]], rgbmap_current[src[7]] );
+}
+#endif
 
 
 template<class F> void pix_blend_tpl(PIXVAL *dest, const PIXVAL *src, const PIXVAL , const PIXVAL len)
 {
 	const PIXVAL *const end = dest + len;
+#ifdef USE_SSE2_BLITTERS
+	for(  ;  end - dest >= 8;  dest += 8, src += 8  ) {
+		store_pixels_sse2( dest, F::blend8( load_pixels_sse2(dest), load_pixels_sse2(src) ) );
+	}
+#endif
 	while (dest < end) {
 		*dest = F::blend(*dest, *src);
 		dest++;
@@ -2994,6 +3473,11 @@ template<class F> void pix_blend_tpl(PIXVAL *dest, const PIXVAL *src, const PIXV
 template<class F> void pix_blend_recode_tpl(PIXVAL *dest, const PIXVAL *src, const PIXVAL , const PIXVAL len)
 {
 	const PIXVAL *const end = dest + len;
+#ifdef USE_SSE2_BLITTERS
+	for(  ;  end - dest >= 8;  dest += 8, src += 8  ) {
+		store_pixels_sse2( dest, F::blend8( load_pixels_sse2(dest), recode_pixels_sse2(src) ) );
+	}
+#endif
 	while (dest < end) {
 		*dest = F::blend(*dest, rgbmap_current[*src]);
 		dest++;
@@ -3004,6 +3488,12 @@ template<class F> void pix_blend_recode_tpl(PIXVAL *dest, const PIXVAL *src, con
 template<class F> void pix_outline_tpl(PIXVAL *dest, const PIXVAL *, const PIXVAL colour, const PIXVAL len)
 {
 	const PIXVAL *const end = dest + len;
+#ifdef USE_SSE2_BLITTERS
+	const __m128i colour8 = _mm_set1_epi16( (short)colour );
+	for(  ;  end - dest >= 8;  dest += 8  ) {
+		store_pixels_sse2( dest, F::blend8( load_pixels_sse2(dest), colour8 ) );
+	}
+#endif
 	while (dest < end) {
 		*dest = F::blend(*dest, colour);
 		dest++;
@@ -3065,9 +3555,28 @@ void display_blend_wh_rgb(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, s
 					const PIXVAL r_src = red(colval);
 					const PIXVAL g_src = green(colval);
 					const PIXVAL b_src = blue(colval);
+#ifdef USE_SSE2_BLITTERS
+					const __m128i r_src8 = _mm_set1_epi16(r_src);
+					const __m128i g_src8 = _mm_set1_epi16(g_src);
+					const __m128i b_src8 = _mm_set1_epi16(b_src);
+					const __m128i alpha8 = _mm_set1_epi16(alpha);
+#endif
 					for(  ;  h>0;  yp++, h--  ) {
 						PIXVAL *dest = textur + yp*disp_width + xp;
 						const PIXVAL *const end = dest + w;
+#ifdef USE_SSE2_BLITTERS
+						for(  ;  end - dest >= 8;  dest += 8  ) {
+							// the differences and their products fit into 16 bits with sign
+							const __m128i d = load_pixels_sse2(dest);
+							const __m128i r_dest = red_sse2(d);
+							const __m128i g_dest = green_sse2(d);
+							const __m128i b_dest = blue_sse2(d);
+							const __m128i r = _mm_add_epi16( r_dest, _mm_srai_epi16( _mm_mullo_epi16( _mm_sub_epi16(r_src8, r_dest), alpha8 ), 6 ) );
+							const __m128i g = _mm_add_epi16( g_dest, _mm_srai_epi16( _mm_mullo_epi16( _mm_sub_epi16(g_src8, g_dest), alpha8 ), 6 ) );
+							const __m128i b = _mm_add_epi16( b_dest, _mm_srai_epi16( _mm_mullo_epi16( _mm_sub_epi16(b_src8, b_dest), alpha8 ), 6 ) );
+							store_pixels_sse2( dest, rgb_sse2(r, g, b) );
+						}
+#endif
 						while (dest < end) {
 							const PIXVAL r_dest = red(*dest);
 							const PIXVAL g_dest = green(*dest);
@@ -3153,10 +3662,45 @@ static PIXVAL get_alpha_mask(const unsigned alpha_flags)
 
 typedef void (*alpha_proc)(PIXVAL *dest, const PIXVAL *src, const PIXVAL *alphamap, const PIXVAL alpha_mask, const PIXVAL colour, const PIXVAL len);
 
+// MASK_32 drops the lowest bit of red for RGB555, which this would not; so keep the C loops there
+#if defined(USE_SSE2_BLITTERS) && !defined(RGB555)
+#define USE_SSE2_ALPHA
+
+/**
+ * Blends eight pixels like alpha() does one by one. An alpha of 32 yields the
+ * source and 0 the background, so the opaque and invisible cases need no branch.
+ */
+static inline __m128i alpha_blend_sse2(__m128i background, __m128i foreground, const PIXVAL *alphamap, const __m128i alpha_mask)
+{
+	// read mask components - always 15bpp
+	const __m128i five_bits = _mm_set1_epi16(0x1f);
+	const __m128i masked = _mm_and_si128( load_pixels_sse2(alphamap), alpha_mask );
+	__m128i alpha_value = _mm_add_epi16( _mm_add_epi16( _mm_and_si128(masked, five_bits), _mm_and_si128( _mm_srli_epi16(masked, 5), five_bits ) ), _mm_srli_epi16(masked, 10) );
+	// alpha_value > 15 ? alpha_value + 1 : alpha_value, and at most 32 (opaque)
+	alpha_value = _mm_sub_epi16( alpha_value, _mm_cmpgt_epi16( alpha_value, _mm_set1_epi16(15) ) );
+	alpha_value = _mm_min_epi16( alpha_value, _mm_set1_epi16(32) );
+	const __m128i inverse = _mm_sub_epi16( _mm_set1_epi16(32), alpha_value );
+
+	// as colors_blend_alpha32(), one component after the other
+	const __m128i r = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( red_sse2(foreground), alpha_value ), _mm_mullo_epi16( red_sse2(background), inverse ) ), 5 );
+	const __m128i g = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( green_sse2(foreground), alpha_value ), _mm_mullo_epi16( green_sse2(background), inverse ) ), 5 );
+	const __m128i b = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( blue_sse2(foreground), alpha_value ), _mm_mullo_epi16( blue_sse2(background), inverse ) ), 5 );
+	return rgb_sse2(r, g, b);
+}
+#endif
+
+
 static void alpha(PIXVAL *dest, const PIXVAL *src, const PIXVAL *alphamap, const PIXVAL alpha_mask, const PIXVAL , const PIXVAL len)
 {
 	const PIXVAL *const end = dest + len;
 
+#ifdef USE_SSE2_ALPHA
+	const __m128i alpha_mask8 = _mm_set1_epi16( (short)alpha_mask );
+	for(  ;  end - dest >= 8;  dest += 8, src += 8, alphamap += 8  ) {
+		store_pixels_sse2( dest, alpha_blend_sse2( load_pixels_sse2(dest), load_pixels_sse2(src), alphamap, alpha_mask8 ) );
+	}
+#endif
+
 	while(  dest < end  ) {
 		// read mask components - always 15bpp
 		uint16 masked = *alphamap & alpha_mask;
@@ -3183,6 +3727,13 @@ static void alpha_recode(PIXVAL *dest, const PIXVAL *src, const PIXVAL *alphamap
 {
 	const PIXVAL *const end = dest + len;
 
+#ifdef USE_SSE2_ALPHA
+	const __m128i alpha_mask8 = _mm_set1_epi16( (short)alpha_mask );
+	for(  ;  end - dest >= 8;  dest += 8, src += 8, alphamap += 8  ) {
+		store_pixels_sse2( dest, alpha_blend_sse2( load_pixels_sse2(dest), recode_pixels_sse2(src), alphamap, alpha_mask8 ) );
+	}
+#endif
+
 	while(  dest < end  ) {
 		// read mask components - always 15bpp
 		uint16 masked = *alphamap & alpha_mask;
@@ -5268,10 +5819,13 @@ bool simgraph_init(scr_size window_size, sint16 full_screen)
 #ifdef MULTI_THREAD
 		pthread_mutex_init( &rezoom_img_mutex[i], NULL );
 #endif
-		rezoom_baseimage[i] = NULL;
-		rezoom_baseimage2[i] = NULL;
-		rezoom_size[i] = 0;
+		rezoom_buffers[i].baseimage = NULL;
+		rezoom_buffers[i].baseimage2 = NULL;
+		rezoom_buffers[i].size = 0;
 	}
+#ifdef MULTI_THREAD
+	pthread_mutex_init( &zoom_cache_mutex, NULL );
+#endif
 
 	// get real width from os-dependent routines
 	disp_width = dr_os_open(window_size, full_screen);
@@ -5355,12 +5909,22 @@ void simgraph_exit()
 
 	free( tile_dirty_old );
 	free( tile_dirty );
+	free( static_layer );
 	display_free_all_images_above(0);
 	free(images);
 
 	tile_dirty = tile_dirty_old = NULL;
+	static_layer = NULL;
 	images = NULL;
 #ifdef MULTI_THREAD
+	free( prezoom_images );
+	free( prezoom_buffer.baseimage );
+	free( prezoom_buffer.baseimage2 );
+	prezoom_images = NULL;
+	prezoom_buffer.baseimage = NULL;
+	prezoom_buffer.baseimage2 = NULL;
+	prezoom_buffer.size = 0;
+	pthread_mutex_destroy( &zoom_cache_mutex );
 	pthread_mutex_destroy( &recode_img_mutex );
 	for(  int i = 0;  i < MAX_THREADS;  i++  ) {
 		pthread_mutex_destroy( &rezoom_img_mutex[i] );
@@ -5396,6 +5960,9 @@ void simgraph_resize(scr_size new_window_size)
 			tile_dirty = MALLOCN( uint32, tile_buffer_length );
 			tile_dirty_old = MALLOCN( uint32, tile_buffer_length );
 
+			free( static_layer );
+			static_layer = NULL;
+
 			display_set_clip_wh(0, 0, disp_actual_width, disp_height);
 		}
 
@@ -21,7 +21,9 @@
 #include "../boden/wasser.h"
 #include "../dataobj/environment.h"
 #include "../obj/zeiger.h"
+#include "../dataobj/rect.h"
 #include "../utils/simrandom.h"
+#include "../tpl/vector_tpl.h"
 
 uint16 win_get_statusbar_height(); // simwin.h
 
@@ -34,6 +36,62 @@ main_view_t::main_view_t(karte_t *welt)
 }
 
 #if COLOUR_DEPTH != 0
+/*
+ * The world view of the last frame is kept as static layer (see display_store_static_layer()).
+ * If nothing but a few objects changed, only the vertical strips of the screen around them are
+ * drawn again. Everything that changes the whole view must be part of this key.
+ */
+struct static_layer_key_t {
+	sint32 i_off, j_off, x_off, y_off;
+	sint32 img_size;
+	sint32 clip_x, clip_y, clip_w, clip_h;
+	sint8 underground_mode, underground_level;
+	bool show_grid, hide_trees, hide_with_transparency, hide_under_cursor, simple_drawing;
+	bool draw_earth_border, draw_outside_tile;
+	uint8 hide_buildings;
+};
+
+static static_layer_key_t static_layer_key;
+
+#define STATIC_LAYER_STRIP_WIDTH (64)
+
+// strips with dirty tiles after drawing the last frame
+static vector_tpl<bool> dirty_strips;
+
+
+/**
+ * Sets the strips of the view dirty, which contain tiles or objects changed since the last frame.
+ * The strips span the whole height of the view, so only the x position matters.
+ */
+void main_view_t::mark_changed_tiles( const rect_t &view_rect, const scr_rect &clip_rr, scr_coord_val raster )
+{
+	const koord end = view_rect.origin + view_rect.size;
+	for(  sint16 j = view_rect.origin.y;  j < end.y;  j++  ) {
+		for(  sint16 i = view_rect.origin.x;  i < end.x;  i++  ) {
+			const planquadrat_t *plan = welt->access_nocheck( i, j );
+			bool changed = false;
+			for(  uint8 b = 0;  b < plan->get_boden_count()  &&  !changed;  b++  ) {
+				const grund_t *gr = plan->get_boden_bei( b );
+				changed = gr->get_flag( grund_t::dirty );
+				for(  uint8 n = 0;  n < gr->get_top()  &&  !changed;  n++  ) {
+					changed = gr->obj_bei( n )->get_flag( obj_t::dirty );
+				}
+			}
+			if(  !changed  ) {
+				continue;
+			}
+			// objects may be offset by up to half a tile
+			const scr_coord_val x = viewport->get_screen_coord( koord3d( i, j, 0 ) ).x;
+			const sint32 first = max( 0, ( x - raster / 2 - clip_rr.x ) / STATIC_LAYER_STRIP_WIDTH );
+			const sint32 last = min( (sint32)dirty_strips.get_count() - 1, ( x + raster + raster / 2 - clip_rr.x ) / STATIC_LAYER_STRIP_WIDTH );
+			for(  sint32 s = first;  s <= last;  s++  ) {
+				dirty_strips[s] = true;
+			}
+		}
+	}
+}
+
+
 static const sint8 hours2night[] =
 {
 	4,4,4,4,4,4,4,4,
@@ -45,7 +103,31 @@ static const sint8 hours2night[] =
 };
 #endif
 
+#if COLOUR_DEPTH != 0
+/*
+ * The view is drawn in vertical bands. With several threads, each takes the next band
+ * until none is left, so threads with cheap bands (water, fields) help out with the
+ * expensive ones (cities, mountains).
+ */
+#define RENDER_BANDS_PER_THREAD (4)
+
+static vector_tpl<scr_rect> bands;
+
+// splits the columns [x, x+w) of the view into bands of about band_width
+static void append_bands( scr_coord_val x, scr_coord_val w, const scr_rect &clip_rr, scr_coord_val band_width )
+{
+	while(  w > 0  ) {
+		// no slim band at the end
+		const scr_coord_val bw = w < band_width + band_width / 2 ? w : band_width;
+		bands.append( scr_rect( x, clip_rr.y, bw, clip_rr.h ) );
+		x += bw;
+		w -= bw;
+	}
+}
+#endif
+
 #ifdef MULTI_THREAD
+#include <chrono>
 #include "../utils/simthread.h"
 
 bool spawned_threads=false; // global job indicator array
@@ -55,8 +137,6 @@ static simthread_barrier_t display_barrier_end;
 // to start a thread
 typedef struct{
 	main_view_t *show_routine;
-	koord   lt_cl, wh_cl; // pos/size of clipping rect for this thread
-	koord   lt, wh;       // pos/size of region to display. set larger than clipping for correct display of trees at thread seams
 	sint16  y_min;
 	sint16  y_max;
 	sint8   thread_num;
@@ -65,18 +145,11 @@ typedef struct{
 // now the parameters
 static display_region_param_t ka[MAX_THREADS];
 
-void *display_region_thread( void *ptr )
-{
-	display_region_param_t *view = reinterpret_cast<display_region_param_t *>(ptr);
+// next band to draw
+static uint32 next_band = 0;
+static pthread_mutex_t band_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-	while(true) {
-		simthread_barrier_wait( &display_barrier_start ); // wait for all to start
-		clear_all_poly_clip( view->thread_num );
-		display_set_clip_wh( view->lt_cl.x, view->lt_cl.y, view->wh_cl.x, view->wh_cl.y, view->thread_num );
-		view->show_routine->display_region( view->lt, view->wh, view->y_min, view->y_max, false, true, view->thread_num );
-		simthread_barrier_wait( &display_barrier_end ); // wait for all to finish
-	}
-}
+static main_view_t::render_thread_stats_t render_stats[MAX_THREADS];
 
 /* The following mutex is only needed for smart cursor */
 // mutex for changing settings on hiding buildings/trees
@@ -88,7 +161,62 @@ static pthread_cond_t waiting_cond = PTHREAD_COND_INITIALIZER;
 
 #if COLOUR_DEPTH != 0
 static bool can_multithreading = true;
+
+// draws bands until all are taken
+static void display_bands( display_region_param_t *view )
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const sint16 IMG_SIZE = get_tile_raster_width();
+
+	while(  true  ) {
+		pthread_mutex_lock( &band_mutex );
+		const uint32 band = next_band++;
+		pthread_mutex_unlock( &band_mutex );
+		if(  band >= bands.get_count()  ) {
+			break;
+		}
+
+		const scr_rect &r = bands[band];
+		clear_all_poly_clip( view->thread_num );
+		display_set_clip_wh( r.x, r.y, r.w, r.h, view->thread_num );
+		// process tiles IMG_SIZE/2 outside clipping range for correct tree display at band seams
+		view->show_routine->display_region( koord( r.x - IMG_SIZE/2, r.y ), koord( r.w + IMG_SIZE, r.h ), view->y_min, view->y_max, false, true, view->thread_num );
+		render_stats[view->thread_num].bands++;
+	}
+
+	// show thread as paused when finished
+	pthread_mutex_lock( &hide_mutex );
+	num_threads_paused++;
+	pthread_cond_broadcast( &waiting_cond );
+	pthread_mutex_unlock( &hide_mutex );
+
+	render_stats[view->thread_num].busy_us += std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start ).count();
+}
+
+
+void *display_region_thread( void *ptr )
+{
+	display_region_param_t *view = reinterpret_cast<display_region_param_t *>(ptr);
+
+	while(true) {
+		simthread_barrier_wait( &display_barrier_start ); // wait for all to start
+		display_bands( view );
+		simthread_barrier_wait( &display_barrier_end ); // wait for all to finish
+	}
+}
 #endif
+
+
+const main_view_t::render_thread_stats_t &main_view_t::get_render_stats( int thread_num )
+{
+	return render_stats[thread_num];
+}
+
+
+void main_view_t::reset_render_stats()
+{
+	memset( render_stats, 0, sizeof(render_stats) );
+}
 #endif
 
 
@@ -164,18 +292,6 @@ void main_view_t::display(bool force_dirty)
 		display_day_night_shift(hours2night[hours2]+env_t::daynight_level);
 	}
 
-	// not very elegant, but works:
-	// fill everything with black for Underground mode ...
-	if( grund_t::underground_mode ) {
-		display_fillbox_wh_rgb(clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h, color_idx_to_rgb(COL_BLACK), force_dirty);
-	}
-	else if( welt->is_background_dirty()  &&  outside_visible  ) {
-		// we check if background will be visible, no need to clear screen if it's not.
-		display_background(clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h, force_dirty);
-		welt->unset_background_dirty();
-		// reset
-		outside_visible = false;
-	}
 	// to save calls to grund_t::get_disp_height
 	// gr->get_disp_height() == min(gr->get_hoehe(), hmax_ground)
 	const sint8 hmax_ground = (grund_t::underground_mode==grund_t::ugm_level) ? grund_t::underground_level : 127;
@@ -202,8 +318,95 @@ void main_view_t::display(bool force_dirty)
 		viewport->prepared_rect = view_rect;
 	}
 
+	// redraw the whole view or only the strips with changes?
+	static_layer_key_t key;
+	memset( &key, 0, sizeof(key) );
+	key.i_off = i_off;
+	key.j_off = j_off;
+	key.x_off = const_x_off;
+	key.y_off = const_y_off;
+	key.img_size = IMG_SIZE;
+	key.clip_x = clip_rr.x;
+	key.clip_y = clip_rr.y;
+	key.clip_w = clip_rr.w;
+	key.clip_h = clip_rr.h;
+	key.underground_mode = grund_t::underground_mode;
+	key.underground_level = grund_t::underground_level;
+	key.show_grid = grund_t::show_grid;
+	key.hide_trees = env_t::hide_trees;
+	key.hide_with_transparency = env_t::hide_with_transparency;
+	key.hide_under_cursor = env_t::hide_under_cursor;
+	key.simple_drawing = env_t::simple_drawing;
+	key.draw_earth_border = env_t::draw_earth_border;
+	key.draw_outside_tile = env_t::draw_outside_tile;
+	key.hide_buildings = env_t::hide_buildings;
+
+	// the smart cursor hides objects around it while drawing and water animation changes most of the view
+	bool redraw_all = memcmp( &key, &static_layer_key, sizeof(key) ) != 0  ||  !display_static_layer_valid()  ||  welt->is_background_dirty()  ||  env_t::hide_under_cursor  ||  wasser_t::change_stage;
+	static_layer_key = key;
+
+	const int strip_count = (clip_rr.w + STATIC_LAYER_STRIP_WIDTH - 1) / STATIC_LAYER_STRIP_WIDTH;
+	if(  !redraw_all  ) {
+		mark_changed_tiles( view_rect, clip_rr, IMG_SIZE );
+
+		sint32 dirty_width = 0;
+		for(  int s = 0;  s < strip_count;  s++  ) {
+			const scr_coord_val x = clip_rr.x + s * STATIC_LAYER_STRIP_WIDTH;
+			dirty_strips[s] = dirty_strips[s]  ||  display_is_rect_dirty( x, clip_rr.y, x + STATIC_LAYER_STRIP_WIDTH - 1, clip_rr.y + clip_rr.h - 1 );
+			dirty_width += dirty_strips[s] ? STATIC_LAYER_STRIP_WIDTH : 0;
+		}
+		// the seams of the strips cost extra, so most of the view is faster drawn at once
+		redraw_all = dirty_width * 4 > clip_rr.w * 3;
+	}
+
+#ifdef MULTI_THREAD
+	const bool parallel = can_multithreading  &&  env_t::num_threads > 1;
+#else
+	const bool parallel = false;
+#endif
+	const scr_coord_val band_width = parallel ? max( (scr_coord_val)(IMG_SIZE * 2), (scr_coord_val)(clip_rr.w / (env_t::num_threads * RENDER_BANDS_PER_THREAD)) ) : clip_rr.w;
+
+	bands.clear();
+	if(  redraw_all  ) {
+		// not very elegant, but works:
+		// fill everything with black for Underground mode ...
+		if( grund_t::underground_mode ) {
+			display_fillbox_wh_rgb(clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h, color_idx_to_rgb(COL_BLACK), force_dirty);
+		}
+		else if( welt->is_background_dirty()  &&  outside_visible  ) {
+			// we check if background will be visible, no need to clear screen if it's not.
+			display_background(clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h, force_dirty);
+			welt->unset_background_dirty();
+			// reset
+			outside_visible = false;
+		}
+		append_bands( clip_rr.x, clip_rr.w, clip_rr, band_width );
+	}
+	else {
+		display_restore_static_layer( clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h );
+
+		for(  int s = 0;  s < strip_count;  ) {
+			if(  !dirty_strips[s]  ) {
+				s++;
+				continue;
+			}
+			// join neighbouring dirty strips
+			int e = s + 1;
+			while(  e < strip_count  &&  dirty_strips[e]  ) {
+				e++;
+			}
+			const scr_coord_val x = clip_rr.x + s * STATIC_LAYER_STRIP_WIDTH;
+			const scr_coord_val w = min( (e - s) * STATIC_LAYER_STRIP_WIDTH, clip_rr.x + clip_rr.w - x );
+			if(  grund_t::underground_mode  ) {
+				display_fillbox_wh_rgb( x, clip_rr.y, w, clip_rr.h, color_idx_to_rgb(COL_BLACK), false );
+			}
+			append_bands( x, w, clip_rr, band_width );
+			s = e;
+		}
+	}
+
 #ifdef MULTI_THREAD
-	if(  can_multithreading  ) {
+	if(  parallel  ) {
 		if(  !spawned_threads  ) {
 			// we can do the parallel display using posix threads ...
 			pthread_t thread[MAX_THREADS];
@@ -226,20 +429,14 @@ void main_view_t::display(bool force_dirty)
 			pthread_attr_destroy( &attr );
 		}
 
-		// set parameter for each thread
-		const scr_coord_val wh_x = clip_rr.w / env_t::num_threads;
-		scr_coord_val lt_x = clip_rr.x;
-		for(  int t = 0;  t < env_t::num_threads - 1;  t++  ) {
+		// set parameter for each thread, the last one is ourselves
+		for(  int t = 0;  t < env_t::num_threads;  t++  ) {
 			ka[t].show_routine = this;
-			ka[t].lt_cl = koord( lt_x, clip_rr.y );
-			ka[t].wh_cl = koord( wh_x, clip_rr.h );
-			ka[t].lt = ka[t].lt_cl - koord( IMG_SIZE/2, 0 ); // process tiles IMG_SIZE/2 outside clipping range for correct tree display at thread seams
-			ka[t].wh = ka[t].wh_cl + koord( IMG_SIZE, 0 );
 			ka[t].y_min = y_min;
 			ka[t].y_max = dpy_height + 4 * 4;
 			ka[t].thread_num = t;
-			lt_x += wh_x;
 		}
+		next_band = 0;
 
 		// init variables required to draw smart cursor
 		threads_req_pause = false;
@@ -247,26 +444,48 @@ void main_view_t::display(bool force_dirty)
 
 		// and start drawing
 		simthread_barrier_wait( &display_barrier_start );
-
-		// the last we can run ourselves, setting clip_wh to the screen edge instead of wh_x (in case disp_width % num_threads != 0)
-		clear_all_poly_clip( env_t::num_threads - 1 );
-		display_set_clip_wh( lt_x, clip_rr.y, clip_rr.w, clip_rr.h, env_t::num_threads - 1 );
-		display_region( koord( lt_x - IMG_SIZE / 2, clip_rr.y ), koord( clip_rr.x + clip_rr.w + IMG_SIZE, clip_rr.h ), y_min, dpy_height + 4 * 4, false, true, env_t::num_threads - 1 );
-
+		display_bands( &ka[env_t::num_threads - 1] );
 		simthread_barrier_wait( &display_barrier_end );
 
 		clear_all_poly_clip( 0 );
-		display_set_clip_wh(clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h);
 	}
 	else {
 		// slow serial way of display
-		clear_all_poly_clip( 0 );
-		display_region( koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false, false, 0 );
+		for(  uint32 b = 0;  b < bands.get_count();  b++  ) {
+			const scr_rect &r = bands[b];
+			clear_all_poly_clip( 0 );
+			display_set_clip_wh( r.x, r.y, r.w, r.h );
+			display_region( koord( r.x - IMG_SIZE / 2, r.y ), koord( r.w + IMG_SIZE, r.h ), y_min, dpy_height + 4 * 4, false, false, 0 );
+		}
 	}
 #else
-	clear_all_poly_clip();
-	display_region(koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false );
+	for(  uint32 b = 0;  b < bands.get_count();  b++  ) {
+		const scr_rect &r = bands[b];
+		clear_all_poly_clip();
+		display_set_clip_wh( r.x, r.y, r.w, r.h );
+		display_region( koord( r.x - IMG_SIZE / 2, r.y ), koord( r.w + IMG_SIZE, r.h ), y_min, dpy_height + 4 * 4, false );
+	}
 #endif
+	display_set_clip_wh( clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h );
+
+	if(  redraw_all  ) {
+		if(  !env_t::hide_under_cursor  ) {
+			display_store_static_layer( clip_rr.x, clip_rr.y, clip_rr.w, clip_rr.h, true );
+		}
+	}
+	else {
+		for(  uint32 b = 0;  b < bands.get_count();  b++  ) {
+			const scr_rect &r = bands[b];
+			display_store_static_layer( r.x, r.y, r.w, r.h, false );
+		}
+	}
+
+	// some objects only mark their area while being drawn, so they need the strip again next frame
+	dirty_strips.clear();
+	for(  int s = 0;  s < strip_count;  s++  ) {
+		const scr_coord_val x = clip_rr.x + s * STATIC_LAYER_STRIP_WIDTH;
+		dirty_strips.append( display_is_rect_dirty( x, clip_rr.y, x + STATIC_LAYER_STRIP_WIDTH - 1, clip_rr.y + clip_rr.h - 1 ) );
+	}
 
 	// and finally overlays (station coverage and signs)
 	bool plotted = false; // display overlays even on very large mountains
@@ -579,15 +798,6 @@ void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max
 			}
 		}
 	}
-#ifdef MULTI_THREAD
-	// show thread as paused when finished
-	if(  threaded  ) {
-		pthread_mutex_lock( &hide_mutex );
-		num_threads_paused++;
-		pthread_cond_broadcast( &waiting_cond );
-		pthread_mutex_unlock( &hide_mutex );
-	}
-#endif
 }
 
 
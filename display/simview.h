@@ -11,6 +11,7 @@
 
 
 class karte_t;
+class rect_t;
 class viewport_t;
 
 
@@ -48,6 +49,18 @@ public:
 	 */
 	void clear_prepared() const;
 
+#ifdef MULTI_THREAD
+	/// Load balance of the parallel renderer, summed up per thread since the last reset_render_stats().
+	struct render_thread_stats_t
+	{
+		uint64 busy_us; ///< time spent drawing bands, until no band was left
+		uint32 bands;   ///< number of bands drawn
+	};
+
+	static const render_thread_stats_t &get_render_stats( int thread_num );
+	static void reset_render_stats();
+#endif
+
 	/**
 	 * Draws the simulated world in the specified rectangular area of the pixel buffer. This is a internal function of the class.
 	 * <br>
@@ -78,6 +91,13 @@ private:
 	 * @param dirty Mark the specified area as dirty.
 	 */
 	void display_background( scr_coord_val xp, scr_coord_val yp, scr_coord_val w, scr_coord_val h, bool dirty );
+
+	/**
+	 * Finds the grounds and objects in @p view_rect flagged dirty, before they are drawn,
+	 * and marks the strips of the static layer containing them for redrawing.
+	 * @param raster Tile raster width in pixels.
+	 */
+	void mark_changed_tiles( const rect_t &view_rect, const scr_rect &clip_rr, scr_coord_val raster );
 };
 
 #endif
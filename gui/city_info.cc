@@ -291,7 +291,7 @@ void city_info_t::init()
 	//   skip electricity
 	for(  uint32 i = 0;  i<MAX_CITY_HISTORY;  i++  ) {
 		sint16 curve = chart.add_curve( color_idx_to_rgb(hist_type_color[i]), city->get_city_history_year(),
-			MAX_CITY_HISTORY, i, 12, gui_chart_t::STANDARD, (city->stadtinfo_options & (1<<i))!=0, true, 0 );
+			i, 12, gui_chart_t::STANDARD, (city->stadtinfo_options & (1<<i))!=0, true, 0 );
 		// add button
 		buttons[i] = container_year.new_component<button_t>();
 		buttons[i]->init(button_t::box_state_automatic | button_t::flexible, hist_type[i]);
@@ -315,7 +315,7 @@ void city_info_t::init()
 	container_month.add_table(BUTTONS_PER_ROW,int((MAX_CITY_HISTORY+(BUTTONS_PER_ROW-1))/BUTTONS_PER_ROW))->set_force_equal_columns(true);
 	for(  uint32 i = 0;  i<MAX_CITY_HISTORY;  i++  ) {
 		sint16 curve = mchart.add_curve( color_idx_to_rgb(hist_type_color[i]), city->get_city_history_month(),
-			MAX_CITY_HISTORY, i, 12, gui_chart_t::STANDARD, (city->stadtinfo_options & (1<<i))!=0, true, 0 );
+			i, 12, gui_chart_t::STANDARD, (city->stadtinfo_options & (1<<i))!=0, true, 0 );
 
 		// add button
 		container_month.add_component(buttons[i]);
@@ -90,6 +90,8 @@ uint32 gui_chart_t::add_curve(PIXVAL color, const sint64 *values, int size, int
 	new_curve.precision = precision;
 	new_curve.convert = proc;
 	new_curve.marker_type = marker_type;
+	new_curve.current_row = NULL;
+	new_curve.rows = elements;
 	curves.append(new_curve);
 	return curves.get_count()-1;
 }
@@ -214,7 +216,7 @@ void gui_chart_t::draw(scr_coord offset)
 			// for each curve iterate through all elements and display curve
 			for (int i = start; i < end; i++) {
 
-				tmp = c.values[i*c.size+c.offset];
+				tmp = c.get_value(i);
 				// convert value where necessary
 				if(  c.convert  ) {
 					tmp = c.convert(tmp);
@@ -322,7 +324,7 @@ void gui_chart_t::calc_gui_chart_values(sint64 *baseline, double *scale, char *c
 	for(curve_t const& c : curves) {
 		if(  c.show  ) {
 			for(  int i=0;  i<c.elements;  i++  ) {
-				tmp = c.values[i*c.size+c.offset];
+				tmp = c.get_value(i);
 				// convert value where necessary
 				if(  c.convert  ) {
 					tmp = c.convert(tmp);
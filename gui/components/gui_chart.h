@@ -10,6 +10,7 @@
 #include "../../simtypes.h"
 #include "gui_component.h"
 #include "../../tpl/slist_tpl.h"
+#include "../../tpl/history_tpl.h"
 
 
 /**
@@ -62,6 +63,18 @@ public:
 	 */
 	uint32 add_curve(PIXVAL color, const sint64 *values, int size, int offset, int elements, int type, bool show, bool show_value, int precision, convert_proc proc=NULL, chart_marker_t marker=square);
 
+	/**
+	 * Adds a curve of the values @p offset of a history, starting with its current month
+	 */
+	template<int MONTHS, int TYPES>
+	uint32 add_curve(PIXVAL color, const history_tpl<sint64, MONTHS, TYPES> &history, int offset, int elements, int type, bool show, bool show_value, int precision, convert_proc proc=NULL, chart_marker_t marker=square)
+	{
+		const uint32 id = add_curve( color, history.get_rows(), TYPES, offset, elements, type, show, show_value, precision, proc, marker );
+		curves.back().current_row = history.get_current_row();
+		curves.back().rows = MONTHS;
+		return id;
+	}
+
 	void remove_curves() { curves.clear(); }
 
 	/**
@@ -123,6 +136,16 @@ private:
 		chart_marker_t marker_type;
 		int precision;        // how many numbers ...
 		convert_proc convert; // procedure for converting supplied values before use
+		const uint8 *current_row; // for a history_tpl: row of element 0 of the ring of rows, else NULL
+		int rows;
+
+		sint64 get_value(int i) const
+		{
+			if(  current_row  ) {
+				i = (i + *current_row) % rows;
+			}
+			return values[i*size+offset];
+		}
 	};
 
 	slist_tpl <curve_t> curves;
@@ -295,7 +295,7 @@ void convoi_info_t::init(convoihandle_t cnv)
 
 	for (int cost = 0; cost<convoi_t::MAX_CONVOI_COST; cost++) {
 		const uint8 precision = cost_type_money[cost] == gui_chart_t::MONEY ? 2 : (cost_type_money[cost]==gui_chart_t::PAX_KM || cost_type_money[cost]==gui_chart_t::KG_KM || cost_type_money[cost]==gui_chart_t::TON_KM) ? 1 : 0;
-		uint16 curve = chart.add_curve( color_idx_to_rgb(cost_type_color[cost]), cnv->get_finance_history(), convoi_t::MAX_CONVOI_COST,
+		uint16 curve = chart.add_curve( color_idx_to_rgb(cost_type_color[cost]), cnv->get_finance_history(),
 			statistic[cost], MAX_MONTHS, cost_type_money[cost], false, true, precision);
 
 		button_t *b = container_stats.new_component<button_t>();
@@ -796,7 +796,7 @@ void halt_info_t::init(halthandle_t halt)
 		const uint8 precision = index_of_haltinfo[cost]== HALT_GOODS_HANDLING_VOLUME ? 2 : 0;
 		const gui_chart_t::chart_marker_t marker_type = chart_freight_type[cost]==halt_info_t::ft_pax ? gui_chart_t::round_box
 			: chart_freight_type[cost]==halt_info_t::ft_mail ? gui_chart_t::square : chart_freight_type[cost] == halt_info_t::ft_goods ? gui_chart_t::diamond : gui_chart_t::cross;
-		uint16 curve = chart.add_curve(color_idx_to_rgb(cost_type_color[cost]), halt->get_finance_history(), MAX_HALT_COST,
+		uint16 curve = chart.add_curve(color_idx_to_rgb(cost_type_color[cost]), halt->get_finance_history(),
 			index_of_haltinfo[cost], MAX_MONTHS, index_of_haltinfo[cost]==HALT_GOODS_HANDLING_VOLUME ? gui_chart_t::TONNEN : 0, false, true, precision, 0, marker_type);
 
 		button_t *b = container_chart.new_component<button_t>();
@@ -1276,7 +1276,7 @@ void halt_info_t::update_cont_departure()
 
 	const sint64 cur_ticks = world()->get_ticks();
 
-	typedef inthashtable_tpl<uint16, sint64, N_BAGS_SMALL> const arrival_times_map; // Not clear why this has to be redefined here.
+	typedef inthashtable_tpl<quickstone_id_t, sint64, N_BAGS_SMALL> const arrival_times_map; // Not clear why this has to be redefined here.
 
 	convoihandle_t cnv;
 	sint32 delta_t;
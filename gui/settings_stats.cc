@@ -146,7 +146,17 @@ static const char *revision_ex[] =
 	"60",
 	"61",
 	"62",
-	"63"
+	"63",
+	"64",
+	"65",
+	"66",
+	"67",
+	"68",
+	"69",
+	"70",
+	"71",
+	"72",
+	"73"
 };
 
 
@@ -254,6 +264,10 @@ void settings_extended_general_stats_t::init( settings_t *sets )
 
 	INIT_NUM("path_explorer_time_midpoint", sets->get_path_explorer_time_midpoint(), 1, 2048, gui_numberinput_t::PLAIN, false);
 	INIT_BOOL("save_path_explorer_data", sets->get_save_path_explorer_data());
+	INIT_BOOL("path_explorer_blocked_search", sets->get_path_explorer_blocked_search());
+	INIT_BOOL("path_explorer_parallel_compartments", sets->get_path_explorer_parallel_compartments());
+	INIT_NUM("path_explorer_incremental_threshold", sets->get_path_explorer_incremental_threshold(), 0, 65535, gui_numberinput_t::PLAIN, false);
+	INIT_NUM("path_explorer_hub_label_threshold", sets->get_path_explorer_hub_label_threshold(), 0, 65535, gui_numberinput_t::PLAIN, false);
 
 	SEPERATOR;
 
@@ -379,6 +393,10 @@ void settings_extended_general_stats_t::read(settings_t *sets)
 
 	READ_NUM_VALUE(sets->path_explorer_time_midpoint);
 	READ_BOOL_VALUE(sets->save_path_explorer_data);
+	READ_BOOL_VALUE(sets->path_explorer_blocked_search);
+	READ_BOOL_VALUE(sets->path_explorer_parallel_compartments);
+	READ_NUM_VALUE(sets->path_explorer_incremental_threshold);
+	READ_NUM_VALUE(sets->path_explorer_hub_label_threshold);
 
 	READ_BOOL_VALUE(env_t::pause_server_no_clients);
 	READ_BOOL_VALUE(env_t::server_runs_background_tasks_when_paused);
@@ -602,6 +620,7 @@ void settings_general_stats_t::init(settings_t const* const sets)
 	INIT_NUM( "use_timeline", sets->get_use_timeline(), 0, 3, gui_numberinput_t::AUTOLINEAR, false );
 	INIT_NUM_NEW( "starting_year", sets->get_starting_year(), 0, 2999, gui_numberinput_t::AUTOLINEAR, false );
 	INIT_NUM_NEW( "starting_month", sets->get_starting_month(), 0, 11, gui_numberinput_t::AUTOLINEAR, false );
+	INIT_NUM( "month_rollover_steps", sets->get_month_rollover_steps(), 0, 1000, gui_numberinput_t::AUTOLINEAR, false );
 	SEPERATOR
 	INIT_NUM( "random_grounds_probability", env_t::ground_object_probability, 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "random_wildlife_probability", env_t::moving_object_probability, 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
@@ -690,6 +709,7 @@ void settings_general_stats_t::read(settings_t* const sets)
 	READ_NUM_VALUE( sets->use_timeline );
 	READ_NUM_VALUE_NEW( sets->starting_year );
 	READ_NUM_VALUE_NEW( sets->starting_month );
+	READ_NUM_VALUE( sets->month_rollover_steps );
 
 	READ_NUM_VALUE( env_t::ground_object_probability );
 	READ_NUM_VALUE( env_t::moving_object_probability );
@@ -781,6 +801,8 @@ void settings_routing_stats_t::init(settings_t const* const sets)
 	SEPERATOR
 	INIT_NUM( "max_route_steps", sets->get_max_route_steps(), 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "max_choose_route_steps", sets->get_max_choose_route_steps(), 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
+	INIT_NUM( "bidirectional_route_min_distance", sets->get_bidirectional_route_min_distance(), 0, 65535, gui_numberinput_t::AUTOLINEAR, false );
+	INIT_NUM( "route_cache_size", sets->get_route_cache_size(), 0, 0x7FFFFFFFul, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "max_hops", sets->get_max_hops(), 100, 65000, gui_numberinput_t::POWER2, false );
 	INIT_NUM( "max_transfers", sets->get_max_transfers(), 1, 100, gui_numberinput_t::AUTOLINEAR, false );
 	SEPERATOR
@@ -805,6 +827,8 @@ void settings_routing_stats_t::read(settings_t* const sets)
 	READ_BOOL_VALUE( sets->avoid_overcrowding );
 	READ_NUM_VALUE( sets->max_route_steps );
 	READ_NUM_VALUE( sets->max_choose_route_steps );
+	READ_NUM_VALUE( sets->bidirectional_route_min_distance );
+	READ_NUM_VALUE( sets->route_cache_size );
 	READ_NUM_VALUE( sets->max_hops );
 	READ_NUM_VALUE( sets->max_transfers );
 
@@ -877,6 +901,7 @@ void settings_economy_stats_t::init(settings_t const* const sets)
 	INIT_BOOL( "stop_pedestrians", sets->get_show_pax() );
 	INIT_NUM( "citycar_level", sets->get_traffic_level(), 0, 16, 1, false );
 	INIT_NUM( "default_citycar_life", sets->get_stadtauto_duration(), 1, 1200, 12, false );
+	INIT_NUM( "sync_step_region_size", sets->get_sync_step_region_size(), 0, 1024, gui_numberinput_t::AUTOLINEAR, false );
 
 	INIT_END
 }
@@ -931,6 +956,7 @@ void settings_economy_stats_t::read(settings_t* const sets)
 	READ_BOOL( sets->set_show_pax );
 	READ_NUM( sets->set_traffic_level );
 	READ_NUM_VALUE( sets->stadtauto_duration );
+	READ_NUM_VALUE( sets->sync_step_region_size );
 }
 
 
@@ -591,10 +591,44 @@ bool win_is_top(const gui_frame_t *ig)
 // window functions
 
 
+/**
+ * Maps a magic number saved by a build with another QUICKSTONE_ID_RANGE
+ * (e.g. before 14.73 or without QUICKSTONE_32BIT) to the magic numbers of this build.
+ */
+static uint32 magic_from_handle_range(uint32 id, uint32 handle_range)
+{
+	if(  handle_range == QUICKSTONE_ID_RANGE  ||  id < magic_convoi_info  ) {
+		return id;
+	}
+	// sizes of the ranges from magic_convoi_info on, with a handle range of 0 for the current build
+	const uint32 range_size[] = { 0, 0, 0x10000, 0x10000, 0, 0x100, 0x10000, 0 };
+	uint32 offset = id - magic_convoi_info;
+	uint32 new_id = magic_convoi_info;
+	for(  uint i = 0;  i < lengthof(range_size);  i++  ) {
+		const uint32 old_size = range_size[i] ? range_size[i] : handle_range;
+		if(  offset < old_size  ) {
+			break;
+		}
+		offset -= old_size;
+		new_id += range_size[i] ? range_size[i] : QUICKSTONE_ID_RANGE;
+	}
+	return new_id + offset;
+}
+
+
 // save/restore all dialogues
 void rdwr_all_win(loadsave_t *file)
 {
 	if( file->is_version_ex_atleast(14, 32) ) {
+		// windows of convoys are numbered by handle, so the magic numbers depend on the handle range
+		uint32 handle_range = QUICKSTONE_ID_RANGE;
+		if(  file->is_version_ex_atleast(14, 73)  ) {
+			file->rdwr_long( handle_range );
+		}
+		else {
+			handle_range = 0x10000;
+		}
+
 		if(  file->is_saving()  ) {
 			for(simwin_t & i : wins) {
 				uint32 id = i.gui->get_rdwr_id();
@@ -616,6 +650,7 @@ void rdwr_all_win(loadsave_t *file)
 			while(1) {
 				uint32 id;
 				file->rdwr_long(id);
+				id = magic_from_handle_range( id, handle_range );
 				// create the matching
 				gui_frame_t *w = NULL;
 				switch(magic_numbers(id)) {
@@ -670,13 +705,13 @@ void rdwr_all_win(loadsave_t *file)
 						else if (id >= magic_depotlist && id < magic_depotlist + MAX_PLAYER_COUNT) {
 							w = new depotlist_frame_t(wl->get_player(id - magic_depotlist));
 						}
-						else if(  id>=magic_replace && id < magic_replace +0x10000  ) {
+						else if(  id>=magic_replace && id < magic_replace +QUICKSTONE_ID_RANGE  ) {
 							w = new replace_frame_t();
 						}
-						else if(  id>=magic_replace_line && id < magic_replace_line +0x10000  ) {
+						else if(  id>=magic_replace_line && id < magic_replace_line +QUICKSTONE_ID_RANGE  ) {
 							w = new replace_frame_t(linehandle_t());
 						}
-						else if( id>=magic_convoi_info && id<magic_convoi_info+0x10000  ) {
+						else if( id>=magic_convoi_info && id<magic_convoi_info+QUICKSTONE_ID_RANGE  ) {
 							w = new convoi_info_t();
 						}
 						else if( id>=magic_halt_info  &&  id<magic_halt_info+0x10000  ) {
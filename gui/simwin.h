@@ -117,15 +117,16 @@ enum magic_numbers {
 	magic_player_ranking,
 
 	// magic numbers with big jumps between them
+	// (ranges for convoy ids depend on QUICKSTONE_ID_RANGE, see magic_from_handle_range())
 	magic_convoi_info,
-	magic_convoi_detail       = magic_convoi_info         + 0x10000,
-	magic_halt_info           = magic_convoi_detail       + 0x10000,
+	magic_convoi_detail       = magic_convoi_info         + QUICKSTONE_ID_RANGE,
+	magic_halt_info           = magic_convoi_detail       + QUICKSTONE_ID_RANGE,
 	magic_halt_detail         = magic_halt_info           + 0x10000,
 	magic_replace             = magic_halt_detail         + 0x10000,
-	magic_toolbar             = magic_replace             + 0x10000,
+	magic_toolbar             = magic_replace             + QUICKSTONE_ID_RANGE,
 	magic_info_pointer        = magic_toolbar             + 0x100,
 	magic_class_manager       = magic_info_pointer        + 0x10000,
-	magic_line_class_manager  = magic_class_manager       + 0x10000,
+	magic_line_class_manager  = magic_class_manager       + QUICKSTONE_ID_RANGE,
 	magic_depotlist           = magic_line_class_manager  + 843,
 	magic_vehiclelist         = magic_depotlist           + MAX_PLAYER_COUNT,
 	magic_vehicle_detail,
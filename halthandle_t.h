@@ -13,4 +13,10 @@ class haltestelle_t;
 
 typedef quickstone_tpl<haltestelle_t> halthandle_t;
 
+/**
+ * Halt ids stay below this in either build: the path explorer keeps tables
+ * indexed by halt id and matrices indexed by uint16 for each goods category.
+ */
+#define HALT_ID_RANGE (0x10000u)
+
 #endif
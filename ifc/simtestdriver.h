@@ -41,6 +41,10 @@ public:
 
 	// return the cost of a single step upwards
 	virtual uint32 get_cost_upslope() const { return 0; } // Standard is 25
+
+	// if the route search depends only on the ways and on the signature set here, routes found before
+	// with the same signature may be used again; returns false if this is not possible
+	virtual bool get_route_cache_signature(uint64 &) const { return false; }
 };
 
 #endif
@@ -8,6 +8,7 @@
 
 
 #include "../simtypes.h"
+#include "../dataobj/koord.h"
 
 enum sync_result {
 	SYNC_OK,     ///< object remains in list
@@ -21,12 +22,48 @@ enum sync_result {
 class sync_steppable
 {
 public:
+	/**
+	 * The objects of a sync list are stepped in groups of the same kind,
+	 * in this order, so the same code runs one after the other.
+	 */
+	enum sync_group_t {
+		SYNC_GROUP_CONVOI,
+		SYNC_GROUP_PRIVATE_CAR,
+		SYNC_GROUP_PEDESTRIAN,
+		SYNC_GROUP_OTHER,
+		MAX_SYNC_GROUPS
+	};
+
+	/// not in any sync list
+	static const uint32 NO_SYNC_LIST_INDEX = 0xFFFFFFFFu;
+
+	sync_steppable() : sync_list_index(NO_SYNC_LIST_INDEX), sync_list_group(SYNC_GROUP_OTHER) {}
+
 	/**
 	 * Method for real-time features of an object.
 	 */
 	virtual sync_result sync_step(uint32 delta_t) = 0;
 
+	/**
+	 * The group this object is stepped with; only asked when it is added to a sync list.
+	 */
+	virtual sync_group_t get_sync_group() const { return SYNC_GROUP_OTHER; }
+
+	/**
+	 * Where this object is, if its next sync_step(delta_t) only reaches the tiles
+	 * close around it, so that it can be stepped in parallel with objects further
+	 * away (see karte_t::sync_list_t::sync_step()); koord::invalid otherwise.
+	 */
+	virtual koord get_local_sync_pos(uint32 /*delta_t*/) const { return koord::invalid; }
+
 	virtual ~sync_steppable() {}
+
+	/**
+	 * Position in the sync list, so karte_t::sync_list_t can remove it without searching.
+	 * Only to be changed by the sync list.
+	 */
+	uint32 sync_list_index;
+	uint8 sync_list_group;
 };
 
 #endif
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "memory_rdwr_stream.h"
+
+#include "../../simdebug.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+memory_rdwr_stream_t::memory_rdwr_stream_t() :
+	rdwr_stream_t(true),
+	data(NULL),
+	size(0),
+	capacity(0)
+{
+	status = STATUS_OK;
+}
+
+
+memory_rdwr_stream_t::~memory_rdwr_stream_t()
+{
+	free(data);
+}
+
+
+size_t memory_rdwr_stream_t::read(void *, size_t)
+{
+	dbg->fatal("memory_rdwr_stream_t::read", "Memory stream is write-only!");
+	return 0;
+}
+
+
+size_t memory_rdwr_stream_t::write(const void *buf, size_t len)
+{
+	if(  size+len > capacity  ) {
+		size_t new_capacity = capacity ? capacity*2 : 65536;
+		while(  size+len > new_capacity  ) {
+			new_capacity *= 2;
+		}
+
+		char *new_data = (char *)realloc(data, new_capacity);
+		if(  !new_data  ) {
+			status = STATUS_ERR_FULL;
+			return 0;
+		}
+		data = new_data;
+		capacity = new_capacity;
+	}
+
+	memcpy(data+size, buf, len);
+	size += len;
+	return len;
+}
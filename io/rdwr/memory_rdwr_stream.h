@@ -0,0 +1,40 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef IO_RDWR_MEMORY_RDWR_STREAM_H
+#define IO_RDWR_MEMORY_RDWR_STREAM_H
+
+
+#include "rdwr_stream.h"
+
+
+/// Collects written data in a growing memory buffer,
+/// e.g. to serialise parts of a savegame in parallel and append them to the file in order.
+class memory_rdwr_stream_t : public rdwr_stream_t
+{
+public:
+	memory_rdwr_stream_t();
+	~memory_rdwr_stream_t();
+
+public:
+	/// @copydoc rdwr_stream_t::write
+	size_t write(const void *buf, size_t len) OVERRIDE;
+
+	/// @returns all the data written so far
+	const void *get_data() const { return data; }
+	size_t get_size() const { return size; }
+
+private:
+	/// DO NOT USE!
+	size_t read(void *buf, size_t len) OVERRIDE;
+
+private:
+	char *data;
+	size_t size;
+	size_t capacity;
+};
+
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "../boden/grund.h"
 #include "../dataobj/loadsave.h"
+#include "../dataobj/route.h"
 #include "../dataobj/translator.h"
 #include "../display/simgraph.h"
 #include "../display/simimg.h"
@@ -130,6 +131,10 @@ void obj_t::set_owner(player_t *player)
 	int i = welt->sp2num(player);
 	assert(i>=0);
 	owner_n = (uint8)i;
+	if(  get_typ() == way  ) {
+		// access to ways depends on their owner
+		route_t::invalidate_route_cache(get_waytype());
+	}
 }
 
 
@@ -334,7 +339,14 @@ void obj_t::mark_image_dirty(image_id image, sint16 yoff) const
 		// xpos, ypos, yoff are already in pixel units, no scaling needed
 
 		// mark the region after the image as dirty
-		display_mark_img_dirty( image, scr_pos.x + xpos, scr_pos.y + ypos + yoff);
+		if(  karte_t::sync_region_t *region = karte_t::get_sync_region()  ) {
+			// the display is not to be touched by several threads
+			const karte_t::sync_region_t::dirty_image_t dirty = { image, scr_pos.x + xpos, scr_pos.y + ypos + yoff };
+			region->dirty_images.append(dirty);
+		}
+		else {
+			display_mark_img_dirty( image, scr_pos.x + xpos, scr_pos.y + ypos + yoff);
+		}
 
 		// too close to border => set dirty to be sure (smoke, skyscrapers, birds, or the like)
 		scr_coord_val xbild = 0, ybild = 0, wbild = 0, hbild = 0;
@@ -3,6 +3,9 @@
  * (see LICENSE.txt)
  */
 
+#include <string.h>
+#include <algorithm>
+
 #include "path_explorer.h"
 
 #include "tpl/slist_tpl.h"
@@ -34,6 +37,7 @@ path_explorer_t::compartment_t **path_explorer_t::goods_compartment = NULL;
 uint8 path_explorer_t::current_compartment_category = 0;
 uint8 path_explorer_t::current_compartment_class = 0;
 bool path_explorer_t::processing = false;
+vector_tpl<path_explorer_t::compartment_t *> path_explorer_t::parallel_compartments;
 uint32 path_explorer_t::compartment_t::time_midpoint;
 uint32 path_explorer_t::compartment_t::time_lower_limit;
 uint32 path_explorer_t::compartment_t::time_upper_limit;
@@ -172,7 +176,7 @@ void path_explorer_t::rdwr(loadsave_t* file)
 	}
 
 	// Load/save the connexion_list, which is static
-	uint32 connexion_list_size = 65536;
+	uint32 connexion_list_size = HALT_ID_RANGE;
 	if (file->get_extended_version() < 14 || (file->get_extended_version() == 14 && file->get_extended_revision() < 11))
 	{
 		// Wrong number was used in original code
@@ -190,8 +194,8 @@ void path_explorer_t::rdwr(loadsave_t* file)
 			uint32 tmp_journey_time;
 			uint32 tmp_waiting_time;
 			uint32 tmp_transfer_time;
-			uint16 tmp_best_line_idx;
-			uint16 tmp_best_convoy_idx;
+			quickstone_id_t tmp_best_line_idx;
+			quickstone_id_t tmp_best_convoy_idx;
 			uint16 tmp_alternative_seats;
 			// TODO: Consider whether to add comfort
 
@@ -213,8 +217,8 @@ void path_explorer_t::rdwr(loadsave_t* file)
 				file->rdwr_long(tmp_journey_time);
 				file->rdwr_long(tmp_waiting_time);
 				file->rdwr_long(tmp_transfer_time);
-				file->rdwr_short(tmp_best_line_idx);
-				file->rdwr_short(tmp_best_convoy_idx);
+				file->rdwr_handle_id(tmp_best_line_idx);
+				file->rdwr_handle_id(tmp_best_convoy_idx);
 				file->rdwr_short(tmp_alternative_seats);
 			}
 		}
@@ -237,16 +241,16 @@ void path_explorer_t::rdwr(loadsave_t* file)
 				uint32 tmp_journey_time;
 				uint32 tmp_waiting_time;
 				uint32 tmp_transfer_time;
-				uint16 tmp_best_line_idx;
-				uint16 tmp_best_convoy_idx;
+				quickstone_id_t tmp_best_line_idx;
+				quickstone_id_t tmp_best_convoy_idx;
 				uint16 tmp_alternative_seats;
 				// TODO: Consider whether to add comfort
 
 				file->rdwr_long(tmp_journey_time);
 				file->rdwr_long(tmp_waiting_time);
 				file->rdwr_long(tmp_transfer_time);
-				file->rdwr_short(tmp_best_line_idx);
-				file->rdwr_short(tmp_best_convoy_idx);
+				file->rdwr_handle_id(tmp_best_line_idx);
+				file->rdwr_handle_id(tmp_best_convoy_idx);
 				file->rdwr_short(tmp_alternative_seats);
 
 				tmp_cnx->journey_time = tmp_journey_time;
@@ -270,6 +274,12 @@ void path_explorer_t::step()
 		return;
 	}
 #endif
+	if ( world->get_settings().get_path_explorer_parallel_compartments() )
+	{
+		step_parallel();
+		return;
+	}
+
 	// at most check all goods categories once
 	const uint8 max_runs = (max_categories - 2) + goods_manager_t::passengers->get_number_of_classes() + goods_manager_t::mail->get_number_of_classes();
 	for (uint8 i = 0; i < max_runs; ++i)
@@ -298,6 +308,78 @@ void path_explorer_t::step()
 	processing = false;	// this step performs nothing
 }
 
+void path_explorer_t::step_parallel()
+{
+	processing = false;
+
+	// The phases before filling the matrix and the rerouting of goods share the connexion list and
+	// modify the halts, so these still process one compartment at a time, as in the sequential mode.
+	const uint8 max_runs = (max_categories - 2) + goods_manager_t::passengers->get_number_of_classes() + goods_manager_t::mail->get_number_of_classes();
+	for (uint8 i = 0; i < max_runs; ++i)
+	{
+		compartment_t &compartment = goods_compartment[current_compartment_category][current_compartment_class];
+		if ( current_compartment_category != category_empty && !compartment.is_in_parallel_phase()
+			 && ( !compartment.is_refresh_completed() || compartment.is_refresh_requested() ) )
+		{
+			processing = true;	// this step performs something
+			compartment.step();
+
+			// move on once the compartment has either finished or been handed over to the concurrent phases
+			if ( compartment.is_refresh_completed() || compartment.is_in_parallel_phase() )
+			{
+				next_compartment();
+			}
+			break;
+		}
+
+		next_compartment();
+	}
+
+	// Filling the matrix and exploring paths only use the compartment's own data, so all compartments in
+	// these phases are stepped concurrently. Which compartments are stepped does not depend on the number
+	// of threads, so that the results are the same on all clients of a network game.
+	for (uint8 ca = 0; ca < max_categories; ++ca)
+	{
+		for (uint8 cl = 0; cl < goods_manager_t::get_classes_catg_index(ca); ++cl)
+		{
+			if ( ca != category_empty && goods_compartment[ca][cl].is_in_parallel_phase() )
+			{
+				parallel_compartments.append( &goods_compartment[ca][cl] );
+			}
+		}
+	}
+
+	if ( !parallel_compartments.empty() )
+	{
+		processing = true;
+		FOR(vector_tpl<compartment_t *>, compartment, parallel_compartments)
+		{
+			compartment->take_limits();
+		}
+#ifdef MULTI_THREAD_PATH_EXPLORER
+		world->step_path_explorer_compartments();
+#else
+		step_parallel_compartments(0, 1);
+#endif
+		// in the same order as they were taken, so that the resulting limits do not depend on the threads
+		FOR(vector_tpl<compartment_t *>, compartment, parallel_compartments)
+		{
+			compartment->adjust_limits();
+		}
+		parallel_compartments.clear();
+	}
+}
+
+
+void path_explorer_t::step_parallel_compartments(const uint32 thread_number, const uint32 thread_count)
+{
+	for ( uint32 i = thread_number; i < parallel_compartments.get_count(); i += thread_count )
+	{
+		parallel_compartments[i]->step_phase();
+	}
+}
+
+
 void path_explorer_t::next_compartment()
 {
 	if (current_compartment_class < goods_manager_t::get_classes_catg_index(current_compartment_category) - 1)
@@ -418,7 +500,7 @@ void path_explorer_t::refresh_all_categories(const bool reset_working_set)
 	}
 }
 
-void path_explorer_t::refresh_category(uint8 category)
+void path_explorer_t::refresh_category(uint8 category, const vector_tpl<halthandle_t> *const affected_halts)
 {
 #ifdef MULTI_THREAD
 	world->await_path_explorer();
@@ -427,13 +509,13 @@ void path_explorer_t::refresh_category(uint8 category)
 	uint8 number_of_classes = goods_manager_t::get_classes_catg_index(category);
 	for (uint8 i = 0; i < number_of_classes; i++)
 	{
-		goods_compartment[category][i].set_refresh();
+		goods_compartment[category][i].set_refresh(affected_halts);
 	}
 }
 
-void path_explorer_t::refresh_class_category(uint8 category, uint8 g_class)
+void path_explorer_t::refresh_class_category(uint8 category, uint8 g_class, const vector_tpl<halthandle_t> *const affected_halts)
 {
-	goods_compartment[category][g_class].set_refresh();
+	goods_compartment[category][g_class].set_refresh(affected_halts);
 }
 
 ///////////////////////////////////////////////
@@ -451,7 +533,7 @@ const char *const path_explorer_t::compartment_t::phase_name[] =
 	"reroute"
 };
 
-path_explorer_t::compartment_t::connexion_list_entry_t path_explorer_t::compartment_t::connexion_list[65536];
+path_explorer_t::compartment_t::connexion_list_entry_t path_explorer_t::compartment_t::connexion_list[HALT_ID_RANGE];
 
 bool path_explorer_t::compartment_t::use_limits = true;
 
@@ -477,12 +559,15 @@ path_explorer_t::compartment_t::compartment_t()
 	refresh_start_time = 0;
 
 	finished_matrix = NULL;
+	finished_labels = NULL;
 	finished_halt_index_map = NULL;
 	finished_halt_count = 0;
 
 	working_matrix = NULL;
+	working_labels = NULL;
 	transport_index_map = NULL;
-	transport_matrix = NULL;
+	transport_convoy_offset = 0;
+	transport_index_map_size = 0;
 	working_halt_index_map = NULL;
 	working_halt_list = NULL;
 	working_halt_count = 0;
@@ -507,6 +592,13 @@ path_explorer_t::compartment_t::compartment_t()
 
 	current_phase = phase_check_flag;
 
+	blocked_search = false;
+
+	refresh_incremental = false;
+	incremental_search = false;
+
+	hub_label_search = false;
+
 	phase_counter = 0;
 	iterations = 0;
 	total_iterations = 0;
@@ -529,11 +621,11 @@ path_explorer_t::compartment_t::~compartment_t()
 {
 	if (finished_matrix)
 	{
-		for (uint16 i = 0; i < finished_halt_count; ++i)
-		{
-			delete[] finished_matrix[i];
-		}
-		delete[] finished_matrix;
+		delete finished_matrix;
+	}
+	if (finished_labels)
+	{
+		delete finished_labels;
 	}
 	if (finished_halt_index_map)
 	{
@@ -543,23 +635,15 @@ path_explorer_t::compartment_t::~compartment_t()
 
 	if (working_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] working_matrix[i];
-		}
-		delete[] working_matrix;
+		delete working_matrix;
 	}
-	if (transport_index_map)
+	if (working_labels)
 	{
-		delete[] transport_index_map;
+		delete working_labels;
 	}
-	if (transport_matrix)
+	if (transport_index_map)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] transport_matrix[i];
-		}
-		delete[] transport_matrix;
+		delete[] transport_index_map;
 	}
 	if (working_halt_index_map)
 	{
@@ -611,13 +695,14 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 	{
 		if (finished_matrix)
 		{
-			for (uint16 i = 0; i < finished_halt_count; ++i)
-			{
-				delete[] finished_matrix[i];
-			}
-			delete[] finished_matrix;
+			delete finished_matrix;
 			finished_matrix = NULL;
 		}
+		if (finished_labels)
+		{
+			delete finished_labels;
+			finished_labels = NULL;
+		}
 		if (finished_halt_index_map)
 		{
 			delete[] finished_halt_index_map;
@@ -629,27 +714,19 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 
 	if (working_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] working_matrix[i];
-		}
-		delete[] working_matrix;
+		delete working_matrix;
 		working_matrix = NULL;
 	}
+	if (working_labels)
+	{
+		delete working_labels;
+		working_labels = NULL;
+	}
 	if (transport_index_map)
 	{
 		delete[] transport_index_map;
 		transport_index_map = NULL;
 	}
-	if (transport_matrix)
-	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] transport_matrix[i];
-		}
-		delete[] transport_matrix;
-		transport_matrix = NULL;
-	}
 	if (working_halt_index_map)
 	{
 		delete[] working_halt_index_map;
@@ -710,6 +787,17 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 
 	current_phase = phase_check_flag;
 
+	blocked_search = false;
+
+	refresh_incremental = false;
+	changed_halts.clear();
+	incremental_search = false;
+	incremental_halts.clear();
+	incremental_vias.clear();
+	incremental_rows.clear();
+
+	hub_label_search = false;
+
 	phase_counter = 0;
 	iterations = 0;
 	total_iterations = 0;
@@ -743,7 +831,54 @@ void path_explorer_t::compartment_t::set_absolute_limits()
 	time_threshold = time_midpoint / 2;
 }
 
+template<typename T>
+void path_explorer_t::compartment_t::adjust_limit(const T projected_iterations, T &local_limit, T &limit)
+{
+	if ( env_t::networkmode )
+	{
+		const uint32 percentage = static_cast<uint32>( static_cast<uint64>(projected_iterations) * 100 / local_limit );
+		if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
+		{
+			local_limit = projected_iterations;
+			local_limits_changed = true;
+		}
+	}
+	else
+	{
+		const uint32 percentage = static_cast<uint32>( static_cast<uint64>(projected_iterations) * 100 / limit );
+		if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
+		{
+			limit = projected_iterations;
+		}
+	}
+}
+
+void path_explorer_t::compartment_t::take_limits()
+{
+	step_limits = get_active_limits();
+}
+
+void path_explorer_t::compartment_t::adjust_limits()
+{
+	if ( projected_limits.fill_matrix > 0 )
+	{
+		adjust_limit(projected_limits.fill_matrix, local_fill_matrix, limit_fill_matrix);
+	}
+	if ( projected_limits.explore_paths > 0 )
+	{
+		adjust_limit(projected_limits.explore_paths, local_explore_paths, limit_explore_paths);
+	}
+	projected_limits = limit_set_t();
+}
+
 void path_explorer_t::compartment_t::step()
+{
+	take_limits();
+	step_phase();
+	adjust_limits();
+}
+
+void path_explorer_t::compartment_t::step_phase()
 {
 #ifdef MULTI_THREAD
 	if (!allow_path_explorer_on_this_thread)
@@ -772,6 +907,18 @@ void path_explorer_t::compartment_t::step()
 				refresh_completed = false;	// indicate that processing is at work
 				//refresh_start_time = dr_time();
 				refresh_start_time = world->get_ticks(); // Possibly more network safe than the original (commented out above)
+				blocked_search = world->get_settings().get_path_explorer_blocked_search();
+
+				// the finished paths can only be repaired if there are any
+				incremental_search = refresh_incremental && paths_available && finished_matrix;
+				incremental_halts.clear();
+				if ( incremental_search )
+				{
+					swap(incremental_halts, changed_halts);
+				}
+				refresh_incremental = false;
+				changed_halts.clear();
+
 				current_phase = phase_init_prepare;	// proceed to next phase
 				// no return statement here, as we want to fall through to the next phase
 			}
@@ -861,8 +1008,8 @@ void path_explorer_t::compartment_t::step()
 			}
 
 			// create and initlialize a halthandle-entry to matrix-index map (halt index map)
-			working_halt_index_map = new uint16[65536];
-			for (uint32 i = 0; i < 65536; ++i)
+			working_halt_index_map = new uint16[HALT_ID_RANGE];
+			for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 			{
 				// For quickstone handle, there can at most be 65535 valid entries, plus entry 0 which is reserved for null handle
 				// Thus, the range of quickstone entries [1, 65535] is mapped to the range of matrix index [0, 65534]
@@ -871,7 +1018,10 @@ void path_explorer_t::compartment_t::step()
 				working_halt_index_map[i] = 65535;
 			}
 
-			transport_index_map = new uint16[131072]();		// initialise all elements to zero
+			// lineless convoys are mapped behind all line ids
+			transport_convoy_offset = linehandle_t::get_size();
+			transport_index_map_size = transport_convoy_offset + convoihandle_t::get_size();
+			transport_index_map = new uint16[transport_index_map_size]();		// initialise all elements to zero
 
 			// create a list of schedules of lines and lineless convoys
 			linkages = new vector_tpl<linkage_t>(1024);
@@ -889,7 +1039,7 @@ void path_explorer_t::compartment_t::step()
 				{
 					temp_linkage.convoy = current_convoy;
 					linkages->append(temp_linkage);
-					transport_index_map[ 65536u + current_convoy.get_id() ] = linkages->get_count();
+					transport_index_map[ transport_convoy_offset + current_convoy.get_id() ] = linkages->get_count();
 				}
 			}
 
@@ -919,7 +1069,8 @@ void path_explorer_t::compartment_t::step()
 				}
 			}
 
-			// can have at most 65535 different lines and lineless convoys; passing this limit should be extremely unlikely
+			// can have at most 65535 different lines and lineless convoys per compartment, as transport indices in the matrix are uint16;
+			// even with QUICKSTONE_32BIT, passing this limit should be extremely unlikely
 			assert( linkages->get_count() <= 65535u );
 
 #ifdef DEBUG_COMPARTMENT_STEP
@@ -1389,18 +1540,18 @@ void path_explorer_t::compartment_t::step()
 			{
 				if (working_halt_count > 0)
 				{
-					// build working matrix
-					working_matrix = new path_element_t*[working_halt_count];
-					for (uint16 i = 0; i < working_halt_count; ++i)
+					// on networks with very many halts, build hub labels instead of the matrix, which would be too large
+					const uint32 hub_label_threshold = world->get_settings().get_path_explorer_hub_label_threshold();
+					hub_label_search = hub_label_threshold > 0 && working_halt_count >= hub_label_threshold;
+					if ( hub_label_search )
 					{
-						working_matrix[i] = new path_element_t[working_halt_count];
+						working_labels = new hub_labels_t(working_halt_count);
+						incremental_search = false;
 					}
-
-					// build transport matrix
-					transport_matrix = new transport_element_t*[working_halt_count];
-					for (uint16 i = 0; i < working_halt_count; ++i)
+					else
 					{
-						transport_matrix[i] = new transport_element_t[working_halt_count];
+						// build working matrix together with its transport data
+						working_matrix = new path_matrix_t(working_halt_count, true);
 					}
 
 					// build transfer list
@@ -1428,11 +1579,16 @@ void path_explorer_t::compartment_t::step()
 				}
 
 				// determine if this halt is a transfer halt
-				if ( current_halt->get_schedule_count(catg, g_class, max_classes) > 1 )
+				const bool is_transfer = current_halt->get_schedule_count(catg, g_class, max_classes) > 1;
+				if ( is_transfer )
 				{
 					transfer_list[transfer_count] = phase_counter;
 					++transfer_count;
 				}
+				if ( hub_label_search )
+				{
+					working_labels->set_halt(phase_counter, current_halt, is_transfer);
+				}
 
 				// iterate over the connexions of the current halt
 				for(auto const& connexions_iter : *(current_halt->get_connexions(catg, g_class)))
@@ -1462,7 +1618,7 @@ void path_explorer_t::compartment_t::step()
 					else if ( current_connexion->best_convoy.is_bound() )
 					{
 						// valid lineless convoy
-						transport_idx = transport_index_map[ 65536u + current_connexion->best_convoy.get_id() ];
+						transport_idx = transport_index_map[ transport_convoy_offset + current_connexion->best_convoy.get_id() ];
 					}
 					else
 					{
@@ -1478,26 +1634,36 @@ void path_explorer_t::compartment_t::step()
 						continue;
 					}
 
+					if ( hub_label_search )
+					{
+						working_labels->add_connexion(phase_counter, reachable_halt_index, current_connexion->waiting_time + current_connexion->journey_time + current_connexion->transfer_time);
+						continue;
+					}
+
 					// update corresponding matrix element
-					working_matrix[phase_counter][reachable_halt_index].next_transfer = reachable_halt;
-					working_matrix[phase_counter][reachable_halt_index].aggregate_time = current_connexion->waiting_time + current_connexion->journey_time + current_connexion->transfer_time;
-					transport_matrix[phase_counter][reachable_halt_index].first_transport
-						= transport_matrix[phase_counter][reachable_halt_index].last_transport
+					const size_t element = working_matrix->index(phase_counter, reachable_halt_index);
+					working_matrix->next_transfer[element] = reachable_halt;
+					working_matrix->aggregate_time[element] = current_connexion->waiting_time + current_connexion->journey_time + current_connexion->transfer_time;
+					working_matrix->first_transport[element]
+						= working_matrix->last_transport[element]
 						= transport_idx;
 
 					// Debug journey times
-					// printf("\n%s -> %s : %lu \n",current_halt->get_name(), reachable_halt->get_name(), working_matrix[phase_counter][reachable_halt_index].journey_time);
+					// printf("\n%s -> %s : %lu \n",current_halt->get_name(), reachable_halt->get_name(), working_matrix->aggregate_time[element]);
 				}
 
 				// Special case
-				working_matrix[phase_counter][phase_counter].aggregate_time = 0;
+				if ( working_matrix )
+				{
+					working_matrix->aggregate_time[ working_matrix->index(phase_counter, phase_counter) ] = 0;
+				}
 
 				++phase_counter;
 
 				// iteration control
 				++iterations;
 				++total_iterations;
-				if ( use_limits && iterations == limit_fill_matrix )
+				if ( use_limits && iterations == step_limits.fill_matrix )
 				{
 					break;
 				}
@@ -1518,30 +1684,10 @@ void path_explorer_t::compartment_t::step()
 
 			if (phase_counter == working_halt_count)
 			{
-				// iteration limit adjustment
+				// iteration limit adjustment, applied by adjust_limits()
 				if ( catg == representative_category )
 				{
-					const uint32 projected_iterations = statistic_iteration * time_midpoint / statistic_duration;
-					if ( projected_iterations > 0 )
-					{
-						if ( env_t::networkmode )
-						{
-							const uint32 percentage = projected_iterations * 100 / local_fill_matrix;
-							if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
-							{
-								local_fill_matrix = projected_iterations;
-								local_limits_changed = true;
-							}
-						}
-						else
-						{
-							const uint32 percentage = projected_iterations * 100 / limit_fill_matrix;
-							if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
-							{
-								limit_fill_matrix = projected_iterations;
-							}
-						}
-					}
+					projected_limits.fill_matrix = statistic_iteration * time_midpoint / statistic_duration;
 				}
 
 				// reset statistic variables
@@ -1590,15 +1736,55 @@ void path_explorer_t::compartment_t::step()
 			uint32 target_member_index;
 			uint64 iterations_processed = 0;
 
+			start = dr_time();	// start timing
+
+			// repair the finished paths only if this is much faster than exploring all paths again
+			if ( incremental_search && phase_counter == incremental_stage_seed )
+			{
+				if ( !seed_incremental_search(iterations_processed) )
+				{
+					goto loop_termination;
+				}
+
+				// the seeding used the counters, which start again for the stage which follows
+				via_index = 0;
+				origin_cluster_index = 0;
+				target_cluster_index = 0;
+				origin_member_index = 0;
+				if ( incremental_search )
+				{
+					phase_counter = incremental_stage_rows;
+				}
+			}
+
 			// initialize only when not resuming
-			if ( via_index == 0 && origin_cluster_index == 0 && target_cluster_index == 0 && origin_member_index == 0 )
+			if ( !blocked_search && !incremental_search && !hub_label_search && via_index == 0 && origin_cluster_index == 0 && target_cluster_index == 0 && origin_member_index == 0 )
 			{
 				// build data structures for inbound/outbound connections to/from transfer halts
 				inbound_connections = new connection_t(64u, working_halt_count);
 				outbound_connections = new connection_t(64u, working_halt_count);
 			}
 
-			start = dr_time();	// start timing
+			if ( hub_label_search )
+			{
+				explore_paths_hub_labels(iterations_processed);
+				goto loop_termination;
+			}
+
+			if ( incremental_search )
+			{
+				if ( explore_paths_incremental(iterations_processed) )
+				{
+					via_index = transfer_count;
+				}
+				goto loop_termination;
+			}
+
+			if ( blocked_search )
+			{
+				explore_paths_blocked(iterations_processed, transfer_list, transfer_count, NULL, working_halt_count);
+				goto loop_termination;
+			}
 
 			// for each transfer
 			while ( via_index < transfer_count )
@@ -1613,10 +1799,10 @@ void path_explorer_t::compartment_t::step()
 					// identify halts which are connected with the current transfer halt
 					for ( uint16 idx = 0; idx < working_halt_count; ++idx )
 					{
-						if ( working_matrix[via][idx].aggregate_time != UINT32_MAX_VALUE && via != idx )
+						if ( working_matrix->aggregate_time[ working_matrix->index(via, idx) ] != UINT32_MAX_VALUE && via != idx )
 						{
-							inbound_connections->register_connection( transport_matrix[idx][via].last_transport, idx );
-							outbound_connections->register_connection( transport_matrix[via][idx].first_transport, idx );
+							inbound_connections->register_connection( working_matrix->last_transport[ working_matrix->index(idx, via) ], idx );
+							outbound_connections->register_connection( working_matrix->first_transport[ working_matrix->index(via, idx) ], idx );
 						}
 					}
 
@@ -1648,20 +1834,23 @@ void path_explorer_t::compartment_t::step()
 						while ( origin_member_index < origin_halt_list.get_count() )
 						{
 							const uint16 origin = origin_halt_list[origin_member_index];
+							const size_t origin_via = working_matrix->index(origin, via);
 
 							// for each target cluster member
 							for ( target_member_index = 0; target_member_index < target_halt_list.get_count(); ++target_member_index )
 							{
 								const uint16 target = target_halt_list[target_member_index];
+								const size_t via_target = working_matrix->index(via, target);
+								const size_t origin_target = working_matrix->index(origin, target);
 
-								if ( ( combined_time = working_matrix[origin][via].aggregate_time
-													 + working_matrix[via][target].aggregate_time )
-											< working_matrix[origin][target].aggregate_time			   )
+								if ( ( combined_time = working_matrix->aggregate_time[origin_via]
+													 + working_matrix->aggregate_time[via_target] )
+											< working_matrix->aggregate_time[origin_target]			   )
 								{
-									working_matrix[origin][target].aggregate_time = combined_time;
-									working_matrix[origin][target].next_transfer = working_matrix[origin][via].next_transfer;
-									transport_matrix[origin][target].first_transport = transport_matrix[origin][via].first_transport;
-									transport_matrix[origin][target].last_transport = transport_matrix[via][target].last_transport;
+									working_matrix->aggregate_time[origin_target] = combined_time;
+									working_matrix->next_transfer[origin_target] = working_matrix->next_transfer[origin_via];
+									working_matrix->first_transport[origin_target] = working_matrix->first_transport[origin_via];
+									working_matrix->last_transport[origin_target] = working_matrix->last_transport[via_target];
 								}
 							}	// loop : target cluster member
 
@@ -1670,7 +1859,7 @@ void path_explorer_t::compartment_t::step()
 							// iteration control
 							iterations_processed += target_halt_list.get_count();
 							total_iterations += target_halt_list.get_count();
-							if ( use_limits && iterations_processed >= limit_explore_paths )
+							if ( use_limits && iterations_processed >= step_limits.explore_paths )
 							{
 								goto loop_termination;
 							}
@@ -1715,32 +1904,12 @@ void path_explorer_t::compartment_t::step()
 			printf("\t\t\tPath searching -> %lu iterations takes :  %lu ms \n", static_cast<unsigned long>(iterations_processed), diff);
 #endif
 
-			if (via_index == transfer_count)
+			if ( hub_label_search ? origin_member_index == working_halt_count : via_index == transfer_count )
 			{
-				// iteration limit adjustment
+				// iteration limit adjustment, applied by adjust_limits()
 				if ( catg == representative_category )
 				{
-					const uint64 projected_iterations = static_cast<uint64>( statistic_iteration / statistic_duration ) * static_cast<uint64>( time_midpoint );
-					if ( projected_iterations > 0 )
-					{
-						if ( env_t::networkmode )
-						{
-							const uint32 percentage = static_cast<uint32>( projected_iterations * 100 / local_explore_paths );
-							if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
-							{
-								local_explore_paths = projected_iterations;
-								local_limits_changed = true;
-							}
-						}
-						else
-						{
-							const uint32 percentage = static_cast<uint32>( projected_iterations * 100 / limit_explore_paths );
-							if ( percentage < percent_lower_limit || percentage > percent_upper_limit )
-							{
-								limit_explore_paths = projected_iterations;
-							}
-						}
-					}
+					projected_limits.explore_paths = static_cast<uint64>( statistic_iteration / statistic_duration ) * static_cast<uint64>( time_midpoint );
 				}
 
 				// reset statistic variables
@@ -1751,37 +1920,38 @@ void path_explorer_t::compartment_t::step()
 				// path search completed -> delete old path info
 				if (finished_matrix)
 				{
-					for (uint16 i = 0; i < finished_halt_count; ++i)
-					{
-						delete[] finished_matrix[i];
-					}
-					delete[] finished_matrix;
+					delete finished_matrix;
 					finished_matrix = NULL;
 				}
+				if (finished_labels)
+				{
+					delete finished_labels;
+					finished_labels = NULL;
+				}
 				if (finished_halt_index_map)
 				{
 					delete[] finished_halt_index_map;
 					finished_halt_index_map = NULL;
 				}
 
-				// transfer working to finished
+				// transfer working to finished; transport data are no longer needed
+				if (working_matrix)
+				{
+					working_matrix->release_transport();
+				}
 				finished_matrix = working_matrix;
 				working_matrix = NULL;
+				if (working_labels)
+				{
+					working_labels->release_graph();
+				}
+				finished_labels = working_labels;
+				working_labels = NULL;
 				finished_halt_index_map = working_halt_index_map;
 				working_halt_index_map = NULL;
 				finished_halt_count = working_halt_count;
-				// working_halt_count is reset below after deleting transport matrix
 
 				// path search completed -> delete auxilliary data structures
-				if (transport_matrix)
-				{
-					for (uint16 i = 0; i < working_halt_count; ++i)
-					{
-						delete[] transport_matrix[i];
-					}
-					delete[] transport_matrix;
-					transport_matrix = NULL;
-				}
 				working_halt_count = 0;
 				if (transfer_list)
 				{
@@ -1813,6 +1983,15 @@ void path_explorer_t::compartment_t::step()
 				target_cluster_index = 0;
 				origin_member_index = 0;
 
+				phase_counter = 0;
+
+				incremental_search = false;
+				incremental_halts.clear();
+				incremental_vias.clear();
+				incremental_rows.clear();
+
+				hub_label_search = false;
+
 				paths_available = true;
 			}
 
@@ -1943,88 +2122,781 @@ void path_explorer_t::compartment_t::step()
 }
 
 
-void path_explorer_t::compartment_t::enumerate_all_paths(const path_element_t *const *const matrix, const halthandle_t *const halt_list,
-														 const uint16 *const halt_map, const uint16 halt_count)
+bool path_explorer_t::compartment_t::explore_paths_blocked(uint64 &iterations_processed, const uint16 *const vias, const uint16 vias_count,
+															const uint16 *const row_list, const uint16 row_count)
 {
-	// Debugging code : Enumerate all paths for validation
-	halthandle_t transfer_halt;
+	const uint64 iterations_before = iterations_processed;
+	const bool completed = working_matrix->relax_blocked(vias, vias_count, row_list, row_count,
+														  via_index, origin_cluster_index, origin_member_index, target_cluster_index,
+														  use_limits ? step_limits.explore_paths : UINT64_MAX_VALUE, iterations_processed);
+	total_iterations += (uint32)(iterations_processed - iterations_before);
+	return completed;
+}
 
-	for (uint16 x = 0; x < halt_count; ++x)
-	{
-		for (uint16 y = 0; y < halt_count; ++y)
-		{
-			if (x != y)
-			{
-				// print origin
-				printf("\n\nOrigin :  %s\n", halt_list[x]->get_name());
 
-				transfer_halt = matrix[x][y].next_transfer;
+bool path_explorer_t::compartment_t::explore_paths_hub_labels(uint64 &iterations_processed)
+{
+	uint64 hub_iterations;
 
-				if (matrix[x][y].aggregate_time == UINT32_MAX_VALUE)
-				{
-					printf("\t\t\t\t******** No Route ********\n");
-				}
-				else
-				{
-					while (transfer_halt != halt_list[y])
-					{
-						printf("\t\t\t\t%s\n", transfer_halt->get_name());
+	if ( !working_labels->is_ranked() )
+	{
+		hub_iterations = working_labels->rank_halts();
+		iterations_processed += hub_iterations;
+		total_iterations += (uint32)hub_iterations;
+	}
 
-						if ( halt_map[transfer_halt.get_id()] != 65535)
-						{
-							transfer_halt = matrix[ halt_map[transfer_halt.get_id()] ][y].next_transfer;
-						}
-						else
-						{
-							printf("\t\t\t\tError!!!");
-							break;
-						}
-					}
-				}
+	// for each halt, by rank
+	while ( origin_member_index < working_halt_count )
+	{
+		hub_iterations = working_labels->add_hub( (uint16)origin_member_index );
+		iterations_processed += hub_iterations;
+		total_iterations += (uint32)hub_iterations;
 
-				// print destination
-				printf("Target :  %s\n\n", halt_list[y]->get_name());
-			}
+		++origin_member_index;
+
+		// iteration control
+		if ( use_limits && iterations_processed >= step_limits.explore_paths )
+		{
+			return false;
 		}
 	}
+
+	return true;
 }
 
 
-bool path_explorer_t::compartment_t::get_path_between(const halthandle_t origin_halt, const halthandle_t target_halt,
-													  uint32 &aggregate_time, halthandle_t &next_transfer)
+path_explorer_t::compartment_t::hub_labels_t::hub_labels_t(const uint16 count) :
+	halt_count(count),
+	visited(64u),
+	queue(64u)
 {
-	uint16 origin_index, target_index;
+	halt_list = new halthandle_t[halt_count];
+	out_labels = new vector_tpl<label_t>[halt_count];
+	in_labels = new vector_tpl<label_t>[halt_count];
+	out_edges = new vector_tpl<edge_t>[halt_count];
+	in_edges = new vector_tpl<edge_t>[halt_count];
+	transfer = new bool[halt_count]();
+	halt_order = NULL;
+	search_time = NULL;
+	search_hop = NULL;
+	hub_time = NULL;
+}
 
-	// check if origin and target halts are both present in matrix; if yes, check the validity of the next transfer
-	if ( paths_available /*&& origin_halt.is_bound() && target_halt.is_bound()*/
-			&& ( origin_index = finished_halt_index_map[ origin_halt.get_id() ] ) != 65535
-			&& ( target_index = finished_halt_index_map[ target_halt.get_id() ] ) != 65535
-			&& finished_matrix[origin_index][target_index].next_transfer.is_bound() )
-	{
-		aggregate_time = finished_matrix[origin_index][target_index].aggregate_time;
-		next_transfer = finished_matrix[origin_index][target_index].next_transfer;
-		return true;
-	}
 
-	// requested path not found
-	aggregate_time = UINT32_MAX_VALUE;
-	next_transfer = halthandle_t();
-	return false;
+path_explorer_t::compartment_t::hub_labels_t::~hub_labels_t()
+{
+	release_graph();
+	delete[] in_labels;
+	delete[] out_labels;
+	delete[] halt_list;
 }
 
 
-void path_explorer_t::compartment_t::set_category(uint8 category)
+void path_explorer_t::compartment_t::hub_labels_t::release_graph()
 {
-	catg = category;
-	const goods_desc_t *ware_type = goods_manager_t::get_info_catg_index(catg);
-	catg_name = ware_type->get_catg_name();
+	delete[] out_edges;
+	out_edges = NULL;
+	delete[] in_edges;
+	in_edges = NULL;
+	delete[] transfer;
+	transfer = NULL;
+	delete[] halt_order;
+	halt_order = NULL;
+	delete[] search_time;
+	search_time = NULL;
+	delete[] search_hop;
+	search_hop = NULL;
+	delete[] hub_time;
+	hub_time = NULL;
+	vector_tpl<uint16> no_visited;
+	swap(visited, no_visited);
+	vector_tpl<edge_t> no_queue;
+	swap(queue, no_queue);
+
+	// labels do not grow any more, so free their spare capacity
+	for ( uint16 i = 0; i < halt_count; ++i )
+	{
+		compact_labels(out_labels[i]);
+		compact_labels(in_labels[i]);
+	}
 }
 
-void path_explorer_t::compartment_t::set_class(uint8 value)
-{
-	g_class = value;
-	delete[] class_name;
-	class_name = new char[96];
+
+void path_explorer_t::compartment_t::hub_labels_t::compact_labels(vector_tpl<label_t> &labels)
+{
+	vector_tpl<label_t> compacted( labels.get_count() );
+	for ( uint32 l = 0; l < labels.get_count(); ++l )
+	{
+		compacted.append( labels[l] );
+	}
+	swap(labels, compacted);
+}
+
+
+// orders halts for ranking : transfers first, then by the number of connexions, then by index
+struct hub_rank_order_t
+{
+	const bool *transfer;
+	const uint32 *degree;
+
+	bool operator()(const uint16 a, const uint16 b) const
+	{
+		if ( transfer[a] != transfer[b] )
+		{
+			return transfer[a];
+		}
+		if ( degree[a] != degree[b] )
+		{
+			return degree[a] > degree[b];
+		}
+		return a < b;
+	}
+};
+
+
+uint64 path_explorer_t::compartment_t::hub_labels_t::rank_halts()
+{
+	uint32 *const degree = new uint32[halt_count];
+	halt_order = new uint16[halt_count];
+	for ( uint16 i = 0; i < halt_count; ++i )
+	{
+		degree[i] = out_edges[i].get_count() + in_edges[i].get_count();
+		halt_order[i] = i;
+	}
+
+	hub_rank_order_t order;
+	order.transfer = transfer;
+	order.degree = degree;
+	std::sort(halt_order, halt_order + halt_count, order);
+
+	delete[] degree;
+	return (uint64)halt_count * 16u;
+}
+
+
+void path_explorer_t::compartment_t::hub_labels_t::push_queue(const edge_t &entry)
+{
+	uint32 gap = queue.get_count();
+	queue.append(entry);
+	while ( gap > 0 )
+	{
+		const uint32 parent = ( gap - 1 ) >> 1;
+		if ( queue[parent].aggregate_time <= entry.aggregate_time )
+		{
+			break;
+		}
+		queue[gap] = queue[parent];
+		gap = parent;
+	}
+	queue[gap] = entry;
+}
+
+
+path_explorer_t::compartment_t::hub_labels_t::edge_t path_explorer_t::compartment_t::hub_labels_t::pop_queue()
+{
+	const edge_t top = queue[0];
+	const edge_t last = queue.pop_back();
+	const uint32 count = queue.get_count();
+	if ( count > 0 )
+	{
+		uint32 gap = 0;
+		for ( uint32 child = 1; child < count; child = ( gap << 1 ) + 1 )
+		{
+			if ( child + 1 < count && queue[child + 1].aggregate_time < queue[child].aggregate_time )
+			{
+				++child;
+			}
+			if ( last.aggregate_time <= queue[child].aggregate_time )
+			{
+				break;
+			}
+			queue[gap] = queue[child];
+			gap = child;
+		}
+		queue[gap] = last;
+	}
+	return top;
+}
+
+
+uint64 path_explorer_t::compartment_t::hub_labels_t::add_hub(const uint16 rank)
+{
+	if ( !search_time )
+	{
+		search_time = new uint32[halt_count];
+		search_hop = new uint16[halt_count];
+		hub_time = new uint32[halt_count];
+		for ( uint16 i = 0; i < halt_count; ++i )
+		{
+			search_time[i] = UINT32_MAX_VALUE;
+			hub_time[i] = UINT32_MAX_VALUE;
+		}
+	}
+
+	const uint16 hub = halt_order[rank];
+	uint64 iterations = 0;
+
+	if ( !transfer[hub] )
+	{
+		// Halts which are not transfers are ranked after all transfers, and are not searched from, as paths cannot
+		// pass through them. Fastest paths with a transfer on them have a hub there already, so only the direct
+		// connexions from other halts which are not transfers remain to be labelled.
+		label_t label;
+		label.aggregate_time = 0;
+		label.hub = rank;
+		out_labels[hub].append(label);
+		in_labels[hub].append(label);
+
+		const vector_tpl<edge_t> &hub_edges = in_edges[hub];
+		label.next_transfer = halt_list[hub];
+		for ( uint32 e = 0; e < hub_edges.get_count(); ++e )
+		{
+			if ( !transfer[ hub_edges[e].halt ] )
+			{
+				label.aggregate_time = hub_edges[e].aggregate_time;
+				out_labels[ hub_edges[e].halt ].append(label);
+			}
+		}
+		return hub_edges.get_count() + 1;
+	}
+
+	// search forwards for the paths from the hub, then backwards for the paths to it
+	for ( uint8 direction = 0; direction < 2; ++direction )
+	{
+		const bool forward = direction == 0;
+		vector_tpl<label_t> *const labels = forward ? in_labels : out_labels;
+		vector_tpl<edge_t> *const edges = forward ? out_edges : in_edges;
+
+		// the paths between the hub and the hubs of higher rank, for pruning
+		const vector_tpl<label_t> &hub_labels = forward ? out_labels[hub] : in_labels[hub];
+		for ( uint32 l = 0; l < hub_labels.get_count(); ++l )
+		{
+			hub_time[ hub_labels[l].hub ] = hub_labels[l].aggregate_time;
+		}
+
+		edge_t entry;
+		entry.aggregate_time = 0;
+		entry.halt = hub;
+		search_time[hub] = 0;
+		visited.append(hub);
+		push_queue(entry);
+
+		while ( !queue.empty() )
+		{
+			entry = pop_queue();
+			const uint16 halt = entry.halt;
+			const uint32 time = entry.aggregate_time;
+			if ( time > search_time[halt] )
+			{
+				continue;
+			}
+
+			// a path at least as fast through a hub of higher rank makes this path and its extensions redundant
+			vector_tpl<label_t> &halt_labels = labels[halt];
+			bool redundant = false;
+			for ( uint32 l = 0; l < halt_labels.get_count(); ++l )
+			{
+				const uint32 known_time = hub_time[ halt_labels[l].hub ];
+				if ( known_time != UINT32_MAX_VALUE && known_time + halt_labels[l].aggregate_time <= time )
+				{
+					redundant = true;
+					break;
+				}
+			}
+			iterations += halt_labels.get_count() + 1;
+			if ( redundant )
+			{
+				continue;
+			}
+
+			label_t label;
+			label.aggregate_time = time;
+			label.hub = rank;
+			if ( halt != hub )
+			{
+				label.next_transfer = halt_list[ search_hop[halt] ];
+			}
+			halt_labels.append(label);
+
+			// paths can only pass through transfers
+			if ( halt != hub && !transfer[halt] )
+			{
+				continue;
+			}
+
+			const vector_tpl<edge_t> &halt_edges = edges[halt];
+			for ( uint32 e = 0; e < halt_edges.get_count(); ++e )
+			{
+				const edge_t &edge = halt_edges[e];
+				const uint32 combined_time = time + edge.aggregate_time;
+				if ( combined_time < search_time[edge.halt] )
+				{
+					if ( search_time[edge.halt] == UINT32_MAX_VALUE )
+					{
+						visited.append(edge.halt);
+					}
+					search_time[edge.halt] = combined_time;
+
+					// forwards, the next transfer is the first halt after the hub;
+					// backwards, it is the halt after the one just reached
+					if ( forward )
+					{
+						search_hop[edge.halt] = halt == hub ? edge.halt : search_hop[halt];
+					}
+					else
+					{
+						search_hop[edge.halt] = halt;
+					}
+
+					entry.aggregate_time = combined_time;
+					entry.halt = edge.halt;
+					push_queue(entry);
+				}
+			}
+			iterations += halt_edges.get_count();
+		}
+
+		// clear the scratch data for the next search
+		for ( uint32 v = 0; v < visited.get_count(); ++v )
+		{
+			search_time[ visited[v] ] = UINT32_MAX_VALUE;
+		}
+		visited.clear();
+		for ( uint32 l = 0; l < hub_labels.get_count(); ++l )
+		{
+			hub_time[ hub_labels[l].hub ] = UINT32_MAX_VALUE;
+		}
+	}
+
+	return iterations;
+}
+
+
+bool path_explorer_t::compartment_t::hub_labels_t::get_path(const uint16 origin, const uint16 target,
+															 uint32 &aggregate_time, halthandle_t &next_transfer) const
+{
+	const vector_tpl<label_t> &origin_labels = out_labels[origin];
+	const vector_tpl<label_t> &target_labels = in_labels[target];
+
+	aggregate_time = UINT32_MAX_VALUE;
+	next_transfer = halthandle_t();
+
+	// both label lists are ordered by hub rank
+	uint32 o = 0;
+	uint32 t = 0;
+	while ( o < origin_labels.get_count() && t < target_labels.get_count() )
+	{
+		if ( origin_labels[o].hub < target_labels[t].hub )
+		{
+			++o;
+		}
+		else if ( origin_labels[o].hub > target_labels[t].hub )
+		{
+			++t;
+		}
+		else
+		{
+			const uint32 combined_time = origin_labels[o].aggregate_time + target_labels[t].aggregate_time;
+			if ( combined_time < aggregate_time )
+			{
+				aggregate_time = combined_time;
+				// if the origin is the hub itself, the next transfer is that of the path from the hub
+				next_transfer = origin_labels[o].next_transfer.is_bound() ? origin_labels[o].next_transfer : target_labels[t].next_transfer;
+			}
+			++o;
+			++t;
+		}
+	}
+
+	return aggregate_time != UINT32_MAX_VALUE;
+}
+
+
+void path_explorer_t::compartment_t::hub_labels_t::rdwr_edges(loadsave_t *file, vector_tpl<edge_t> &edges)
+{
+	uint32 count = edges.get_count();
+	file->rdwr_long(count);
+	if ( file->is_loading() )
+	{
+		edges.clear();
+		edges.resize(count);
+	}
+	for ( uint32 i = 0; i < count; ++i )
+	{
+		edge_t edge;
+		if ( file->is_saving() )
+		{
+			edge = edges[i];
+		}
+		file->rdwr_long(edge.aggregate_time);
+		file->rdwr_short(edge.halt);
+		if ( file->is_loading() )
+		{
+			edges.append(edge);
+		}
+	}
+}
+
+
+void path_explorer_t::compartment_t::hub_labels_t::rdwr_labels(loadsave_t *file, vector_tpl<label_t> &labels)
+{
+	uint32 count = labels.get_count();
+	file->rdwr_long(count);
+	if ( file->is_loading() )
+	{
+		labels.clear();
+		labels.resize(count);
+	}
+	for ( uint32 i = 0; i < count; ++i )
+	{
+		label_t label;
+		uint16 id;
+		if ( file->is_saving() )
+		{
+			label = labels[i];
+			id = label.next_transfer.get_id();
+		}
+		file->rdwr_long(label.aggregate_time);
+		file->rdwr_short(label.hub);
+		file->rdwr_short(id);
+		if ( file->is_loading() )
+		{
+			label.next_transfer.set_id(id);
+			labels.append(label);
+		}
+	}
+}
+
+
+void path_explorer_t::compartment_t::hub_labels_t::rdwr(loadsave_t *file)
+{
+	// the halt count is given on construction
+	for ( uint16 i = 0; i < halt_count; ++i )
+	{
+		uint16 id = halt_list[i].get_id();
+		file->rdwr_short(id);
+		halt_list[i].set_id(id);
+	}
+
+	for ( uint16 i = 0; i < halt_count; ++i )
+	{
+		rdwr_labels(file, out_labels[i]);
+		rdwr_labels(file, in_labels[i]);
+	}
+
+	bool graph_live = out_edges != NULL;
+	file->rdwr_bool(graph_live);
+	if ( graph_live )
+	{
+		for ( uint16 i = 0; i < halt_count; ++i )
+		{
+			file->rdwr_bool(transfer[i]);
+			rdwr_edges(file, out_edges[i]);
+			rdwr_edges(file, in_edges[i]);
+		}
+
+		bool ranked = halt_order != NULL;
+		file->rdwr_bool(ranked);
+		if ( ranked )
+		{
+			if ( file->is_loading() )
+			{
+				halt_order = new uint16[halt_count];
+			}
+			for ( uint16 i = 0; i < halt_count; ++i )
+			{
+				file->rdwr_short(halt_order[i]);
+			}
+		}
+	}
+	else if ( file->is_loading() )
+	{
+		release_graph();
+	}
+}
+
+
+bool path_explorer_t::compartment_t::seed_incremental_search(uint64 &iterations_processed)
+{
+	// Only halts on the changed schedules gain or lose connexions, so a finished path remains valid as long as
+	// it neither starts at nor passes through such a halt. The rows of the changed halts and of any other halts
+	// with paths through them are explored again, after which the changed transfers are used to find new paths.
+	// Paths between other halts are kept, even if their journey times have since changed a little.
+	// The seeding takes two passes over the targets, and may be spread over several steps : origin_cluster_index
+	// is the pass and origin_member_index the next target. The first pass lists the rows to be explored again,
+	// and the second copies the valid paths.
+	const uint16 halt_count = working_halt_count;
+	const uint16 finished_count = finished_halt_count;
+	bool feasible = finished_matrix && finished_halt_index_map && halt_count > 0;
+	uint64 seed_iterations = 0;
+
+	if ( feasible )
+	{
+		// map the working halt indices to those of the finished matrix
+		uint16 *const finished_index = new uint16[halt_count];
+		for ( uint32 id = 0; id < HALT_ID_RANGE; ++id )
+		{
+			if ( working_halt_index_map[id] != 65535 )
+			{
+				finished_index[ working_halt_index_map[id] ] = finished_halt_index_map[id];
+			}
+		}
+
+		bool *const changed_working = new bool[halt_count]();
+		bool *const changed_finished = new bool[finished_count]();
+		for ( uint32 i = 0; i < incremental_halts.get_count(); ++i )
+		{
+			const uint16 id = incremental_halts[i];
+			if ( working_halt_index_map[id] != 65535 )
+			{
+				changed_working[ working_halt_index_map[id] ] = true;
+			}
+			if ( finished_halt_index_map[id] != 65535 )
+			{
+				changed_finished[ finished_halt_index_map[id] ] = true;
+			}
+		}
+
+		if ( origin_cluster_index == 0 && origin_member_index == 0 )
+		{
+			// the rows of the changed halts are explored again in any case
+			incremental_rows.clear();
+			for ( uint16 i = 0; i < halt_count; ++i )
+			{
+				if ( changed_working[i] )
+				{
+					incremental_rows.append(i);
+				}
+				else if ( finished_index[i] == 65535 )
+				{
+					// only the changed schedules can connect halts which have not been connected before
+					feasible = false;
+				}
+			}
+		}
+
+		bool *const explore_row = new bool[halt_count]();
+		for ( uint32 i = 0; i < incremental_rows.get_count(); ++i )
+		{
+			explore_row[ incremental_rows[i] ] = true;
+		}
+		seed_iterations += HALT_ID_RANGE + halt_count + incremental_halts.get_count() + incremental_rows.get_count();
+
+		const uint64 seed_limit = !use_limits ? UINT64_MAX_VALUE
+								: iterations_processed < step_limits.explore_paths ? step_limits.explore_paths - iterations_processed : 0;
+		while ( feasible && origin_cluster_index < 2 )
+		{
+			const uint32 pass = origin_cluster_index;
+			if ( !working_matrix->seed_paths(*finished_matrix, finished_index, finished_halt_index_map, changed_finished, explore_row,
+											 incremental_rows, pass == 1, origin_member_index,
+											 seed_limit, seed_iterations) )
+			{
+				// resumed in the next step
+				break;
+			}
+
+			if ( pass == 0 )
+			{
+				incremental_vias.clear();
+				for ( uint16 t = 0; t < transfer_count; ++t )
+				{
+					if ( changed_working[ transfer_list[t] ] )
+					{
+						incremental_vias.append( transfer_list[t] );
+					}
+				}
+
+				// compare with a full exploration, allowing for the cost of the seeding itself and
+				// for the rows of the transfers, which are completed for each block of transfers
+				const uint64 row_count = incremental_rows.get_count() + min( transfer_count, path_matrix_t::tile_size );
+				const uint64 via_row_count = halt_count + min( (uint16)incremental_vias.get_count(), path_matrix_t::tile_size );
+				const uint64 incremental_cost = row_count * transfer_count * halt_count
+											  + (uint64)incremental_vias.get_count() * via_row_count * halt_count;
+				const uint64 full_cost = (uint64)transfer_count * halt_count * halt_count;
+				feasible = incremental_cost * 2 < full_cost;
+			}
+
+			origin_cluster_index = pass + 1;
+			origin_member_index = 0;
+		}
+
+		delete[] explore_row;
+		delete[] changed_finished;
+		delete[] changed_working;
+		delete[] finished_index;
+	}
+
+	iterations_processed += seed_iterations;
+	total_iterations += (uint32)seed_iterations;
+
+	if ( !feasible )
+	{
+		// explore all paths instead
+		incremental_search = false;
+		incremental_vias.clear();
+		incremental_rows.clear();
+		return true;
+	}
+
+	return origin_cluster_index == 2;
+}
+
+
+bool path_explorer_t::compartment_t::explore_paths_incremental(uint64 &iterations_processed)
+{
+	// Both stages are Floyd-Warshall with the transfers as the outermost loop, as the rows may be connected
+	// through each other. First the listed rows are explored again through all transfers : the rows which
+	// are kept are complete but for paths through the changed transfers, so afterwards each pair of halts
+	// has its shortest path without these. Then all rows are explored through the changed transfers only.
+	if ( phase_counter == incremental_stage_rows )
+	{
+		if ( !explore_paths_blocked(iterations_processed, transfer_list, transfer_count, incremental_rows.begin(), (uint16)incremental_rows.get_count()) )
+		{
+			return false;
+		}
+
+		phase_counter = incremental_stage_vias;
+		via_index = 0;
+		origin_cluster_index = 0;
+		origin_member_index = 0;
+		target_cluster_index = 0;
+	}
+
+	return explore_paths_blocked(iterations_processed, incremental_vias.begin(), (uint16)incremental_vias.get_count(), NULL, working_halt_count);
+}
+
+
+void path_explorer_t::compartment_t::set_refresh(const vector_tpl<halthandle_t> *const affected_halts)
+{
+	const uint32 threshold = world->get_settings().get_path_explorer_incremental_threshold();
+
+	if ( affected_halts == NULL || threshold == 0 )
+	{
+		refresh_requested = true;
+		refresh_incremental = false;
+		changed_halts.clear();
+		return;
+	}
+
+	if ( !refresh_requested )
+	{
+		refresh_requested = true;
+		refresh_incremental = true;
+		changed_halts.clear();
+	}
+
+	// a refresh already requested for other reasons may still be incremental if it was requested for other halts
+	if ( refresh_incremental )
+	{
+		for ( uint32 i = 0; i < affected_halts->get_count(); ++i )
+		{
+			if ( (*affected_halts)[i].is_bound() )
+			{
+				changed_halts.append_unique( (*affected_halts)[i].get_id() );
+			}
+		}
+
+		if ( changed_halts.get_count() > threshold )
+		{
+			refresh_incremental = false;
+			changed_halts.clear();
+		}
+	}
+}
+
+
+void path_explorer_t::compartment_t::enumerate_all_paths(const path_matrix_t *const matrix, const halthandle_t *const halt_list,
+														 const uint16 *const halt_map, const uint16 halt_count)
+{
+	// Debugging code : Enumerate all paths for validation
+	halthandle_t transfer_halt;
+
+	for (uint16 x = 0; x < halt_count; ++x)
+	{
+		for (uint16 y = 0; y < halt_count; ++y)
+		{
+			if (x != y)
+			{
+				// print origin
+				printf("\n\nOrigin :  %s\n", halt_list[x]->get_name());
+
+				transfer_halt = matrix->next_transfer[ matrix->index(x, y) ];
+
+				if (matrix->aggregate_time[ matrix->index(x, y) ] == UINT32_MAX_VALUE)
+				{
+					printf("\t\t\t\t******** No Route ********\n");
+				}
+				else
+				{
+					while (transfer_halt != halt_list[y])
+					{
+						printf("\t\t\t\t%s\n", transfer_halt->get_name());
+
+						if ( halt_map[transfer_halt.get_id()] != 65535)
+						{
+							transfer_halt = matrix->next_transfer[ matrix->index(halt_map[transfer_halt.get_id()], y) ];
+						}
+						else
+						{
+							printf("\t\t\t\tError!!!");
+							break;
+						}
+					}
+				}
+
+				// print destination
+				printf("Target :  %s\n\n", halt_list[y]->get_name());
+			}
+		}
+	}
+}
+
+
+bool path_explorer_t::compartment_t::get_path_between(const halthandle_t origin_halt, const halthandle_t target_halt,
+													  uint32 &aggregate_time, halthandle_t &next_transfer)
+{
+	uint16 origin_index, target_index;
+
+	// check if origin and target halts are both present in matrix; if yes, check the validity of the next transfer
+	if ( paths_available /*&& origin_halt.is_bound() && target_halt.is_bound()*/
+			&& ( origin_index = finished_halt_index_map[ origin_halt.get_id() ] ) != 65535
+			&& ( target_index = finished_halt_index_map[ target_halt.get_id() ] ) != 65535 )
+	{
+		if ( finished_labels )
+		{
+			if ( finished_labels->get_path(origin_index, target_index, aggregate_time, next_transfer) && next_transfer.is_bound() )
+			{
+				return true;
+			}
+		}
+		else if ( finished_matrix->next_transfer[ finished_matrix->index(origin_index, target_index) ].is_bound() )
+		{
+			const size_t element = finished_matrix->index(origin_index, target_index);
+			aggregate_time = finished_matrix->aggregate_time[element];
+			next_transfer = finished_matrix->next_transfer[element];
+			return true;
+		}
+	}
+
+	// requested path not found
+	aggregate_time = UINT32_MAX_VALUE;
+	next_transfer = halthandle_t();
+	return false;
+}
+
+
+void path_explorer_t::compartment_t::set_category(uint8 category)
+{
+	catg = category;
+	const goods_desc_t *ware_type = goods_manager_t::get_info_catg_index(catg);
+	catg_name = ware_type->get_catg_name();
+}
+
+void path_explorer_t::compartment_t::set_class(uint8 value)
+{
+	g_class = value;
+	delete[] class_name;
+	class_name = new char[96];
 
 	if (catg == goods_manager_t::INDEX_PAS)
 	{
@@ -2043,7 +2915,7 @@ void path_explorer_t::compartment_t::set_class(uint8 value)
 
 void path_explorer_t::compartment_t::initialise_connexion_list()
 {
-	for (uint32 i = 0; i < 65536; ++i)
+	for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 	{
 		// Note that the connexion_tables created here will be
 		// swapped with connexion_tables created/stored in halts.
@@ -2070,7 +2942,7 @@ void path_explorer_t::compartment_t::reset_connexion_entry(const uint16 halt_id)
 
 void path_explorer_t::compartment_t::reset_connexion_list()
 {
-	for (uint32 i = 0; i < 65536; ++i)
+	for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 	{
 		if ( connexion_list[i].connexion_table )
 		{
@@ -2082,7 +2954,7 @@ void path_explorer_t::compartment_t::reset_connexion_list()
 
 void path_explorer_t::compartment_t::finalise_connexion_list()
 {
-	for (uint32 i = 0; i < 65536; ++i)
+	for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 	{
 		reset_connexion_entry(i);
 		delete connexion_list[i].connexion_table;
@@ -2103,9 +2975,9 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 	{
 		if (file->is_loading())
 		{
-			finished_halt_index_map = new uint16[65536];
+			finished_halt_index_map = new uint16[HALT_ID_RANGE];
 		}
-		for (uint32 i = 0; i < 65536; ++i)
+		for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 		{
 			file->rdwr_short(finished_halt_index_map[i]);
 		}
@@ -2119,15 +2991,13 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 		if (file->is_saving())
 		{
 			uint16 tmp_idx;
-			for (uint16 i = 0; i < finished_halt_count; i++)
+			//  This is a 2 dimensional array, stored row by row
+			const size_t element_count = (size_t)finished_halt_count * finished_halt_count;
+			for (size_t i = 0; i < element_count; i++)
 			{
-				//  This is a 2 dimensional array
-				for (uint32 j = 0; j < finished_halt_count; j++)
-				{
-					file->rdwr_long(finished_matrix[i][j].aggregate_time);
-					tmp_idx = finished_matrix[i][j].next_transfer.get_id();
-					file->rdwr_short(tmp_idx);
-				}
+				file->rdwr_long(finished_matrix->aggregate_time[i]);
+				tmp_idx = finished_matrix->next_transfer[i].get_id();
+				file->rdwr_short(tmp_idx);
 			}
 		}
 		else // Loading
@@ -2137,21 +3007,15 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			{
 				// Build the (empty) finished matrix
 				uint16 tmp_idx;
-				finished_matrix = new path_element_t*[finished_halt_count];
-				for (uint16 i = 0; i < finished_halt_count; ++i)
-				{
-					finished_matrix[i] = new path_element_t[finished_halt_count];
-				}
+				finished_matrix = new path_matrix_t(finished_halt_count, false);
 
-				// Now load them. These are 2 dimensional arrays.
-				for (uint16 i = 0; i < finished_halt_count; i++)
+				// Now load it. This is a 2 dimensional array, stored row by row.
+				const size_t element_count = (size_t)finished_halt_count * finished_halt_count;
+				for (size_t i = 0; i < element_count; i++)
 				{
-					for (uint32 j = 0; j < finished_halt_count; j++)
-					{
-						file->rdwr_long(finished_matrix[i][j].aggregate_time);
-						file->rdwr_short(tmp_idx);
-						finished_matrix[i][j].next_transfer.set_id(tmp_idx);
-					}
+					file->rdwr_long(finished_matrix->aggregate_time[i]);
+					file->rdwr_short(tmp_idx);
+					finished_matrix->next_transfer[i].set_id(tmp_idx);
 				}
 			}
 		}
@@ -2168,17 +3032,15 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 		if (file->is_saving())
 		{
 			uint16 tmp_idx;
-			for (uint16 i = 0; i < working_halt_count; i++)
+			const size_t element_count = (size_t)working_halt_count * working_halt_count;
+			for (size_t i = 0; i < element_count; i++)
 			{
-				for (uint32 j = 0; j < working_halt_count; j++)
-				{
-					file->rdwr_long(working_matrix[i][j].aggregate_time);
-					tmp_idx = working_matrix[i][j].next_transfer.get_id();
-					file->rdwr_short(tmp_idx);
+				file->rdwr_long(working_matrix->aggregate_time[i]);
+				tmp_idx = working_matrix->next_transfer[i].get_id();
+				file->rdwr_short(tmp_idx);
 
-					file->rdwr_short(transport_matrix[i][j].first_transport);
-					file->rdwr_short(transport_matrix[i][j].last_transport);
-				}
+				file->rdwr_short(working_matrix->first_transport[i]);
+				file->rdwr_short(working_matrix->last_transport[i]);
 			}
 		}
 
@@ -2187,34 +3049,20 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			// Create the matrices
 			if (working_halt_count > 0)
 			{
-				// build working matrix
+				// build working matrix together with its transport data
 				uint16 tmp_idx;
-				working_matrix = new path_element_t*[working_halt_count];
-				for (uint16 i = 0; i < working_halt_count; ++i)
-				{
-					working_matrix[i] = new path_element_t[working_halt_count];
-
-				}
-
-				// build transport matrix
-				transport_matrix = new transport_element_t*[working_halt_count];
-				for (uint16 i = 0; i < working_halt_count; ++i)
-				{
-					transport_matrix[i] = new transport_element_t[working_halt_count];
-				}
+				working_matrix = new path_matrix_t(working_halt_count, true);
 
-				// Now load them. These are 2 dimensional arrays.
-				for (uint16 i = 0; i < working_halt_count; i++)
+				// Now load it. This is a 2 dimensional array, stored row by row.
+				const size_t element_count = (size_t)working_halt_count * working_halt_count;
+				for (size_t i = 0; i < element_count; i++)
 				{
-					for (uint32 j = 0; j < working_halt_count; j++)
-					{
-						file->rdwr_long(working_matrix[i][j].aggregate_time);
-						file->rdwr_short(tmp_idx);
-						working_matrix[i][j].next_transfer.set_id(tmp_idx);
+					file->rdwr_long(working_matrix->aggregate_time[i]);
+					file->rdwr_short(tmp_idx);
+					working_matrix->next_transfer[i].set_id(tmp_idx);
 
-						file->rdwr_short(transport_matrix[i][j].first_transport);
-						file->rdwr_short(transport_matrix[i][j].last_transport);
-					}
+					file->rdwr_short(working_matrix->first_transport[i]);
+					file->rdwr_short(working_matrix->last_transport[i]);
 				}
 			}
 		}
@@ -2227,8 +3075,8 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 	{
 		if (file->is_loading())
 		{
-			working_halt_index_map = new uint16[65536];
-			for (uint32 i = 0; i < 65536; ++i)
+			working_halt_index_map = new uint16[HALT_ID_RANGE];
+			for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 			{
 				// For quickstone handle, there can at most be 65535 valid entries, plus entry 0 which is reserved for null handle
 				// Thus, the range of quickstone entries [1, 65535] is mapped to the range of matrix index [0, 65534]
@@ -2237,7 +3085,7 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 				working_halt_index_map[i] = 65535;
 			}
 		}
-		for (uint32 i = 0; i < 65536; ++i)
+		for (uint32 i = 0; i < HALT_ID_RANGE; ++i)
 		{
 			file->rdwr_short(working_halt_index_map[i]);
 		}
@@ -2248,12 +3096,23 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 
 	if (transport_index_map_live)
 	{
+		if (file->is_version_ex_atleast(14, 73))
+		{
+			file->rdwr_long(transport_convoy_offset);
+			file->rdwr_long(transport_index_map_size);
+		}
+		else
+		{
+			transport_convoy_offset = 65536u;
+			transport_index_map_size = 131072u;
+		}
+
 		if (file->is_loading())
 		{
-			transport_index_map = new uint16[131072]();		// initialise all elements to zero
+			transport_index_map = new uint16[transport_index_map_size]();		// initialise all elements to zero
 		}
 
-		for (uint32 i = 0; i < 131072; i++)
+		for (uint32 i = 0; i < transport_index_map_size; i++)
 		{
 			file->rdwr_short(transport_index_map[i]);
 		}
@@ -2331,8 +3190,8 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			linkages = new vector_tpl<linkage_t>(linkages_count);
 		}
 
-		uint16 cnv_id;
-		uint16 line_id;
+		quickstone_id_t cnv_id;
+		quickstone_id_t line_id;
 		for (uint32 i = 0; i < linkages_count; i++)
 		{
 			if (file->is_saving())
@@ -2341,8 +3200,8 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 				line_id = linkages->get_element(i).line.get_id();
 			}
 
-			file->rdwr_short(cnv_id);
-			file->rdwr_short(line_id);
+			file->rdwr_handle_id(cnv_id);
+			file->rdwr_handle_id(line_id);
 
 			if(file->is_loading())
 			{
@@ -2379,6 +3238,82 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 
 	file->rdwr_byte(current_phase);
 
+	if (file->is_version_ex_atleast(14, 65))
+	{
+		file->rdwr_bool(blocked_search);
+	}
+	else if (file->is_loading())
+	{
+		blocked_search = false;
+	}
+
+	if (file->is_version_ex_atleast(14, 67))
+	{
+		file->rdwr_bool(refresh_incremental);
+		file->rdwr_bool(incremental_search);
+		vector_tpl<uint16> *const incremental_lists[] = { &changed_halts, &incremental_halts, &incremental_vias, &incremental_rows };
+		for (uint32 l = 0; l < lengthof(incremental_lists); l++)
+		{
+			vector_tpl<uint16> &list = *incremental_lists[l];
+			uint32 count = list.get_count();
+			file->rdwr_long(count);
+			if (file->is_loading())
+			{
+				list.clear();
+				list.resize(count);
+				for (uint32 i = 0; i < count; i++)
+				{
+					uint16 value;
+					file->rdwr_short(value);
+					list.append(value);
+				}
+			}
+			else
+			{
+				for (uint32 i = 0; i < count; i++)
+				{
+					file->rdwr_short(list[i]);
+				}
+			}
+		}
+	}
+	else if (file->is_loading())
+	{
+		refresh_incremental = false;
+		incremental_search = false;
+	}
+
+	if (file->is_version_ex_atleast(14, 68))
+	{
+		file->rdwr_bool(hub_label_search);
+
+		bool finished_labels_live = finished_labels != NULL;
+		file->rdwr_bool(finished_labels_live);
+		if (finished_labels_live)
+		{
+			if (file->is_loading())
+			{
+				finished_labels = new hub_labels_t(finished_halt_count);
+			}
+			finished_labels->rdwr(file);
+		}
+
+		bool working_labels_live = working_labels != NULL;
+		file->rdwr_bool(working_labels_live);
+		if (working_labels_live)
+		{
+			if (file->is_loading())
+			{
+				working_labels = new hub_labels_t(working_halt_count);
+			}
+			working_labels->rdwr(file);
+		}
+	}
+	else if (file->is_loading())
+	{
+		hub_label_search = false;
+	}
+
 	file->rdwr_short(phase_counter);
 	file->rdwr_long(iterations);
 	file->rdwr_long(total_iterations);
@@ -18,6 +18,7 @@
 #include "simdebug.h"
 
 #include "tpl/vector_tpl.h"
+#include "tpl/path_matrix_tpl.h"
 #include "tpl/quickstone_hashtable_tpl.h"
 
 
@@ -125,27 +126,100 @@ private:
 
 	private:
 
-		// element used during path search and for storing calculated paths
-		struct path_element_t
+		// square matrix used during path search and for storing calculated paths
+		typedef path_matrix_tpl<halthandle_t> path_matrix_t;
+
+		// Hub labels : an alternative to the path matrix for networks with very many halts.
+		// Each halt keeps the fastest paths from itself to some hubs and from some hubs to itself, such that the
+		// fastest path between any two halts passes through a hub which they have in common. The labels are built
+		// by a pruned search from every transfer in turn, the most connected transfers first, so that they stay small;
+		// other halts are only hubs for the direct connexions between them, as no path can pass through them;
+		// memory thus grows with the number of halts times the label size rather than with the square of the
+		// number of halts. Unlike the matrix search, transfers between the same line/lineless convoy are not
+		// excluded, as such paths are never faster than staying on board.
+		class hub_labels_t
 		{
-			uint32 aggregate_time;
-			halthandle_t next_transfer;
 
-			path_element_t() :
-				aggregate_time(UINT32_MAX_VALUE)
-			{}
-		};
+		public:
 
-		// element used during path search only for storing best lines/convoys
-		struct transport_element_t
-		{
-			uint16 first_transport;
-			uint16 last_transport;
+			struct label_t
+			{
+				uint32 aggregate_time;
+				uint16 hub;					// rank of the hub
+				halthandle_t next_transfer;	// from the labelled halt for paths to hubs, from the hub for paths from hubs
+			};
 
-			transport_element_t() :
-				first_transport(0),
-				last_transport(0)
-			{}
+			struct edge_t
+			{
+				uint32 aggregate_time;
+				uint16 halt;
+			};
+
+		private:
+
+			uint16 halt_count;
+			halthandle_t *halt_list;
+
+			vector_tpl<label_t> *out_labels;	// paths from each halt to hubs, ordered by hub rank
+			vector_tpl<label_t> *in_labels;	// paths from hubs to each halt, ordered by hub rank
+
+			// connexion graph, only kept while the labels are being built
+			vector_tpl<edge_t> *out_edges;
+			vector_tpl<edge_t> *in_edges;
+			bool *transfer;
+			uint16 *halt_order;	// halts in the order of hub ranks
+
+			// scratch data for searching, indexed by halt except hub_time which is indexed by hub rank
+			uint32 *search_time;
+			uint16 *search_hop;
+			uint32 *hub_time;
+			vector_tpl<uint16> visited;
+			vector_tpl<edge_t> queue;	// binary heap ordered by aggregate time
+
+			void push_queue(const edge_t &entry);
+			edge_t pop_queue();
+
+			static void compact_labels(vector_tpl<label_t> &labels);
+
+			void rdwr_edges(loadsave_t *file, vector_tpl<edge_t> &edges);
+			void rdwr_labels(loadsave_t *file, vector_tpl<label_t> &labels);
+
+		public:
+
+			hub_labels_t(const uint16 count);
+			~hub_labels_t();
+
+			void set_halt(const uint16 index, const halthandle_t halt, const bool is_transfer)
+			{
+				halt_list[index] = halt;
+				transfer[index] = is_transfer;
+			}
+
+			void add_connexion(const uint16 origin, const uint16 target, const uint32 aggregate_time)
+			{
+				edge_t edge;
+				edge.aggregate_time = aggregate_time;
+				edge.halt = target;
+				out_edges[origin].append(edge);
+				edge.halt = origin;
+				in_edges[target].append(edge);
+			}
+
+			bool is_ranked() const { return halt_order != NULL; }
+
+			// determine the order in which halts become hubs; returns the number of iterations performed
+			uint64 rank_halts();
+
+			// label the paths from and to the halt of the given rank, or only its direct connexions from other
+			// halts which are not transfers if it is not a transfer; returns the number of iterations performed
+			uint64 add_hub(const uint16 rank);
+
+			// the connexion graph is no longer needed once all halts have become hubs
+			void release_graph();
+
+			bool get_path(const uint16 origin, const uint16 target, uint32 &aggregate_time, halthandle_t &next_transfer) const;
+
+			void rdwr(loadsave_t *file);
 		};
 
 		// structure used for storing indices of halts connected to a transfer, grouped by transport
@@ -271,15 +345,18 @@ private:
 		// store the start time of refresh
 		sint64 refresh_start_time;
 
-		// set of variables for finished path data
-		path_element_t **finished_matrix;
+		// set of variables for finished path data; paths are either in the matrix or in the hub labels
+		path_matrix_t *finished_matrix;
+		hub_labels_t *finished_labels;
 		uint16 *finished_halt_index_map;
 		uint16 finished_halt_count;
 
 		// set of variables for working path data
-		path_element_t **working_matrix;
-		uint16 *transport_index_map;
-		transport_element_t **transport_matrix;
+		path_matrix_t *working_matrix;
+		hub_labels_t *working_labels;
+		uint16 *transport_index_map;	// indexed by line id, or by transport_convoy_offset + convoy id for lineless convoys
+		uint32 transport_convoy_offset;
+		uint32 transport_index_map_size;
 		uint16 *working_halt_index_map;
 		halthandle_t *working_halt_list;
 		uint16 working_halt_count;
@@ -309,12 +386,36 @@ private:
 		// phase indicator
 		uint8 current_phase;
 
+		// whether the current refresh explores paths in blocked mode; latched when a refresh starts
+		bool blocked_search;
+
+		// ids of halts whose connexions are affected by the changes requested since the last refresh started,
+		// if the requested refresh may repair the finished paths rather than explore all paths again
+		vector_tpl<uint16> changed_halts;
+		bool refresh_incremental;
+
+		// whether the current refresh repairs the finished paths; latched when a refresh starts
+		// and dropped when path exploration starts if a full exploration would not be much slower
+		bool incremental_search;
+		vector_tpl<uint16> incremental_halts;	// ids of the halts affected by the changes
+		vector_tpl<uint16> incremental_vias;	// matrix indices of the affected transfers
+		vector_tpl<uint16> incremental_rows;	// matrix indices of the rows to be explored again
+
+		// whether the current refresh builds hub labels instead of the path matrix; latched when the matrix would be built
+		bool hub_label_search;
+
 		// phase counters
 		uint16 phase_counter;
 		uint32 iterations;
 		uint32 total_iterations; // for desync debug only
 
 		// phase counters for path searching
+		// in blocked mode : via_index is the first transfer of the current block, origin_cluster_index the stage
+		// within that block, origin_member_index the first row of the current row tile and target_cluster_index
+		// the first column of the current column tile
+		// in incremental mode : phase_counter is the stage; while seeding, origin_cluster_index is the pass and
+		// origin_member_index the next target, and afterwards the counters are used as in blocked mode
+		// in hub label mode : origin_member_index is the rank of the next hub
 		uint16 via_index;
 		uint32 origin_cluster_index;
 		uint32 target_cluster_index;
@@ -329,12 +430,17 @@ private:
 		uint32 statistic_duration;
 		uint32 statistic_iteration;
 
+		// iteration limits in effect for this compartment's current step, and the limits projected from its statistics
+		// when a phase has finished (zero : none); the shared limits are only read and adjusted outside of step_phase()
+		limit_set_t step_limits;
+		limit_set_t projected_limits;
+
 		// an array of names for the various phases
 		static const char *const phase_name[];
 
 protected:
 		// an array for keeping a list of connexion hash table
-		static connexion_list_entry_t connexion_list[65536];
+		static connexion_list_entry_t connexion_list[HALT_ID_RANGE];
 
 private:
 
@@ -379,6 +485,11 @@ private:
 		static const uint8 phase_explore_paths = 5;
 		static const uint8 phase_reroute_goods = 6;
 
+		// stages of incremental path search
+		static const uint8 incremental_stage_seed = 0;
+		static const uint8 incremental_stage_rows = 1;
+		static const uint8 incremental_stage_vias = 2;
+
 		// absolute time limits
 		// The higher this number, the more processing will be done per step and the more quickly that a refresh will complete, but the more computationally intensive that it will be.
 		// Knightly's original setting was 24. The revised setting was 64.
@@ -394,9 +505,28 @@ private:
 		static const uint32 percent_lower_limit = 100 - percent_deviation;
 		static const uint32 percent_upper_limit = 100 + percent_deviation;
 
-		void enumerate_all_paths(const path_element_t *const *const matrix, const halthandle_t *const halt_list,
+		// Floyd-Warshall through the listed transfers, tiled to suit the cache, for the listed rows or all rows if row_list
+		// is NULL; returns false if interrupted by the iteration limit
+		bool explore_paths_blocked(uint64 &iterations_processed, const uint16 *const vias, const uint16 vias_count,
+								   const uint16 *const row_list, const uint16 row_count);
+
+		// copy the finished paths which do not pass through the changed halts into the working matrix, and list
+		// the rows and transfers to be explored again; drops the incremental search if a full exploration should be
+		// done instead. Returns false if interrupted by the iteration limit
+		bool seed_incremental_search(uint64 &iterations_processed);
+
+		// repair the paths affected by the changed halts; returns false if interrupted by the iteration limit
+		bool explore_paths_incremental(uint64 &iterations_processed);
+
+		// build the hub labels, one hub at a time; returns false if interrupted by the iteration limit
+		bool explore_paths_hub_labels(uint64 &iterations_processed);
+
+		void enumerate_all_paths(const path_matrix_t *const matrix, const halthandle_t *const halt_list,
 								 const uint16 *const halt_map, const uint16 halt_count);
 
+		// set a shared limit to the projected iterations, if they differ enough from it
+		template<typename T> static void adjust_limit(const T projected_iterations, T &local_limit, T &limit);
+
 	public:
 
 		compartment_t();
@@ -412,6 +542,15 @@ private:
 		void step();
 		void reset(const bool reset_finished_set);
 
+		// step() in parts, for compartments which are stepped concurrently : take_limits() and adjust_limits()
+		// read and write the shared iteration limits, so only step_phase() may run on the worker threads
+		void take_limits();
+		void step_phase();
+		void adjust_limits();
+
+		// whether the compartment is in a phase which only uses its own data, and thus can be stepped concurrently with others
+		bool is_in_parallel_phase() const { return current_phase == phase_fill_matrix || current_phase == phase_explore_paths; }
+
 		bool are_paths_available() const { return paths_available; }
 		bool is_refresh_completed() const { return refresh_completed; }
 		bool is_refresh_requested() const { return refresh_requested; }
@@ -426,7 +565,8 @@ private:
 
 		void set_category(uint8 category);
 		void set_class(uint8 value);
-		void set_refresh() { refresh_requested = true; }
+		// request a refresh; if the halts affected by the change are given, the paths may be repaired incrementally
+		void set_refresh(const vector_tpl<halthandle_t> *const affected_halts = NULL);
 
 		bool get_path_between(const halthandle_t origin_halt, const halthandle_t target_halt,
 							  uint32 &aggregate_time, halthandle_t &next_transfer);
@@ -498,6 +638,11 @@ private:
 	static uint8 current_compartment_class;
 	static bool processing;
 
+	// compartments to be stepped concurrently in the current step, in compartment order
+	static vector_tpl<compartment_t *> parallel_compartments;
+
+	static void step_parallel();
+
 public:
 #ifdef MULTI_THREAD
 	static thread_local bool allow_path_explorer_on_this_thread;
@@ -508,10 +653,14 @@ public:
 	static void step();
 	static void next_compartment();
 
+	// step this thread's share of the compartments which are processed concurrently
+	static void step_parallel_compartments(const uint32 thread_number, const uint32 thread_count);
+
 	static void full_instant_refresh();
 	static void refresh_all_categories(const bool reset_working_set);
-	static void refresh_category(const uint8 category);
-	static void refresh_class_category(const uint8 category, const uint8 g_class);
+	// affected_halts : halts whose connexions are changed, or NULL if the change is not confined to some halts
+	static void refresh_category(const uint8 category, const vector_tpl<halthandle_t> *const affected_halts = NULL);
+	static void refresh_class_category(const uint8 category, const uint8 g_class, const vector_tpl<halthandle_t> *const affected_halts = NULL);
 	static bool get_catg_path_between(const uint8 category, const halthandle_t origin_halt, const halthandle_t target_halt,
 									  uint32 &aggregate_time, halthandle_t &next_transfer, uint8 g_class = 0)
 	{
@@ -628,6 +628,16 @@ bool player_t::check_owner( const player_t *owner, const player_t *test )
 	return owner == test || owner == NULL || (test != NULL  &&  test->is_public_service());
 }
 
+
+void player_t::set_allow_access_to(uint8 other_player_nr, bool allow)
+{
+	if(  access[other_player_nr] != allow  ) {
+		access[other_player_nr] = allow;
+		// vehicles of the other player may now use different ways
+		route_t::invalidate_route_cache(any_wt);
+	}
+}
+
 void player_t::begin_liquidation()
 {
 	// Lock the player
@@ -1417,6 +1427,7 @@ void player_t::take_over(player_t* target_player)
 								{
 									sign->set_ticks_offset((uint8)mask);
 								}
+								route_t::invalidate_route_cache(sign->get_desc()->get_wtyp());
 							}
 						}
 					}
@@ -223,6 +223,12 @@ void export_city(HSQUIRRELVM vm)
 	 */
 	register_method(vm, &stadt_t::get_pos,         "get_pos");
 
+	/**
+	 * Position of the road in front of the town-hall, where the private cars travelling to this city go.
+	 * @returns road position
+	 */
+	register_method(vm, &stadt_t::get_townhall_road, "get_townhall_road");
+
 	/**
 	 * City limits.
 	 *
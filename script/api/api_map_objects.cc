@@ -434,6 +434,12 @@ bool field_is_deleteable(field_t* f)
 }
 
 
+koord3d way_get_next_on_private_car_route_to(weg_t* weg, koord destination)
+{
+	return weg->get_next_on_private_car_route_to(destination);
+}
+
+
 vector_tpl<sint64> const& get_way_stat(weg_t* weg, sint32 INDEX)
 {
 	static vector_tpl<sint64> v;
@@ -677,6 +683,12 @@ void export_map_objects(HSQUIRRELVM vm)
 	 * @returns array, index [0] corresponds to current month
 	 */
 	register_method_fv(vm, &get_way_stat, "get_convoys_passed",    freevariable<sint32>(WAY_STAT_CONVOIS), true);
+	/**
+	 * Next tile on the route of private cars from this road to a destination.
+	 * @param destination the town-hall road of a city, or the position of a factory or attraction
+	 * @returns the position of the next tile, invalid if there is no route or this is the destination
+	 */
+	register_method(vm, &way_get_next_on_private_car_route_to, "get_next_on_private_car_route_to", true);
 	end_class(vm);
 
 
@@ -11,6 +11,7 @@
 #include "api_simple.h"
 #include "../api_class.h"
 #include "../api_function.h"
+#include "../../dataobj/route.h"
 #include "../../dataobj/settings.h"
 #include "../../simmenu.h"
 #include "../../simworld.h"
@@ -33,6 +34,14 @@ call_tool_init set_traffic_level(settings_t*, sint16 rate)
 }
 
 
+void set_bidirectional_route_min_distance(settings_t* settings, uint16 distance)
+{
+	settings->set_bidirectional_route_min_distance(distance);
+	// cached routes may have been found by the other search
+	route_t::invalidate_route_cache(any_wt);
+}
+
+
 void export_settings(HSQUIRRELVM vm)
 {
 	/**
@@ -71,6 +80,19 @@ void export_settings(HSQUIRRELVM vm)
 	 */
 	register_local_method(vm, get_start_time, "get_start_time");
 
+	/**
+	 * Vehicle routes between tiles at least this far apart are searched from both ends at once.
+	 * @returns distance in tiles, zero if routes are only searched from their start
+	 */
+	register_method(vm, &settings_t::get_bidirectional_route_min_distance, "get_bidirectional_route_min_distance");
+
+	/**
+	 * Search vehicle routes between tiles at least @p distance tiles apart from both ends at once.
+	 * @param distance in tiles, zero to search routes only from their start
+	 * @warning cannot be used in network games.
+	 */
+	register_method(vm, &set_bidirectional_route_min_distance, "set_bidirectional_route_min_distance", true);
+
 	/// @returns station coverage
 	register_method(vm, &settings_t::get_station_coverage, "get_station_coverage");
 // 	/// @returns passenger factors influences passenger generation in cities
@@ -7,6 +7,7 @@
 
 /** @file api_tiles.cc exports tile related functions. */
 
+#include "api_obj_desc_base.h"
 #include "api_simple.h"
 #include "get_next.h"
 #include "../api_class.h"
@@ -16,6 +17,8 @@
 #include "../../boden/wasser.h"
 
 #include "../../simconvoi.h"
+#include "../../bauer/vehikelbauer.h"
+#include "../../dataobj/route.h"
 #include "../../vehicle/vehicle.h"
 
 namespace script_api {
@@ -130,6 +133,23 @@ vector_tpl<convoihandle_t> const get_convoy_list(grund_t* gr)
 	return list;
 }
 
+vector_tpl<koord3d> const tile_find_route(grund_t *gr, grund_t *target, const vehicle_desc_t *desc, player_t *player)
+{
+	static vector_tpl<koord3d> list;
+	list.clear();
+
+	if(  gr  &&  target  &&  desc  &&  player  ) {
+		vehicle_t *test_driver = vehicle_builder_t::build(gr->get_pos(), player, NULL, desc);
+		test_driver->set_flag(obj_t::not_on_map);
+		route_t route;
+		if(  route.calc_route(welt, gr->get_pos(), target->get_pos(), test_driver, speed_to_kmh(desc->get_topspeed()), desc->get_axle_load(), false, 0)  ==  route_t::valid_route  ) {
+			list = route.get_route();
+		}
+		delete test_driver;
+	}
+	return list;
+}
+
 void export_tiles(HSQUIRRELVM vm)
 {
 	/**
@@ -309,6 +329,15 @@ void export_tiles(HSQUIRRELVM vm)
 	 */
 	register_method(vm, &get_convoy_list, "get_convoys", true);
 
+	/**
+	 * Searches the route of a vehicle from this tile to @p target, as convoys do.
+	 * @param target tile where the route ends
+	 * @param desc vehicle type, which determines the way type, the speed and the axle load
+	 * @param pl owner of the vehicle
+	 * @returns the tiles of the route, an empty array if there is no route
+	 */
+	register_method(vm, &tile_find_route, "find_route", true);
+
 #ifdef SQAPI_DOC // document members
 	/**
 	 * List to iterate through all objects on this tile.
@@ -170,6 +170,14 @@ void export_world(HSQUIRRELVM vm, bool scenario)
 		* @returns whether operation was successful
 		*/
 		STATIC register_method(vm, &world_remove_player, "remove_player", true);
+
+		/**
+		 * Checks the private car routes of all cities at once, and lets the private cars use them.
+		 * Usually, this is done for a few cities in each step.
+		 * @param threaded whether the cities are checked by several threads at once, if the game has threads
+		 * @ingroup scen_only
+		 */
+		STATIC register_method(vm, &karte_t::check_all_private_car_routes, "check_private_car_routes");
 	}
 	/**
 	 * Returns player number @p pl. If player does not exist, returns null.
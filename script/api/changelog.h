@@ -12,6 +12,9 @@
  * - Added @ref change_climate_at
  * - Added @ref convoy_x::change_schedule
  * - Changed building_desc_x::get_available_stations to accept wt_all
+ * - Added @ref tile_x::find_route
+ * - Added @ref settings::get_bidirectional_route_min_distance, @ref settings::set_bidirectional_route_min_distance
+ * - Added @ref world::check_private_car_routes, @ref city_x::get_townhall_road, @ref way_x::get_next_on_private_car_route_to
  *
  * @section api-123 Release 123.0
  *
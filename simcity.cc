@@ -1595,13 +1595,14 @@ void stadt_t::reset_city_borders()
 
 stadt_t::~stadt_t()
 {
+	// before anything is removed, as the private car route threads may still be checking this city
+	welt->remove_queued_city(this);
+
 	// close info win
 	destroy_win((ptrdiff_t)this);
 
 	check_city_tiles(true);
 
-	welt->remove_queued_city(this);
-
 	// Remove references to this city from factories.
 	for(fabrik_t* factory : city_factories)
 	{
@@ -1695,16 +1696,8 @@ stadt_t::stadt_t(player_t* player, koord pos, sint32 citizens) :
 	lo = ur = pos;
 
 	// initialize history array
-	for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
-		for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_year[year][hist_type] = 0;
-		}
-	}
-	for (uint month = 0; month < MAX_CITY_HISTORY_YEARS; month++) {
-		for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_month[month][hist_type] = 0;
-		}
-	}
+	city_history_year.clear();
+	city_history_month.clear();
 
 	/* get a unique cityname */
 	char                          const* n       = "simcity";
@@ -2673,14 +2666,10 @@ void stadt_t::step(uint32 delta_t)
 void stadt_t::roll_history()
 {
 	// roll months
-	for (int i = MAX_CITY_HISTORY_MONTHS - 1; i > 0; i--) {
-		for (int hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_month[i][hist_type] = city_history_month[i - 1][hist_type];
-		}
-	}
-	// init this month
-	for (int hist_type = HIST_GROWTH; hist_type < MAX_CITY_HISTORY; hist_type++) {
-		city_history_month[0][hist_type] = 0;
+	city_history_month.roll();
+	// init this month: the totals before HIST_GROWTH carry over
+	for (int hist_type = 0; hist_type < HIST_GROWTH; hist_type++) {
+		city_history_month[0][hist_type] = city_history_month[1][hist_type];
 	}
 
 	city_history_month[0][HIST_BUILDING] = buildings.get_count();
@@ -2698,17 +2687,11 @@ void stadt_t::roll_history()
 	// need to roll year too?
 	if (welt->get_last_month() == 0)
 	{
-		for (int i = MAX_CITY_HISTORY_YEARS - 1; i > 0; i--)
-		{
-			for (int hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++)
-			{
-				city_history_year[i][hist_type] = city_history_year[i - 1][hist_type];
-			}
-		}
+		city_history_year.roll();
 		// init this year
-		for (int hist_type = HIST_GROWTH; hist_type < MAX_CITY_HISTORY; hist_type++)
+		for (int hist_type = 0; hist_type < HIST_GROWTH; hist_type++)
 		{
-			city_history_year[0][hist_type] = 0;
+			city_history_year[0][hist_type] = city_history_year[1][hist_type];
 		}
 		city_history_year[0][HIST_BUILDING] = buildings.get_count();
 		city_history_year[0][HIST_GOODS_NEEDED] = 0;
@@ -2975,7 +2958,7 @@ void stadt_t::calc_growth()
 void stadt_t::city_growth_get_factors(city_growth_factor_t(&factors)[GROWTH_FACTOR_NUMBER], uint32 const month) const
 {
 	// optimize view of history for convenience
-	sint64 const (&h)[MAX_CITY_HISTORY] = city_history_month[month];
+	sint64 const *const h = city_history_month[month];
 
 	// go through each index one at a time
 	uint32 index = 0;
@@ -17,6 +17,7 @@
 #include "tpl/array2d_tpl.h"
 #include "tpl/slist_tpl.h"
 #include "tpl/koordhashtable_tpl.h"
+#include "tpl/history_tpl.h"
 
 #include "vehicle/simroadtraffic.h"
 #include "tpl/sparse_tpl.h"
@@ -205,8 +206,8 @@ private:
 	* City history
 	* Current month stats are not appropiate to determine satisfaction for growth.
 	*/
-	sint64 city_history_year[MAX_CITY_HISTORY_YEARS][MAX_CITY_HISTORY];
-	sint64 city_history_month[MAX_CITY_HISTORY_MONTHS][MAX_CITY_HISTORY];
+	history_tpl<sint64, MAX_CITY_HISTORY_YEARS, MAX_CITY_HISTORY> city_history_year;
+	history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> city_history_month;
 
 	/* updates the city history
 	*/
@@ -278,10 +279,10 @@ public:
 	void add_building_to_list(gebaeude_t* building, bool ordered = false, bool do_not_add_to_world_list = false, bool do_not_update_stats = false);
 
 	/**
-	 * Returns pointer to history for city
+	 * Returns history for city
 	 */
-	sint64* get_city_history_year() { return *city_history_year; }
-	sint64* get_city_history_month() { return *city_history_month; }
+	const history_tpl<sint64, MAX_CITY_HISTORY_YEARS, MAX_CITY_HISTORY> &get_city_history_year() const { return city_history_year; }
+	const history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> &get_city_history_month() const { return city_history_month; }
 
 	uint32 stadtinfo_options;
 
@@ -78,7 +78,7 @@
 static pthread_mutex_t step_convois_mutex = PTHREAD_MUTEX_INITIALIZER;
 static vector_tpl<pthread_t> unreserve_threads;
 waytype_t convoi_t::current_waytype = road_wt;
-uint16 convoi_t::current_unreserver = 0;
+quickstone_id_t convoi_t::current_unreserver = 0;
 #endif
 
 //#if _MSC_VER
@@ -2546,14 +2546,7 @@ void convoi_t::new_month()
 	}
 
 	// everything normal: update history
-	for (int j = 0; j<MAX_CONVOI_COST; j++)
-	{
-		for (int k = MAX_MONTHS-1; k>0; k--)
-		{
-			financial_history[k][j] = financial_history[k-1][j];
-		}
-		financial_history[0][j] = 0;
-	}
+	financial_history.roll();
 
 	// Deduct monthly fixed maintenance costs.
 	// @author: jamespetts
@@ -3942,8 +3935,8 @@ void convoi_t::set_working_method(working_method_t value)
 void convoi_t::rdwr_convoihandle_t(loadsave_t *file, convoihandle_t &cnv)
 {
 	if(  file->is_version_atleast(112, 3)  ) {
-		uint16 id = (file->is_saving()  &&  cnv.is_bound()) ? cnv.get_id() : 0;
-		file->rdwr_short( id );
+		quickstone_id_t id = (file->is_saving()  &&  cnv.is_bound()) ? cnv.get_id() : 0;
+		file->rdwr_handle_id( id );
 		if (file->is_loading()) {
 			cnv.set_id( id );
 		}
@@ -3984,14 +3977,14 @@ void convoi_t::rdwr(loadsave_t *file)
 			self = convoihandle_t( this );
 		}
 		else {
-			uint16 id;
-			file->rdwr_short( id );
+			quickstone_id_t id;
+			file->rdwr_handle_id( id );
 			self = convoihandle_t( this, id );
 		}
 	}
 	else if(  file->is_version_atleast(112, 3)  ) {
-		uint16 id = self.get_id();
-		file->rdwr_short( id );
+		quickstone_id_t id = self.get_id();
+		file->rdwr_handle_id( id );
 	}
 
 	dummy = vehicle_count;
@@ -6382,11 +6375,7 @@ void convoi_t::book(sint64 amount, convoi_cost_t cost_type)
 
 void convoi_t::init_financial_history()
 {
-	for (int j = 0; j<MAX_CONVOI_COST; j++) {
-		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][j] = 0;
-		}
-	}
+	financial_history.clear();
 }
 
 
@@ -7831,7 +7820,7 @@ uint32 convoi_t::calc_reverse_delay() const
 			 {
 				 if (iter.get_last_transfer().get_id() == halt.get_id())
 				 {
-					 waiting_minutes = max(get_waiting_minutes(current_time - iter.arrival_time), airport_wait);
+					 waiting_minutes = max(get_waiting_minutes(iter.get_waiting_ticks(current_time)), airport_wait);
 					 // Only times of one minute or larger are registered, to avoid registering zero wait-time when a passenger
 					 // alights a convoy and then immediately re-boards that same convoy.
 					 if (waiting_minutes > 0)
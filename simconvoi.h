@@ -23,6 +23,7 @@
 #include "tpl/koordhashtable_tpl.h"
 #include "tpl/inthashtable_tpl.h"
 #include "tpl/minivec_tpl.h"
+#include "tpl/history_tpl.h"
 
 #include "convoihandle_t.h"
 #include "halthandle_t.h"
@@ -515,7 +516,7 @@ private:
 	/**
 	* struct holds new financial history for convoi
 	*/
-	sint64 financial_history[MAX_MONTHS][MAX_CONVOI_COST];
+	history_tpl<sint64, MAX_MONTHS, MAX_CONVOI_COST> financial_history;
 
 	/**
 	* initialize the financial history
@@ -790,7 +791,7 @@ private:
 	static void unreserve_route_range(route_range_specification range);
 	friend void *unreserve_route_threaded(void* args);
 	static waytype_t current_waytype;
-	static uint16 current_unreserver;
+	static quickstone_id_t current_unreserver;
 public:
 #endif
 
@@ -1007,6 +1008,7 @@ public:
 	 * all other stuff => convoi_t::step()
 	 */
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	sync_group_t get_sync_group() const OVERRIDE { return SYNC_GROUP_CONVOI; }
 
 	/**
 	 * All things like route search or loading, that may take a little
@@ -1253,9 +1255,9 @@ public:
 	void book(sint64 amount, convoi_cost_t cost_type);
 
 	/**
-	* return a pointer to the financial history
+	* return the financial history
 	*/
-	inline sint64* get_finance_history() { return *financial_history; }
+	inline const history_tpl<sint64, MAX_MONTHS, MAX_CONVOI_COST> &get_finance_history() const { return financial_history; }
 
 	/**
 	* return a specified element from the financial history
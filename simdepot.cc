@@ -74,11 +74,14 @@ depot_t::depot_t(koord3d pos, player_t *player, const building_tile_desc_t *t) :
 	command_pending = false;
 	strcpy(name, "unnamed");
 	add_to_world_list();
+	// trains cannot pass through the depots of other players (the waytype is not yet known here)
+	route_t::invalidate_route_cache(any_wt);
 }
 
 
 depot_t::~depot_t()
 {
+	route_t::invalidate_route_cache(any_wt);
 	destroy_win((ptrdiff_t)this);
 	all_depots.remove(this);
 	const grund_t* gr = welt->lookup(get_pos());
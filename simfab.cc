@@ -2964,7 +2964,7 @@ void fabrik_t::verteile_waren(const uint32 product)
 					ware_t ware(output[product].get_typ(), nearby_halt.halt);
 					ware.menge = menge;
 					ware.set_zielpos(consumer_pos);
-					ware.arrival_time = welt->get_ticks();
+					ware.set_arrival_time(welt->get_ticks());
 
 					uint32 w;
 					// find the index in the target factory
@@ -3052,7 +3052,7 @@ void fabrik_t::verteile_waren(const uint32 product)
 				if(  amount > most_waiting.menge  ) {
 					most_waiting.set_zielpos(consumer_pos);
 					most_waiting.menge = amount;
-					most_waiting.arrival_time = welt->get_ticks();
+					most_waiting.set_arrival_time(welt->get_ticks());
 				}
 			}
 
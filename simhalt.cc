@@ -77,6 +77,33 @@ uint8 haltestelle_t::reconnect_counter = 0;
 // controls the halt iterator in step_all():
 static bool restart_halt_iterator = true;
 
+// halts from index month_rollover_next up to month_rollover_end have not yet been rolled over into the current month
+static uint32 month_rollover_next = 0;
+static uint32 month_rollover_end = 0;
+
+
+void haltestelle_t::start_month_rollover()
+{
+	month_rollover_next = 0;
+	month_rollover_end = alle_haltestellen.get_count();
+}
+
+
+uint32 haltestelle_t::get_month_rollover_pending()
+{
+	return month_rollover_end - month_rollover_next;
+}
+
+
+void haltestelle_t::step_month_rollover(uint32 count)
+{
+	const uint32 end = count < get_month_rollover_pending() ? month_rollover_next + count : month_rollover_end;
+	while(  month_rollover_next < end  ) {
+		alle_haltestellen[month_rollover_next++]->new_month();
+		INT_CHECK("simhalt 1877");
+	}
+}
+
 void haltestelle_t::step_all()
 {
 	const uint32 count = alle_haltestellen.get_count();
@@ -391,6 +418,7 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 	const uint8 max_classes = max(goods_manager_t::passengers->get_number_of_classes(), goods_manager_t::mail->get_number_of_classes());
 
 	cargo = (vector_tpl<ware_t> **)calloc( max_categories, sizeof(vector_tpl<ware_t> *) );
+	waiting_sums = (waiting_sums_t **)calloc( max_categories, sizeof(waiting_sums_t *) );
 
 	non_identical_schedules.set_count(max_categories * max_classes);
 	// CHECK: Do we need the below in light of the above? Does the above auto-initialise the values to zero?
@@ -468,6 +496,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	const uint8 max_classes = max(goods_manager_t::passengers->get_number_of_classes(), goods_manager_t::mail->get_number_of_classes());
 
 	cargo = (vector_tpl<ware_t> **)calloc( max_categories, sizeof(vector_tpl<ware_t> *) );
+	waiting_sums = (waiting_sums_t **)calloc( max_categories, sizeof(waiting_sums_t *) );
 
 	non_identical_schedules.set_count(max_categories * max_classes);
 	// CHECK: Do we need the below in light of the above? Does the above auto-initialise the values to zero?
@@ -538,7 +567,15 @@ haltestelle_t::~haltestelle_t()
 
 	// first: remove halt from all lists
 	int i=0;
-	while(alle_haltestellen.remove(self)) {
+	for(  uint32 index = alle_haltestellen.index_of(self);  index != 0xFFFFFFFFu;  index = alle_haltestellen.index_of(self)  ) {
+		alle_haltestellen.remove_at(index);
+		// keep the halts not yet rolled over in place
+		if(  index < month_rollover_end  ) {
+			month_rollover_end--;
+			if(  index < month_rollover_next  ) {
+				month_rollover_next--;
+			}
+		}
 		i++;
 	}
 	if (i != 1) {
@@ -647,8 +684,10 @@ haltestelle_t::~haltestelle_t()
 			delete cargo[i];
 			cargo[i] = NULL;
 		}
+		delete waiting_sums[i];
 	}
 	free(cargo);
+	free(waiting_sums);
 
 #ifdef MULTI_THREAD
 	welt->await_path_explorer();
@@ -701,6 +740,7 @@ void haltestelle_t::rotate90( const sint16 y_size )
 					warray.remove_at(j);
 				}
 			}
+			recount_waiting(i);
 		}
 	}
 
@@ -1318,6 +1358,7 @@ void haltestelle_t::step()
 				{
 					// The goods/passengers leave.  We must record the lower "in transit" count on factories.
 					fabrik_t::update_transit(tmp, false);
+					remove_waiting(tmp, tmp.menge);
 					tmp.menge = 0;
 
 					// No need to record waiting times if the goods are discarded because their destination
@@ -1325,7 +1366,8 @@ void haltestelle_t::step()
 					continue;
 				}
 
-				uint32 waiting_tenths = convoi_t::get_waiting_minutes(welt->get_ticks() - tmp.arrival_time);
+				tmp.limit_waiting_ticks(welt->get_ticks());
+				uint32 waiting_tenths = convoi_t::get_waiting_minutes(tmp.get_waiting_ticks(welt->get_ticks()));
 
 				// Checks to see whether the freight has been waiting too long.
 				// If so, discard it.
@@ -1434,6 +1476,7 @@ void haltestelle_t::step()
 
 						// The goods/passengers leave.  We must record the lower "in transit" count on factories.
 						fabrik_t::update_transit(tmp, false);
+						remove_waiting(tmp, tmp.menge);
 						tmp.menge = 0;
 
 						// Normally we record long waits below, but we just did, so don't do it twice.
@@ -1520,12 +1563,7 @@ void haltestelle_t::new_month()
 	check_nearby_halts();
 
 	// roll financial history
-	for (int j = 0; j<MAX_HALT_COST; j++) {
-		for (int k = MAX_MONTHS-1; k>0; k--) {
-			financial_history[k][j] = financial_history[k-1][j];
-		}
-		financial_history[0][j] = 0;
-	}
+	financial_history.roll();
 	// number of waitung should be constant ...
 	financial_history[0][HALT_WAITING] = financial_history[1][HALT_WAITING];
 }
@@ -1634,7 +1672,7 @@ uint32 haltestelle_t::reroute_goods(const uint8 catg)
 		cargo[catg] = new_warray;
 
 		// likely the display must be updated after this
-		resort_freight_info = true;
+		recount_waiting(catg);
 
 		return packet_count;
 	}
@@ -2035,11 +2073,22 @@ void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec
 
 	if(sched && player)
 	{
+		// only the connexions of the halts in this schedule change, so the path explorer may just repair their paths
+		vector_tpl<halthandle_t> affected_halts(sched->get_count());
+		FOR(minivec_tpl<schedule_entry_t>, const& entry, sched->entries)
+		{
+			tmp_halt = haltestelle_t::get_halt(entry.pos, player);
+			if(tmp_halt.is_bound())
+			{
+				affected_halts.append_unique(tmp_halt);
+			}
+		}
+
 		const uint8 catg_count = categories.get_count();
 
 		for (uint8 i = 0; i < catg_count; i++)
 		{
-			path_explorer_t::refresh_category(categories[i]);
+			path_explorer_t::refresh_category(categories[i], &affected_halts);
 		}
 
 		if ((passenger_classes != NULL) && categories.is_contained(goods_manager_t::INDEX_PAS))
@@ -2047,7 +2096,7 @@ void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec
 			// These minivecs should only have anything in them if their respective categories have not been refreshed entirely.
 			FOR(minivec_tpl<uint8>, const & g_class, *passenger_classes)
 			{
-				path_explorer_t::refresh_class_category(goods_manager_t::INDEX_PAS, g_class);
+				path_explorer_t::refresh_class_category(goods_manager_t::INDEX_PAS, g_class, &affected_halts);
 			}
 		}
 
@@ -2056,7 +2105,7 @@ void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec
 			// These minivecs should only have anything in them if their respective categories have not been refreshed entirely.
 			FOR(minivec_tpl<uint8>, const & g_class, *mail_classes)
 			{
-				path_explorer_t::refresh_class_category(goods_manager_t::INDEX_MAIL, g_class);
+				path_explorer_t::refresh_class_category(goods_manager_t::INDEX_MAIL, g_class, &affected_halts);
 			}
 		}
 	}
@@ -2398,11 +2447,13 @@ bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 			// not too much?
 			if(tmp.menge > menge) {
 				// not all can be loaded
+				remove_waiting(tmp, menge);
 				tmp.menge -= menge;
 				w.menge = menge;
 			}
 			else {
 				// leave an empty entry => joining will more often work
+				remove_waiting(tmp, tmp.menge);
 				w.menge = tmp.menge;
 				tmp.menge = 0;
 			}
@@ -2410,7 +2461,6 @@ bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 			book(w.menge*w.get_desc()->get_weight_per_unit()/10, HALT_GOODS_HANDLING_VOLUME);
 
 			fabrik_t::update_transit( w, false );
-			resort_freight_info = true;
 			return true;
 		}
 	}
@@ -2419,6 +2469,47 @@ bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 }
 
 
+void haltestelle_t::get_stops_until_return(const schedule_t *schedule, const player_t *player, const convoi_t *cnv, vector_tpl<halthandle_t> &stops) const
+{
+	uint8 index = schedule->get_current_stop();
+	bool reverse = cnv->get_reverse_schedule();
+	if(cnv->get_state() != convoi_t::REVERSING)
+	{
+		schedule->increment_index(&index, &reverse);
+	}
+
+	int count = 0;
+	while(index != schedule->get_current_stop() || (cnv->get_state() == convoi_t::REVERSING && count == 0))
+	{
+		const halthandle_t schedule_halt = haltestelle_t::get_halt(schedule->entries[index].pos, player);
+
+		if(schedule_halt == self)
+		{
+			// The convoy returns here later, so do not load goods/passengers just to go on a detour.
+			if(count == 0)
+			{
+				// However, this makes no sense if we start with where we are now.
+				schedule->increment_index(&index, &reverse);
+				continue;
+			}
+			break;
+		}
+
+		count ++;
+		stops.append(schedule_halt);
+
+		// if the schedule is mirrored and has reached its end, break
+		// as the convoy will be returning this way later.
+		if(schedule->is_mirrored() && (index == 0 || index == (schedule->get_count() - 1)))
+		{
+			break;
+		}
+
+		schedule->increment_index(&index, &reverse);
+	}
+}
+
+
 bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *good_category, sint32 requested_amount, const schedule_t *schedule, const player_t *player, convoi_t* cnv, bool overcrowded, const uint8 g_class, const bool use_lower_classes, bool& other_classes_available, const bool mixed_load_prohibition, uint8 goods_restriction)
 {
 	bool skipped = false;
@@ -2426,6 +2517,19 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 	vector_tpl<ware_t> *warray = cargo[catg_index];
 	if(warray && warray->get_count() > 0)
 	{
+		vector_tpl<halthandle_t> stops(schedule->get_count());
+		get_stops_until_return(schedule, player, cnv, stops);
+
+		// Only packets bound for one of the stops can be loaded, so the others need not be sorted by waiting time at all.
+		vector_tpl<halthandle_t> served_halts(stops.get_count());
+		FOR(vector_tpl<halthandle_t>, const& stop, stops)
+		{
+			if(stop.is_bound() && stop->is_enabled(catg_index))
+			{
+				served_halts.append_unique(stop);
+			}
+		}
+
 		binary_heap_tpl<ware_t*> goods_to_check;
 		for(uint32 i = 0;  i < warray->get_count();  )
 		{
@@ -2443,7 +2547,8 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					// we ALSO cannot load passengers or mail of a higher class into lower class accomodation.
 					// This fixes a bug where priority mail would load into a normal mail vehicle in the front even if
 					// there was a priority mail vehicle later in the consist (and similarly for passengers).
-					if(  use_lower_classes || ware->get_class() == g_class  )
+					if(  (use_lower_classes || ware->get_class() == g_class)  &&
+						(served_halts.is_contained(ware->get_zwischenziel()) || served_halts.is_contained(ware->get_ziel()))  )
 					{
 						goods_to_check.insert(ware);
 					}
@@ -2461,45 +2566,12 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 			}
 		}
 
-		halthandle_t cached_halts[256];
-
 
 		while(!goods_to_check.empty())
 		{
 			ware_t* const next_to_load = goods_to_check.pop();
-			uint8 index = schedule->get_current_stop();
-			bool reverse = cnv->get_reverse_schedule();
-			if(cnv->get_state() != convoi_t::REVERSING)
-			{
-				schedule->increment_index(&index, &reverse);
-			}
-
-			int count = 0;
-			while(index != schedule->get_current_stop() || (cnv->get_state() == convoi_t::REVERSING && count == 0))
+			FOR(vector_tpl<halthandle_t>, const& schedule_halt, stops)
 			{
-				halthandle_t& schedule_halt = cached_halts[index];
-				if(schedule_halt.is_null())
-				{
-					schedule_halt = haltestelle_t::get_halt(schedule->entries[index].pos, player);
-				}
-
-				if(schedule_halt == self)
-				{
-					// The convoy returns here later, so do not load goods/passengers just to go on a detour.
-					if(count == 0)
-					{
-						// However, this makes no sense if we start with where we are now.
-						schedule->increment_index(&index, &reverse);
-						continue;
-					}
-					else
-					{
-						break;
-					}
-				}
-
-				count ++;
-
 				const halthandle_t next_transfer = next_to_load->get_zwischenziel();
 				const halthandle_t destination = next_to_load->get_ziel();
 
@@ -2674,7 +2746,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 
 						if(wait_for_faster_convoy)
 						{
-							schedule->increment_index(&index, &reverse);
 							skipped = true;
 							continue;
 						}
@@ -2688,7 +2759,9 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					{
 						// The direct route is faster than the planned route:
 						// update the next transfer to reflect this.
+						remove_waiting(*next_to_load, next_to_load->menge);
 						next_to_load->set_zwischenziel(destination);
+						add_waiting(*next_to_load, next_to_load->menge);
 					}
 
 					if (next_to_load->is_passenger() && next_to_load->g_class > 0 && cnv->get_classes_carried(goods_manager_t::INDEX_PAS)->get_count() > 1)
@@ -2727,7 +2800,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 						if (g_class != best_class)
 						{
 							// Wait for a better class of accommodation
-							schedule->increment_index(&index, &reverse);
 							other_classes_available = true;
 							continue;
 						}
@@ -2739,7 +2811,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 							goods_restriction = next_to_load->get_index();
 						}
 						if (next_to_load->get_index() != goods_restriction) {
-							schedule->increment_index(&index, &reverse);
 							continue;
 						}
 					}
@@ -2748,7 +2819,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					connexion * const next_connexion = get_connexions(catg_index, g_class)->get(check_halt);
 					if(next_connexion  &&  overcrowded  &&  next_connexion->alternative_seats)
 					{
-						schedule->increment_index(&index, &reverse);
 						skipped = true;
 						continue;
 					}
@@ -2767,6 +2837,7 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 						requested_amount -= next_to_load->menge;
 						next_to_load->menge = 0; // leave an empty entry => will be deleted next time for performance
 					}
+					remove_waiting(neu, neu.menge);
 					load.insert(neu);
 
 					if (neu.get_origin() == self) {
@@ -2788,8 +2859,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 						}
 					}
 
-					resort_freight_info = true;
-
 					if(requested_amount == 0)
 					{
 						goods_to_check.clear();
@@ -2797,15 +2866,6 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					}
 				}
 				// nothing there to load
-
-				// if the schedule is mirrored and has reached its end, break
-				// as the convoy will be returning this way later.
-				if(schedule->is_mirrored() && (index == 0 || index == (schedule->get_count() - 1)))
-				{
-					break;
-				}
-
-				schedule->increment_index(&index, &reverse);
 			}
 		}
 	}
@@ -2908,15 +2968,122 @@ sint64 haltestelle_t::get_overcrowded_proporion(uint8 typ) const
 	return (sint64)(waiting_amount_of_this_typ * 10ll / catg_capacity);
 }
 
-uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
+void haltestelle_t::add_waiting(const ware_t &ware, uint32 amount)
 {
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t const& i : *warray) {
-			if (wtyp->get_index() == i.get_index()) {
-				sum += i.menge;
+	resort_freight_info = true;
+	if(  amount == 0  ) {
+		return;
+	}
+	const uint8 catg_index = ware.get_desc()->get_catg_index();
+	if(  waiting_sums[catg_index] == NULL  ) {
+		waiting_sums[catg_index] = new waiting_sums_t();
+	}
+	waiting_sums_t &waiting = *waiting_sums[catg_index];
+
+	waiting_sum_t *entry = NULL;
+	for(waiting_sum_t & s : waiting.sums) {
+		if(  s.goods_index == ware.get_index()  &&  s.g_class == ware.get_class()  ) {
+			entry = &s;
+			break;
+		}
+	}
+	if(  entry == NULL  ) {
+		waiting_sum_t s;
+		s.goods_index = ware.get_index();
+		s.g_class = ware.get_class();
+		s.menge = 0;
+		s.commuters = 0;
+		waiting.sums.append(s);
+		entry = &waiting.sums.back();
+	}
+	entry->menge += amount;
+	if(  ware.is_commuting_trip  ) {
+		entry->commuters += amount;
+	}
+
+	const uint64 transfer_key = get_transfer_key(ware);
+	if(  waiting_transfer_t *transfer = waiting.by_transfer.access(transfer_key)  ) {
+		transfer->menge += amount;
+	}
+	else {
+		waiting_transfer_t t;
+		t.via = ware.get_zwischenziel();
+		t.goods_index = ware.get_index();
+		t.g_class = ware.get_class();
+		t.menge = amount;
+		waiting.by_transfer.put(transfer_key, t);
+	}
+
+	const uint64 destination_key = get_destination_key(ware.get_index(), ware.get_zielpos());
+	if(  uint32 *destination = waiting.by_destination.access(destination_key)  ) {
+		*destination += amount;
+	}
+	else {
+		waiting.by_destination.put(destination_key, amount);
+	}
+}
+
+
+void haltestelle_t::remove_waiting(const ware_t &ware, uint32 amount)
+{
+	resort_freight_info = true;
+	waiting_sums_t *waiting = waiting_sums[ware.get_desc()->get_catg_index()];
+	if(  amount == 0  ||  waiting == NULL  ) {
+		return;
+	}
+
+	for(waiting_sum_t & s : waiting->sums) {
+		if(  s.goods_index == ware.get_index()  &&  s.g_class == ware.get_class()  ) {
+			s.menge -= amount;
+			if(  ware.is_commuting_trip  ) {
+				s.commuters -= amount;
 			}
+			break;
+		}
+	}
+
+	// drop what no longer waits, as there are as many next transfers and destinations as packets at worst
+	const uint64 transfer_key = get_transfer_key(ware);
+	if(  waiting_transfer_t *transfer = waiting->by_transfer.access(transfer_key)  ) {
+		transfer->menge -= amount;
+		if(  transfer->menge == 0  ) {
+			waiting->by_transfer.remove(transfer_key);
+		}
+	}
+
+	const uint64 destination_key = get_destination_key(ware.get_index(), ware.get_zielpos());
+	if(  uint32 *destination = waiting->by_destination.access(destination_key)  ) {
+		*destination -= amount;
+		if(  *destination == 0  ) {
+			waiting->by_destination.remove(destination_key);
+		}
+	}
+}
+
+
+void haltestelle_t::recount_waiting(uint8 catg_index)
+{
+	resort_freight_info = true;
+	delete waiting_sums[catg_index];
+	waiting_sums[catg_index] = NULL;
+	if(  cargo[catg_index]  ) {
+		for(ware_t const& ware : *cargo[catg_index]) {
+			add_waiting(ware, ware.menge);
+		}
+	}
+}
+
+
+uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
+{
+	const waiting_sums_t *waiting = waiting_sums[wtyp->get_catg_index()];
+	if(  waiting == NULL  ) {
+		return 0;
+	}
+	uint32 sum = 0;
+	for(waiting_sum_t const& s : waiting->sums) {
+		if (wtyp->get_index() == s.goods_index) {
+			sum += s.menge;
 		}
 	}
 	return sum;
@@ -2927,33 +3094,35 @@ uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp, uint8 wealth_clas
 	if (wealth_class >= wtyp->get_number_of_classes()) {
 		return 0;
 	}
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if (warray != NULL) {
-		for(ware_t const& i : *warray) {
-			if (wtyp->get_index() == i.get_index() && wealth_class == i.get_class()
-				&& (!chk_only_commuter || (chk_only_commuter && wtyp == goods_manager_t::passengers && i.is_commuting_trip))) {
-				sum += i.menge;
-			}
+	if (chk_only_commuter && wtyp != goods_manager_t::passengers) {
+		return 0;
+	}
+	const waiting_sums_t *waiting = waiting_sums[wtyp->get_catg_index()];
+	if(  waiting == NULL  ) {
+		return 0;
+	}
+	for(waiting_sum_t const& s : waiting->sums) {
+		if (wtyp->get_index() == s.goods_index && wealth_class == s.g_class) {
+			return chk_only_commuter ? s.commuters : s.menge;
 		}
 	}
-	return sum;
+	return 0;
 }
 
 uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp, linehandle_t line, uint8 wealth_class) const
 {
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t const& i : *warray) {
-			if (wtyp->get_index() == i.get_index()) {
-				if (wealth_class !=255  &&  wealth_class != i.get_class()) {
+	uint32 sum = 0;
+	const waiting_sums_t *waiting = waiting_sums[wtyp->get_catg_index()];
+	if(waiting!=NULL) {
+		for(auto const& i : waiting->by_transfer) {
+			const waiting_transfer_t &t = i.value;
+			if (wtyp->get_index() == t.goods_index) {
+				if (wealth_class !=255  &&  wealth_class != t.g_class) {
 					continue;
 				}
-				halthandle_t const via_halt = i.get_zwischenziel();
-				if ( via_halt.is_bound() ) {
-					if(  line == get_preferred_line(via_halt, wtyp->get_catg_index(), goods_manager_t::get_classes_catg_index(wtyp->get_index())-1)  ) {
-						sum += i.menge;
+				if ( t.via.is_bound() ) {
+					if(  line == get_preferred_line(t.via, wtyp->get_catg_index(), goods_manager_t::get_classes_catg_index(wtyp->get_index())-1)  ) {
+						sum += t.menge;
 					}
 				}
 			}
@@ -2964,9 +3133,9 @@ uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp, linehandle_t line
 
 uint32 haltestelle_t::get_ware_summe_for(const goods_desc_t *wtyp, linehandle_t line, uint8 wealth_class, uint8 entry_start, uint8 entry_end) const
 {
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
+	uint32 sum = 0;
+	const waiting_sums_t *waiting = waiting_sums[wtyp->get_catg_index()];
+	if(waiting!=NULL) {
 		slist_tpl<halthandle_t> halt_list;
 		const schedule_t *schedule = line.is_bound() ? line->get_schedule() : NULL;
 		if (schedule != NULL) {
@@ -2983,15 +3152,15 @@ uint32 haltestelle_t::get_ware_summe_for(const goods_desc_t *wtyp, linehandle_t
 				}
 			}
 		}
-		FOR(vector_tpl<ware_t>, const& i, *warray) {
-			if (wtyp->get_index() == i.get_index()) {
-				if (wealth_class !=255  &&  wealth_class != i.get_class()) {
+		for(auto const& i : waiting->by_transfer) {
+			const waiting_transfer_t &t = i.value;
+			if (wtyp->get_index() == t.goods_index) {
+				if (wealth_class !=255  &&  wealth_class != t.g_class) {
 					continue;
 				}
-				halthandle_t const via_halt = i.get_zwischenziel();
-				if ( via_halt.is_bound() && halt_list.is_contained(via_halt) ) {
-					if(  line == get_preferred_line(via_halt, wtyp->get_catg_index(), goods_manager_t::get_classes_catg_index(wtyp->get_index())-1)  ) {
-						sum += i.menge;
+				if ( t.via.is_bound() && halt_list.is_contained(t.via) ) {
+					if(  line == get_preferred_line(t.via, wtyp->get_catg_index(), goods_manager_t::get_classes_catg_index(wtyp->get_index())-1)  ) {
+						sum += t.menge;
 					}
 				}
 			}
@@ -3057,15 +3226,8 @@ uint32 haltestelle_t::get_leaving_goods_sum(const goods_desc_t *wtyp, uint8 g_cl
 
 uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koord zielpos) const
 {
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t const& ware : *warray) {
-			if(wtyp->get_index()==ware.get_index()  &&  ware.get_zielpos()==zielpos) {
-				return ware.menge;
-			}
-		}
-	}
-	return 0;
+	const waiting_sums_t *waiting = waiting_sums[wtyp->get_catg_index()];
+	return waiting ? waiting->by_destination.get(get_destination_key(wtyp->get_index(), zielpos)) : 0;
 }
 
 #ifdef CHECK_WARE_MERGE
@@ -3096,6 +3258,7 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware) //"unite were" (Google)
 			// @author: jamespetts
 			if(ware.can_merge_with(tmp))
 			{
+				remove_waiting(tmp, tmp.menge);
 				if(  ware.get_zwischenziel().is_bound()  &&  ware.get_zwischenziel()!=self  )
 				{
 					// update route if there is newer route
@@ -3106,11 +3269,11 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware) //"unite were" (Google)
 				if(ware.menge > 0)
 				{
 					//The waiting time for ware will always be zero.
-					tmp.arrival_time = welt->get_ticks() - ((welt->get_ticks() - tmp.arrival_time) * tmp.menge) / (tmp.menge + ware.menge);
+					tmp.set_arrival_time(welt->get_ticks() - (tmp.get_waiting_ticks(welt->get_ticks()) * tmp.menge) / (tmp.menge + ware.menge));
 				}
 
 				tmp.menge += ware.menge;
-				resort_freight_info = true;
+				add_waiting(tmp, tmp.menge);
 				return true;
 			}
 		}
@@ -3127,7 +3290,7 @@ void haltestelle_t::add_ware_to_halt(ware_t ware, bool from_saved)
 	// @author: jamespetts
 	if(!from_saved)
 	{
-		ware.arrival_time = welt->get_ticks();
+		ware.set_arrival_time(welt->get_ticks());
 	}
 
 	ware.set_last_transfer(self);
@@ -3140,7 +3303,7 @@ void haltestelle_t::add_ware_to_halt(ware_t ware, bool from_saved)
 		warray = new vector_tpl<ware_t>(4);
 		cargo[ware.get_desc()->get_catg_index()] = warray;
 	}
-	resort_freight_info = true;
+	add_waiting(ware, ware.menge);
 	if(!from_saved)
 	{
 		// the ware will be put into the first entry with menge==0
@@ -3743,6 +3906,7 @@ void haltestelle_t::transfer_goods(halthandle_t halt)
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
+			recount_waiting(i);
 		}
 	}
 }
@@ -3905,7 +4069,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 				}*/
 				if(self.get_rep() != this)
 				{
-					uint16 id = self.get_id();
+					quickstone_id_t id = self.get_id();
 					self = halthandle_t(this, id);
 				}
 			}
@@ -3919,7 +4083,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 			self.set_id(halt_id);
 			if((file->get_extended_version() >= 10 || file->get_extended_version() == 0) && halt_id != 0)
 			{
-				self = halthandle_t(this, halt_id);
+				self = halthandle_t(this, (quickstone_id_t)halt_id);
 			}
 			else
 			{
@@ -4052,6 +4216,9 @@ void haltestelle_t::rdwr(loadsave_t *file)
 						ware.rdwr(file);
 					}
 				}
+				if(  has_uint16_count  &&  ware_count > 65536  ) {
+					recount_waiting(i);
+				}
 			}
 		}
 		s = "";
@@ -4481,7 +4648,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	if(file->get_extended_version() >= 12)
 	{
 		// Load/save the estimated arrival and departure times.
-		uint16 convoy_id;
+		quickstone_id_t convoy_id;
 		sint64 time;
 
 		if(file->is_saving())
@@ -4497,7 +4664,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 			{
 				convoy_id = iter.key;
 				time = iter.value;
-				file->rdwr_short(convoy_id);
+				file->rdwr_handle_id(convoy_id);
 				file->rdwr_longlong(time);
 			}
 
@@ -4505,7 +4672,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 			{
 				convoy_id = iter.key;
 				time = iter.value;
-				file->rdwr_short(convoy_id);
+				file->rdwr_handle_id(convoy_id);
 				file->rdwr_longlong(time);
 			}
 		}
@@ -4523,14 +4690,14 @@ void haltestelle_t::rdwr(loadsave_t *file)
 
 			for(uint32 i = 0; i < arrival_count; i++)
 			{
-				file->rdwr_short(convoy_id);
+				file->rdwr_handle_id(convoy_id);
 				file->rdwr_longlong(time);
 				estimated_convoy_arrival_times.put(convoy_id, time);
 			}
 
 			for(uint32 i = 0; i < departure_count; i++)
 			{
-				file->rdwr_short(convoy_id);
+				file->rdwr_handle_id(convoy_id);
 				file->rdwr_longlong(time);
 				estimated_convoy_departure_times.put(convoy_id, time);
 			}
@@ -4687,8 +4854,8 @@ void haltestelle_t::rdwr(loadsave_t *file)
 		uint32 tmp_journey_time;
 		uint32 tmp_waiting_time;
 		uint32 tmp_transfer_time;
-		uint16 tmp_best_line_idx;
-		uint16 tmp_best_convoy_idx;
+		quickstone_id_t tmp_best_line_idx;
+		quickstone_id_t tmp_best_convoy_idx;
 		uint16 tmp_alternative_seats;
 		// TODO: Consider whether to add comfort
 
@@ -4721,8 +4888,8 @@ void haltestelle_t::rdwr(loadsave_t *file)
 							file->rdwr_long(tmp_journey_time);
 							file->rdwr_long(tmp_waiting_time);
 							file->rdwr_long(tmp_transfer_time);
-							file->rdwr_short(tmp_best_convoy_idx);
-							file->rdwr_short(tmp_best_line_idx);
+							file->rdwr_handle_id(tmp_best_convoy_idx);
+							file->rdwr_handle_id(tmp_best_line_idx);
 							file->rdwr_short(tmp_alternative_seats);
 						}
 					}
@@ -4739,8 +4906,8 @@ void haltestelle_t::rdwr(loadsave_t *file)
 							file->rdwr_long(tmp_journey_time);
 							file->rdwr_long(tmp_waiting_time);
 							file->rdwr_long(tmp_transfer_time);
-							file->rdwr_short(tmp_best_convoy_idx);
-							file->rdwr_short(tmp_best_line_idx);
+							file->rdwr_handle_id(tmp_best_convoy_idx);
+							file->rdwr_handle_id(tmp_best_line_idx);
 							file->rdwr_short(tmp_alternative_seats);
 
 							if (i < goods_manager_t::get_classes_catg_index(catg_index))
@@ -4808,6 +4975,8 @@ void haltestelle_t::finish_rd(bool need_recheck_for_walking_distance)
 					}
 				}
 			}
+			// the next transfers and destinations may have been corrected
+			recount_waiting(i);
 		}
 	}
 
@@ -4944,12 +5113,7 @@ void haltestelle_t::book(sint64 amount, int cost_type)
 
 void haltestelle_t::init_financial_history()
 {
-	for (int j = 0; j<MAX_HALT_COST; j++)
-	{
-		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][j] = 0;
-		}
-	}
+	financial_history.clear();
 }
 
 
@@ -6445,18 +6609,18 @@ void haltestelle_t::add_waiting_time(uint32 time, halthandle_t halt, uint8 categ
 	}
 }
 
-void haltestelle_t::set_estimated_arrival_time(uint16 convoy_id, sint64 time)
+void haltestelle_t::set_estimated_arrival_time(quickstone_id_t convoy_id, sint64 time)
 {
 	estimated_convoy_arrival_times.set(convoy_id, time);
 }
 
 
-void haltestelle_t::set_estimated_departure_time(uint16 convoy_id, sint64 time)
+void haltestelle_t::set_estimated_departure_time(quickstone_id_t convoy_id, sint64 time)
 {
 	estimated_convoy_departure_times.set(convoy_id, time);
 }
 
-void haltestelle_t::clear_estimated_timings(uint16 convoy_id)
+void haltestelle_t::clear_estimated_timings(quickstone_id_t convoy_id)
 {
 	estimated_convoy_arrival_times.remove(convoy_id);
 	estimated_convoy_departure_times.remove(convoy_id);
@@ -6629,6 +6793,17 @@ uint32 haltestelle_t::get_transferring_cargoes_count() const
 }
 #endif
 
+uint32 haltestelle_t::get_waiting_packet_count() const
+{
+	uint32 count = 0;
+	for(uint8 i = 0; i < goods_manager_t::get_max_catg_index(); i++) {
+		if(cargo[i]) {
+			count += cargo[i]->get_count();
+		}
+	}
+	return count;
+}
+
 bool haltestelle_t::has_pax_user(const uint8 months, bool demand_check) const {
 	sint64 count = 0;
 	for (uint8 i = 0; i <= months; i++) {
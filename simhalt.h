@@ -34,6 +34,7 @@
 #include "tpl/fixed_list_tpl.h"
 #include "tpl/binary_heap_tpl.h"
 #include "tpl/minivec_tpl.h"
+#include "tpl/history_tpl.h"
 
 #define MAX_HALT_COST				13 // Total number of cost items
 #define MAX_MONTHS					12 // Max history
@@ -138,7 +139,7 @@ private:
 	/*
 	 * struct holds new financial history for line
 	 */
-	sint64 financial_history[MAX_MONTHS][MAX_HALT_COST];
+	history_tpl<sint64, MAX_MONTHS, MAX_HALT_COST> financial_history;
 
 	/**
 	 * initialize the financial history
@@ -245,6 +246,14 @@ public:
 //	static slist_tpl<halthandle_t>& get_alle_haltestellen() { return alle_haltestellen; }
 	static const vector_tpl<halthandle_t>& get_alle_haltestellen() { return alle_haltestellen; }
 
+	/**
+	 * Rolls the halts over into a new month a few at a time, in the order of
+	 * the list; works like weg_t::start_month_rollover() and its friends.
+	 */
+	static void start_month_rollover();
+	static uint32 get_month_rollover_pending();
+	static void step_month_rollover(uint32 count);
+
 	static vector_tpl<lines_loaded_t>& access_lines_loaded() { return lines_loaded; }
 
 	/**
@@ -359,12 +368,13 @@ public:
 	bool is_using() const;
 
 
-	typedef inthashtable_tpl<uint16, sint64, N_BAGS_SMALL> arrival_times_map;
+	typedef inthashtable_tpl<quickstone_id_t, sint64, N_BAGS_SMALL> arrival_times_map;
 #ifdef MULTI_THREAD
 	uint32 get_transferring_cargoes_count() const;
 #else
 	uint32 get_transferring_cargoes_count() const { return transferring_cargoes->get_count(); }
 #endif
+	uint32 get_waiting_packet_count() const;
 
 private:
 	slist_tpl<tile_t> tiles;
@@ -393,6 +403,56 @@ private:
 	// Array with different categories that contains all waiting goods at this stop
 	vector_tpl<ware_t> **cargo;
 
+	/**
+	 * Amounts of waiting goods, by goods type and class, by next transfer
+	 * and by destination. They are booked whenever packets are added, removed
+	 * or change their amount, so that the getters only read them.
+	 */
+	struct waiting_sum_t
+	{
+		uint8 goods_index;
+		uint8 g_class;
+		uint32 menge;
+		uint32 commuters;
+	};
+
+	struct waiting_transfer_t
+	{
+		halthandle_t via;
+		uint8 goods_index;
+		uint8 g_class;
+		uint32 menge;
+	};
+
+	struct waiting_sums_t
+	{
+		// there are only a few goods types and classes per category, so a list will do
+		vector_tpl<waiting_sum_t> sums;
+		inthashtable_tpl<uint64, waiting_transfer_t, N_BAGS_MEDIUM> by_transfer;
+		inthashtable_tpl<uint64, uint32, N_BAGS_MEDIUM> by_destination;
+
+		waiting_sums_t() : sums(0) {}
+	};
+
+	// one for each category, like cargo; NULL while nothing of it waits here
+	waiting_sums_t **waiting_sums;
+
+	static uint64 get_transfer_key(const ware_t &ware) { return (uint64)ware.get_zwischenziel().get_id() | ((uint64)ware.get_index() << 32) | ((uint64)ware.get_class() << 40); }
+	static uint64 get_destination_key(uint8 goods_index, koord zielpos) { return (uint64)(uint16)zielpos.x | ((uint64)(uint16)zielpos.y << 16) | ((uint64)goods_index << 32); }
+
+	// book a change of the amount of a packet waiting here; if its next transfer changes, it is removed before and added after
+	void add_waiting(const ware_t &ware, uint32 amount);
+	void remove_waiting(const ware_t &ware, uint32 amount);
+
+	// sums up the waiting packets of this category again, after many of them have changed
+	void recount_waiting(uint8 catg_index);
+
+	/**
+	 * The stops at which the convoy calls after this halt, in the order of its schedule,
+	 * until it calls here again or reaches the end of a mirrored schedule.
+	 */
+	void get_stops_until_return(const schedule_t *schedule, const player_t *player, const convoi_t *cnv, vector_tpl<halthandle_t> &stops) const;
+
 	/**
 	 * Liste der angeschlossenen Fabriken
 	 */
@@ -872,9 +932,9 @@ public:
 	void book(sint64 amount, int cost_type);
 
 	/**
-	 * return a pointer to the financial history
+	 * return the financial history
 	 */
-	sint64* get_finance_history() { return *financial_history; }
+	const history_tpl<sint64, MAX_MONTHS, MAX_HALT_COST> &get_finance_history() const { return financial_history; }
 
 	/**
 	 * return a specified element from the financial history
@@ -992,14 +1052,14 @@ public:
 
 	uint32 calc_service_frequency(halthandle_t destination, uint8 category) const;
 
-	void set_estimated_arrival_time(uint16 convoy_id, sint64 time);
-	void set_estimated_departure_time(uint16 convoy_id, sint64 time);
+	void set_estimated_arrival_time(quickstone_id_t convoy_id, sint64 time);
+	void set_estimated_departure_time(quickstone_id_t convoy_id, sint64 time);
 
 	/**
 	* Removes a convoy from the time estimates.
 	* Used when deleting a convoy.
 	*/
-	void clear_estimated_timings(uint16 convoy_id);
+	void clear_estimated_timings(quickstone_id_t convoy_id);
 
 	const arrival_times_map& get_estimated_convoy_arrival_times() { return estimated_convoy_arrival_times; }
 	const arrival_times_map& get_estimated_convoy_departure_times() { return estimated_convoy_departure_times; }
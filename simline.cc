@@ -188,6 +188,8 @@ void simline_t::set_schedule(schedule_t* schedule)
 {
 	if (this->schedule)
 	{
+		// the stops of the old schedule lose their connexions, too
+		haltestelle_t::refresh_routing(this->schedule, goods_catg_index, NULL, NULL, player);
 		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player);
 		unregister_stops();
 		delete this->schedule;
@@ -330,7 +332,7 @@ void simline_t::remove_convoy(convoihandle_t cnv)
 
 void simline_t::rdwr_linehandle_t(loadsave_t *file, linehandle_t &line)
 {
-	uint16 id;
+	quickstone_id_t id;
 	if (file->is_saving()) {
 		id = line.is_bound() ? line.get_id() :
 			 (file->is_version_less(110, 0)  ? INVALID_LINE_ID_OLD : INVALID_LINE_ID);
@@ -346,11 +348,11 @@ void simline_t::rdwr_linehandle_t(loadsave_t *file, linehandle_t &line)
 		id = (uint16)dummy;
 	}
 	else {
-		file->rdwr_short(id);
+		file->rdwr_handle_id(id);
 	}
 	if (file->is_loading()) {
-		// invalid line_id's: 0 and 65535
-		if (id == INVALID_LINE_ID_OLD) {
+		// invalid line_id's: 0 and 65535 (only before 110.0, later it may be a valid id)
+		if (file->is_version_less(110, 0)  &&  id == INVALID_LINE_ID_OLD) {
 			id = 0;
 		}
 		line.set_id(id);
@@ -26,6 +26,7 @@ loadingscreen_t::loadingscreen_t( const char *w, uint32 max_p, bool logo, bool c
 	max_progress = max_p;
 	last_bar_len = -1;
 	show_logo = logo;
+	start_time = dr_time();
 
 	if(  !is_display_init()  ||  continueflag  ) {
 		return;
@@ -148,6 +149,8 @@ void loadingscreen_t::set_progress( uint32 progress )
 
 loadingscreen_t::~loadingscreen_t()
 {
+	dbg->message("loadingscreen_t::~loadingscreen_t()", "%s took %u ms", what ? what : "loading", dr_time() - start_time);
+
 	if(is_display_init()) {
 		win_redraw_world();
 		mark_screen_dirty();
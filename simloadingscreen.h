@@ -28,6 +28,7 @@ private:
 	int last_bar_len;
 	bool show_logo;
 	slist_tpl<event_t *> queued_events;
+	uint32 start_time; ///< dr_time() when created, to log how long the loading took
 
 	// show the logo if requested and there
 	void display_logo();
@@ -148,6 +148,20 @@ static void show_times(karte_t *welt, main_view_t *view)
 	}
 	dbg->message( "display_color_img()", "3x %i iterations took %li ms", i, dr_time() - ms );
 
+	ms = dr_time();
+	for (i = 0;  i < 1000000;  i++) {
+		display_img_blend( img, 50, 50, TRANSPARENT25_FLAG, 1, 0 );
+		display_img_blend( img, 50, 50, TRANSPARENT75_FLAG|OUTLINE_FLAG|color_idx_to_rgb(COL_BLACK), 1, 0 );
+	}
+	dbg->message( "display_img_blend() with and without outline", "2x %i iterations took %li ms", i, dr_time() - ms );
+
+	ms = dr_time();
+	for (i = 0;  i < 100000;  i++) {
+		display_blend_wh_rgb( 100, 120, 300, 50, color_idx_to_rgb(COL_BLACK), 50 );
+		display_blend_wh_rgb( 100, 120, 300, 50, color_idx_to_rgb(COL_WHITE), 30 );
+	}
+	dbg->message( "display_blend_wh_rgb() 50% and 30%", "2x %i iterations took %li ms", i, dr_time() - ms );
+
 	ms = dr_time();
 	for (i = 0;  i < 600000;  i++) {
 		dr_prepare_flush();
@@ -167,11 +181,20 @@ static void show_times(karte_t *welt, main_view_t *view)
 	}
 	dbg->message( "display_fillbox_wh()", "%i iterations took %li ms", i, dr_time() - ms );
 
+#ifdef MULTI_THREAD
+	main_view_t::reset_render_stats();
+#endif
 	ms = dr_time();
 	for (i = 0; i < 2000; i++) {
 		view->display(true);
 	}
 	dbg->message( "view->display(true)", "%i iterations took %li ms", i, dr_time() - ms );
+#ifdef MULTI_THREAD
+	for(  int t = 0;  t < env_t::num_threads;  t++  ) {
+		const main_view_t::render_thread_stats_t &stats = main_view_t::get_render_stats(t);
+		dbg->message( "view->display(true)", "thread %i drew %u bands in %li ms", t, stats.bands, (long)(stats.busy_us / 1000) );
+	}
+#endif
 
 	ms = dr_time();
 	for (i = 0; i < 2000; i++) {
@@ -1181,7 +1204,7 @@ int simu_main(int argc, char** argv)
 
 	convoihandle_t::init( 1024 );
 	linehandle_t::init( 1024 );
-	halthandle_t::init( 1024 );
+	halthandle_t::init( 1024, HALT_ID_RANGE-1 );
 
 #ifdef MULTI_THREAD
 	// set number of threads
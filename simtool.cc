@@ -9664,14 +9664,14 @@ static bool scenario_check_schedule(karte_t *welt, player_t *player, schedule_t
 bool tool_change_convoi_t::init( player_t *player )
 {
 	char tool=0;
-	uint16 convoi_id = 0;
+	uint32 convoi_id = 0;
 
 	// skip the rest of the command
 	const char *p = default_param;
 	while(  *p  &&  *p<=' '  ) {
 		p++;
 	}
-	sscanf( p, "%c,%hi", &tool, &convoi_id );
+	sscanf( p, "%c,%u", &tool, &convoi_id );
 
 	// skip to the commands ...
 	for(  int z = 2;  *p  &&  z>0;  p++  ) {
@@ -9691,7 +9691,7 @@ bool tool_change_convoi_t::init( player_t *player )
 			create_win( new news_img("Convoy already deleted!"), w_time_delete, magic_none);
 		}
 #endif
-		dbg->warning("tool_change_convoi_t::init", "no convoy with id=%d found", convoi_id);
+		dbg->warning("tool_change_convoi_t::init", "no convoy with id=%u found", convoi_id);
 		return false;
 	}
 	// ownership check for network games
@@ -9741,8 +9741,9 @@ bool tool_change_convoi_t::init( player_t *player )
 		case 'l': // change line
 			{
 				// read out id and new current_stop index
-				uint16 id = 0, current_stop = 0;
-				int count = sscanf(p, "%hi,%hi", &id, &current_stop);
+				uint32 id = 0;
+				uint16 current_stop = 0;
+				int count = sscanf(p, "%u,%hi", &id, &current_stop);
 				linehandle_t l;
 				l.set_id(id);
 				if (l.is_bound()) {
@@ -9772,8 +9773,8 @@ bool tool_change_convoi_t::init( player_t *player )
 
 		case 'C': // Copy a replace datum
 		{
-			uint16 cnv_rpl_id;
-			sscanf(p, "%hi", &cnv_rpl_id);
+			uint32 cnv_rpl_id;
+			sscanf(p, "%u", &cnv_rpl_id);
 			convoihandle_t cnv_rpl;
 			cnv_rpl.set_id(cnv_rpl_id);
 			if (cnv_rpl.is_bound() && cnv_rpl->get_replace())
@@ -9995,7 +9996,7 @@ bool tool_change_convoi_t::init( player_t *player )
  */
 bool tool_change_line_t::init( player_t *player )
 {
-	uint16 line_id = 0;
+	uint32 line_id = 0;
 
 	// skip the rest of the command
 	const char *p = default_param;
@@ -10262,7 +10263,7 @@ bool tool_change_depot_t::init( player_t *player )
 	char tool=0;
 	koord pos2d;
 	sint8 z;
-	uint16 convoi_id;
+	uint32 convoi_id;
 	uint16 livery_scheme_index;
 
 	// skip the rest of the command
@@ -10270,7 +10271,7 @@ bool tool_change_depot_t::init( player_t *player )
 	while(  *p  &&  *p<=' '  ) {
 		p++;
 	}
-	sscanf( p, "%c,%hi,%hi,%hhi,%hi,%hi", &tool, &pos2d.x, &pos2d.y, &z, &convoi_id, &livery_scheme_index );
+	sscanf( p, "%c,%hi,%hi,%hhi,%u,%hi", &tool, &pos2d.x, &pos2d.y, &z, &convoi_id, &livery_scheme_index );
 
 	koord3d pos(pos2d, z);
 
@@ -10643,6 +10644,10 @@ bool tool_change_traffic_light_t::init( player_t *player )
 				else if(  ns == 3  ) {
 					rs->set_ticks_amber_ow( (uint8)ticks );
 				}
+				if(  rs->get_desc()->is_private_way()  ) {
+					// the players allowed to pass may have changed
+					route_t::invalidate_route_cache(rs->get_desc()->get_wtyp());
+				}
 				// update the window
 				if(  rs->get_desc()->is_traffic_light()  ) {
 					trafficlight_info_t* trafficlight_win = (trafficlight_info_t*)win_get_magic((ptrdiff_t)rs);
@@ -10724,7 +10729,7 @@ bool tool_change_city_t::init( player_t *player )
  */
 bool tool_rename_t::init(player_t *player)
 {
-	uint16 id = 0;
+	uint32 id = 0;
 	koord3d pos = koord3d::invalid;
 
 	// skip the rest of the command
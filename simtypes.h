@@ -191,6 +191,19 @@ typedef unsigned long long  uint64;
 #endif
 #endif // ! MULTI_THREAD
 
+/*
+ * Index of convoy, line and halt handles (see quickstone_tpl.h).
+ * With QUICKSTONE_32BIT there can be far more than 65535 convoys and lines,
+ * at the price of larger handles. Halts stay below 65536 in either build.
+ */
+#ifdef QUICKSTONE_32BIT
+typedef uint32 quickstone_id_t;
+#define QUICKSTONE_ID_RANGE (0x1000000u)
+#else
+typedef uint16 quickstone_id_t;
+#define QUICKSTONE_ID_RANGE (0x10000u)
+#endif
+
 static inline uint32 hammingWeight(uint8 x){
 #ifdef USE_GCC_POPCOUNT
 	return (__builtin_popcount(x));
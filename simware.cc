@@ -12,6 +12,7 @@
 #include "simhalt.h"
 #include "simtypes.h"
 #include "simware.h"
+#include "simworld.h"
 #include "dataobj/loadsave.h"
 #include "dataobj/koord.h"
 
@@ -221,11 +222,17 @@ void ware_t::rdwr(loadsave_t *file)
 			uint8 dummy;
 			file->rdwr_byte(dummy);
 		}
-		file->rdwr_longlong(arrival_time);
+		// saved in full for compatibility
+		sint64 full_arrival_time = get_arrival_time(world()->get_ticks());
+		file->rdwr_longlong(full_arrival_time);
+		if(file->is_loading())
+		{
+			set_arrival_time(max(full_arrival_time, world()->get_ticks() - 0x7FFFFFFFll));
+		}
 	}
 	else
 	{
-		arrival_time = 0;
+		set_arrival_time(world()->get_ticks() - 0x7FFFFFFFll);
 	}
 
 	if(  file->is_version_atleast(111, 0) && file->get_extended_version() >= 10  ) {
@@ -293,6 +300,14 @@ void ware_t::finish_rd(karte_t *welt)
 }
 
 
+void ware_t::limit_waiting_ticks(sint64 ticks)
+{
+	if(  get_waiting_ticks(ticks) > 0x7FFFFFFFll  ) {
+		set_arrival_time(ticks - 0x7FFFFFFFll);
+	}
+}
+
+
 void ware_t::rotate90(sint16 y_size )
 {
 	zielpos.rotate90( y_size );
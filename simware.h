@@ -73,12 +73,15 @@ private:
 	 */
 	koord zielpos;
 
-public:
-	// The time at which this packet arrived at the current station
-	// @author: jamespetts
-	sint64 arrival_time;
+	/**
+	 * The time at which this packet arrived at the current station.
+	 * Only the lower 32 bits of the ticks are kept, which brings a packet
+	 * down from 32 to 28 bytes; as long as it waits for less than 2^31 ticks,
+	 * the difference to the current ticks is still exact.
+	 * @author: jamespetts
+	 */
+	uint32 arrival_time;
 
-private:
 	/**
 	 * Update target (zielpos) for factory-going goods (after loading or rotating)
 	 */
@@ -95,6 +98,21 @@ public:
 	koord get_zielpos() const { return zielpos; }
 	void set_zielpos(const koord zielpos) { this->zielpos = zielpos; }
 
+	void set_arrival_time(sint64 ticks) { arrival_time = (uint32)ticks; }
+
+	/// @returns how long this packet has been waiting at the current station, given the current @p ticks
+	inline sint64 get_waiting_ticks(sint64 ticks) const { return (uint32)((uint32)ticks - arrival_time); }
+
+	/// @returns the arrival time in full, given the current @p ticks
+	inline sint64 get_arrival_time(sint64 ticks) const { return ticks - get_waiting_ticks(ticks); }
+
+	/**
+	 * Limits the waiting time to 2^31 ticks, so the arrival time cannot
+	 * overflow and appear recent again. Must be checked for every waiting
+	 * packet more often than every 2^31 ticks.
+	 */
+	void limit_waiting_ticks(sint64 ticks);
+
 	void reset() { menge = 0; ziel = zwischenziel = origin = last_transfer = halthandle_t(); zielpos = koord::invalid; }
 
 	ware_t();
@@ -154,7 +172,7 @@ public:
 	bool operator <= (const ware_t &w)
 	{
 		// Used only for the binary heap
-		return arrival_time <= w.arrival_time;
+		return (sint32)(arrival_time - w.arrival_time) <= 0;
 	}
 
 	int operator!=(const ware_t &w) { return !(*this == w); }
@@ -84,6 +84,7 @@
 #include "dataobj/ribi.h"
 #include "dataobj/translator.h"
 #include "dataobj/loadsave.h"
+#include "io/rdwr/memory_rdwr_stream.h"
 #include "dataobj/scenario.h"
 #include "dataobj/settings.h"
 #include "dataobj/environment.h"
@@ -131,15 +132,24 @@
 
 static vector_tpl<pthread_t> private_car_route_threads;
 static vector_tpl<pthread_t> unreserve_route_threads;
+static vector_tpl<pthread_t> sync_region_threads;
 static vector_tpl<pthread_t> step_passengers_and_mail_threads;
 static vector_tpl<pthread_t> individual_convoy_step_threads;
 static vector_tpl<pthread_t> path_explorer_threads;
+static vector_tpl<pthread_t> path_explorer_compartment_threads;
 static pthread_t convoy_step_master_thread;
 static pthread_t path_explorer_thread;
 
 static pthread_attr_t thread_attributes;
 static pthread_mutexattr_t mutex_attributes;
 
+// The city whose private car routes each private car route thread checks (or NULL), and the index of that city in the list of cities.
+// The cities are assigned to the threads by the main thread, so that which city is checked in which step is the same on all clients.
+static stadt_t **private_car_route_check_cities = NULL;
+static uint32 *private_car_route_check_city_indices = NULL;
+// The private car routes found by each of these threads in the current step
+static vector_tpl<weg_t::private_car_backtrace_t> *private_car_backtraces = NULL;
+
 //static pthread_mutex_t private_car_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 //pthread_mutex_t karte_t::step_passengers_and_mail_mutex = PTHREAD_MUTEX_INITIALIZER;
 //static pthread_mutex_t path_explorer_await_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -155,8 +165,11 @@ simthread_barrier_t karte_t::private_car_barrier;
 simthread_barrier_t karte_t::unreserve_route_barrier;
 static simthread_barrier_t step_passengers_and_mail_barrier;
 static simthread_barrier_t path_explorer_barrier;
+static simthread_barrier_t path_explorer_compartments_barrier;
 static simthread_barrier_t step_convoys_barrier_internal;
 simthread_barrier_t karte_t::step_convoys_barrier_external;
+static simthread_barrier_t sync_region_barrier;
+static pthread_mutex_t sync_region_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 bool karte_t::threads_initialised = false;
 
@@ -167,6 +180,8 @@ vector_tpl<convoihandle_t> convoys_next_step;
 
 vector_tpl<pedestrian_t*> *karte_t::pedestrians_added_threaded;
 vector_tpl<private_car_t*> *karte_t::private_cars_added_threaded;
+vector_tpl<karte_t::generated_passengers_t> *karte_t::generated_passengers_threaded;
+vector_tpl<karte_t::started_passengers_t> *karte_t::started_passengers_threaded;
 #endif
 sint32 karte_t::cities_to_process = 0;
 #ifdef MULTI_THREAD
@@ -177,6 +192,13 @@ vector_tpl<nearby_halt_t> karte_t::start_halts;
 vector_tpl<halthandle_t> karte_t::destination_list;
 #endif
 
+thread_local karte_t::sync_region_t *karte_t::sync_region = NULL;
+
+// The sync list whose regions are being stepped, the time of that sync_step, and the next region to be taken by a thread.
+static karte_t::sync_list_t *sync_region_list = NULL;
+static uint32 sync_region_delta_t = 0;
+static uint32 sync_region_next = 0;
+
 
 static uint32 last_clients = -1;
 static uint8 last_active_player_nr = 0;
@@ -498,11 +520,15 @@ void karte_t::destroy()
 
 	passenger_origins.clear();
 	mail_origins_and_targets.clear();
+	passenger_origins_sampler.reset();
+	mail_origins_and_targets_sampler.reset();
 
 	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
 	{
 		commuter_targets[i].clear();
 		visitor_targets[i].clear();
+		commuter_targets_samplers[i].reset();
+		visitor_targets_samplers[i].reset();
 	}
 
 	uint32 max_display_progress = 256+stadt.get_count()*10 + haltestelle_t::get_alle_haltestellen().get_count() + convoi_array.get_count() + (cached_size.x*cached_size.y)*2;
@@ -623,6 +649,7 @@ void karte_t::destroy()
 
 	weg_t::clear_travel_time_updates();
 	weg_t::clear_list_of__ways();
+	month_rollover_steps_left = 0;
 	DBG_MESSAGE("karte_t::destroy()", "way list destroyed");
 
 	delete scenario;
@@ -647,6 +674,13 @@ void karte_t::destroy()
 	destroying = false;
 #ifdef MULTI_THREAD
 	cities_to_process = 0;
+	if (private_car_route_check_cities)
+	{
+		for (sint32 i = 0; i < get_parallel_operations(); i++)
+		{
+			private_car_route_check_cities[i] = NULL;
+		}
+	}
 	terminating_threads = false;
 #endif
 }
@@ -661,7 +695,17 @@ void karte_t::add_convoi(convoihandle_t const &cnv)
 
 void karte_t::rem_convoi(convoihandle_t const &cnv)
 {
-	convoi_array.remove(cnv);
+	const uint32 index = convoi_array.index_of(cnv);
+	if(  index != 0xFFFFFFFFu  ) {
+		convoi_array.remove_at(index);
+		// keep the convoys not yet rolled over in place
+		if(  index < month_rollover_convoi_end  ) {
+			month_rollover_convoi_end--;
+			if(  index < month_rollover_convoi_next  ) {
+				month_rollover_convoi_next--;
+			}
+		}
+	}
 }
 
 
@@ -742,11 +786,13 @@ void karte_t::init_tiles()
 	last_month_bev = 0;
 
 	tile_counter = 0;
+	month_rollover_steps_left = 0;
+	month_rollover_convoi_next = month_rollover_convoi_end = 0;
 
 	convoihandle_t::init( 1024 );
 	linehandle_t::init( 1024 );
 
-	halthandle_t::init( 1024 );
+	halthandle_t::init( 1024, HALT_ID_RANGE-1 );
 
 	vehicle_base_t::set_overtaking_offsets( get_settings().is_drive_left() );
 
@@ -854,10 +900,32 @@ void karte_t::create_rivers( sint16 number )
 void karte_t::remove_queued_city(stadt_t* city)
 {
 	cities_awaiting_private_car_route_check.remove(city);
+#ifdef MULTI_THREAD
+	// The threads may be reading this city, so it must not be deleted before they have halted.
+	await_private_car_threads();
+	if (private_car_route_check_cities)
+	{
+		for (sint32 i = 0; i < get_parallel_operations(); i++)
+		{
+			if (private_car_route_check_cities[i] == city)
+			{
+				// A thread has halted part way through checking this city: let it finish the check,
+				// which also releases the city from the thread.
+				suspend_private_car_threads();
+				break;
+			}
+		}
+	}
+#endif
 }
 
 void karte_t::add_queued_city(stadt_t* city)
 {
+	if(  sync_region  ) {
+		// queued after all regions, in their order
+		sync_region->queued_cities.append(city);
+		return;
+	}
 #ifdef MULTI_THREAD
 	if (private_car_route_mutex_initialised)
 	{
@@ -963,7 +1031,7 @@ void karte_t::distribute_cities(settings_t const * const sets, sint16 old_x, sin
 #endif
 		for (unsigned i = 0; i < new_city_count; i++) {
 			stadt_t* s = new stadt_t(players[1], (*pos)[i], 1);
-			DBG_DEBUG("karte_t::distribute_groundobjs_cities()", "Erzeuge stadt %i with %ld inhabitants", i, (s->get_city_history_month())[HIST_CITIZENS]);
+			DBG_DEBUG("karte_t::distribute_groundobjs_cities()", "Erzeuge stadt %i with %ld inhabitants", i, s->get_city_history_month()[0][HIST_CITIZENS]);
 			if (s->get_buildings() > 0) {
 				add_city(s);
 			}
@@ -1582,52 +1650,33 @@ void *check_road_connexions_threaded(void *args)
 	delete thread_number_ptr;
 
 	karte_t::marker_index = thread_number + world()->get_parallel_operations();
+	weg_t::private_car_backtrace_buffer = &private_car_backtraces[thread_number];
 
 	do
 	{
+		// Start of the step's part of the check (see karte_t::start_private_car_threads())
+		simthread_barrier_wait(&karte_t::private_car_barrier);
 		if (world()->is_terminating_threads())
 		{
 			break;
 		}
-		int error = pthread_mutex_lock(&karte_t::private_car_route_mutex);
-		assert(error == 0);
-		(void)error;
 
-		if (karte_t::cities_to_process > 0 && karte_t::cities_to_process >= thread_number + 1 && route_t::suspend_private_car_routing == false && !world()->cities_awaiting_private_car_route_check.empty())
+		stadt_t* city = private_car_route_check_cities[thread_number];
+		if (city)
 		{
-			stadt_t* city;
-			city = world()->cities_awaiting_private_car_route_check.remove_first();
-
-			int error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
-			assert(error == 0);
-			(void)error;
-
-			if (!city || world()->get_settings().get_assume_everywhere_connected_by_road())
-			{
-				continue;
-			}
-
+			// This halts at the end of each step's part of the check unless the threads are suspended.
 			city->check_all_private_car_routes();
+			private_car_route_check_cities[thread_number] = NULL;
 
-			error = pthread_mutex_lock(&karte_t::private_car_route_mutex);
+			int error = pthread_mutex_lock(&karte_t::private_car_route_mutex);
+			assert(error == 0);
 			karte_t::cities_to_process--;
 			error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
-
-			simthread_barrier_wait(&karte_t::private_car_barrier);
-		}
-		else
-		{
-			int error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
 			assert(error == 0);
 			(void)error;
-
-			if (!world()->is_terminating_threads() && route_t::suspend_private_car_routing)
-			{
-				simthread_barrier_wait(&karte_t::private_car_barrier);
-			}
 		}
 
-		// Having two barrier waits here is intentional.
+		// End of the step's part of the check (see karte_t::await_private_car_threads())
 		simthread_barrier_wait(&karte_t::private_car_barrier);
 	} while (!world()->is_terminating_threads());
 
@@ -1653,6 +1702,23 @@ uint32 passengers_travelled_this_month_with_tolerance_of_under_10_minutes = 0;
 uint32 total_journey_times_this_month = 0;
 #endif
 
+/**
+ * The part of @p budget to be generated by @p shard of @p shards in this step.
+ * The budget is split in whole intervals, so small budgets are not rounded down
+ * to less than one interval in every shard. Whatever is not generated
+ * remains in the budget for the next step.
+ */
+static sint32 shard_step_budget(sint32 budget, sint32 interval, sint32 shard, sint32 shards)
+{
+	if (interval <= 0 || budget < interval || shards <= 0)
+	{
+		return 0;
+	}
+	const sint32 packets = budget / interval;
+	return (packets / shards + (shard < packets % shards ? 1 : 0)) * interval;
+}
+
+
 void *step_passengers_and_mail_threaded(void* args)
 {
 	const uint32* thread_number_ptr = (const uint32*)args;
@@ -1687,68 +1753,26 @@ void *step_passengers_and_mail_threaded(void* args)
 			break;
 		}
 
+		// Reseed each step from the game state, so that the stream of each thread only
+		// depends on the step and its thread number, not on what it generated before.
+		setsimrand_thread(karte_t::world->passenger_generation_seed + seed);
+
 		// The generate passengers function is called many times (often well > 100) each step; the mail version is called only once or twice each step, sometimes not at all.
 		sint32 units_this_step = 0;
 		total_units_passenger = 0;
 		total_units_mail = 0;
 
 #ifndef FIXED_PASSENGER_NUMBERS_PER_STEP_FOR_TESTING
-		next_step_passenger_this_thread = karte_t::world->next_step_passenger / (karte_t::world->get_parallel_operations());
-
-		next_step_mail_this_thread = karte_t::world->next_step_mail / (karte_t::world->get_parallel_operations());
+		// The thread numbers start at 1, as 0 represents the main thread.
+		const sint32 shard = (sint32)karte_t::passenger_generation_thread_number - 1;
+		const sint32 shards = karte_t::world->get_parallel_operations();
+		next_step_passenger_this_thread = shard_step_budget(karte_t::world->next_step_passenger, karte_t::world->passenger_step_interval, shard, shards);
+		next_step_mail_this_thread = shard_step_budget(karte_t::world->next_step_mail, karte_t::world->mail_step_interval, shard, shards);
 
 #ifdef FORBID_PARALLELL_PASSENGER_GENERATION_IN_NETWORK_MODE
 		if (env_t::networkmode)
 		{
-			if (karte_t::passenger_generation_thread_number == 0)
-			{
-				next_step_passenger_this_thread = karte_t::world->next_step_passenger;
-			}
-			else
-			{
-				next_step_passenger_this_thread = 0;
-			}
-		}
-		else
-		{
-#else
-
-			if (next_step_passenger_this_thread < karte_t::world->passenger_step_interval && karte_t::world->next_step_passenger > karte_t::world->passenger_step_interval)
-			{
-				if (karte_t::passenger_generation_thread_number == 0)
-				{
-					// In case of very small numbers, make this effectively single threaded, or else rounding errors will prevent any passenger generation.
-					next_step_passenger_this_thread = karte_t::world->next_step_passenger;
-				}
-				else
-				{
-					next_step_passenger_this_thread = 0;
-				}
-			}
-			else if (karte_t::passenger_generation_thread_number == 0)
-			{
-				next_step_passenger_this_thread += karte_t::world->next_step_passenger % (karte_t::world->get_parallel_operations());
-			}
-
-			if (next_step_mail_this_thread < karte_t::world->mail_step_interval && karte_t::world->next_step_mail > karte_t::world->mail_step_interval)
-			{
-				if (karte_t::passenger_generation_thread_number == 0)
-				{
-					// In case of very small numbers, make this effectively single threaded, or else rounding errors will prevent any mail generation.
-					next_step_mail_this_thread = karte_t::world->next_step_mail;
-				}
-				else
-				{
-					next_step_mail_this_thread = 0;
-				}
-			}
-			else if (karte_t::passenger_generation_thread_number == 0)
-			{
-				next_step_mail_this_thread += karte_t::world->next_step_mail % (karte_t::world->get_parallel_operations());
-			}
-#endif
-
-#ifdef FORBID_PARALLELL_PASSENGER_GENERATION_IN_NETWORK_MODE
+			next_step_passenger_this_thread = shard == 0 ? karte_t::world->next_step_passenger : 0;
 		}
 #endif
 
@@ -1919,6 +1943,24 @@ void karte_t::start_private_car_threads(bool override_suspend)
 {
 	if (!private_car_threads_working && (override_suspend || !route_t::suspend_private_car_routing))
 	{
+		if (!route_t::suspend_private_car_routing)
+		{
+			// Assign the cities awaiting their check to the idle threads, in order.
+			const sint32 thread_count = max(get_parallel_operations() - 1, 1);
+			for (sint32 i = 0; i < thread_count && !cities_awaiting_private_car_route_check.empty(); i++)
+			{
+				if (private_car_route_check_cities[i] == NULL)
+				{
+					stadt_t* city = cities_awaiting_private_car_route_check.remove_first();
+					if (city && !get_settings().get_assume_everywhere_connected_by_road())
+					{
+						private_car_route_check_cities[i] = city;
+						private_car_route_check_city_indices[i] = stadt.index_of(city);
+						cities_to_process++;
+					}
+				}
+			}
+		}
 		simthread_barrier_wait(&private_car_barrier);
 		private_car_threads_working = true;
 	}
@@ -1930,6 +1972,25 @@ void karte_t::await_private_car_threads(bool override_suspend)
 	{
 		simthread_barrier_wait(&private_car_barrier);
 		private_car_threads_working = false;
+
+		// What the private car routes look like depends on the order in which the routes are written,
+		// so apply the routes found by the threads in the order of the cities which they checked.
+		while (true)
+		{
+			sint32 next = -1;
+			for (sint32 i = 0; i < get_parallel_operations(); i++)
+			{
+				if (!private_car_backtraces[i].empty() && (next < 0 || private_car_route_check_city_indices[i] < private_car_route_check_city_indices[next]))
+				{
+					next = i;
+				}
+			}
+			if (next < 0)
+			{
+				break;
+			}
+			weg_t::apply_private_car_backtraces(private_car_backtraces[next]);
+		}
 	}
 }
 
@@ -1975,6 +2036,41 @@ void* path_explorer_threaded(void* args)
 }
 #endif
 
+#ifdef MULTI_THREAD_PATH_EXPLORER
+void* step_path_explorer_compartments_threaded(void* args)
+{
+	const uint32* thread_number_ptr = (const uint32*)args;
+	const uint32 thread_number = *thread_number_ptr;
+	delete thread_number_ptr;
+
+	path_explorer_t::allow_path_explorer_on_this_thread = true;
+	while (true)
+	{
+		simthread_barrier_wait(&path_explorer_compartments_barrier);
+		if (karte_t::world->is_terminating_threads())
+		{
+			return NULL;
+		}
+		path_explorer_t::step_parallel_compartments(thread_number, karte_t::world->get_parallel_operations());
+		simthread_barrier_wait(&path_explorer_compartments_barrier);
+	}
+
+	return args;
+}
+
+void karte_t::step_path_explorer_compartments()
+{
+	if (get_parallel_operations() == 0)
+	{
+		// There are no worker threads: do all the work on this thread.
+		path_explorer_t::step_parallel_compartments(0, 1);
+		return;
+	}
+	simthread_barrier_wait(&path_explorer_compartments_barrier);
+	simthread_barrier_wait(&path_explorer_compartments_barrier);
+}
+#endif
+
 void karte_t::await_path_explorer()
 {
 #ifdef MULTI_THREAD_PATH_EXPLORER
@@ -2055,6 +2151,28 @@ void* unreserve_route_threaded(void* args)
 	pthread_exit(NULL);
 	return args;
 }
+
+// Steps the regions of private cars and pedestrians together with the main thread (see karte_t::sync_list_t::sync_step()).
+void* step_sync_regions_threaded(void* args)
+{
+	do
+	{
+		simthread_barrier_wait(&sync_region_barrier);
+
+		if (karte_t::world->is_terminating_threads())
+		{
+			break;
+		}
+
+		sync_region_list->step_regions(sync_region_delta_t);
+
+		simthread_barrier_wait(&sync_region_barrier);
+
+	} while (!karte_t::world->is_terminating_threads());
+
+	pthread_exit(NULL);
+	return args;
+}
 #endif
 
 void karte_t::await_all_threads()
@@ -2079,12 +2197,23 @@ void karte_t::init_threads()
 
 	private_cars_added_threaded = new vector_tpl<private_car_t*>[parallel_operations + 2];
 	pedestrians_added_threaded = new vector_tpl<pedestrian_t*>[parallel_operations + 2];
+	generated_passengers_threaded = new vector_tpl<generated_passengers_t>[parallel_operations + 2];
+	started_passengers_threaded = new vector_tpl<started_passengers_t>[parallel_operations + 2];
 	transferring_cargoes = new vector_tpl<transferring_cargo_t>[parallel_operations + 2];
 	marker_t::markers = new marker_t[parallel_operations * 2];
 
 	start_halts = new vector_tpl<nearby_halt_t>[parallel_operations + 2];
 	destination_list = new vector_tpl<halthandle_t>[parallel_operations + 2];
 
+	private_car_route_check_cities = new stadt_t*[parallel_operations];
+	private_car_route_check_city_indices = new uint32[parallel_operations];
+	private_car_backtraces = new vector_tpl<weg_t::private_car_backtrace_t>[parallel_operations];
+	for (sint32 i = 0; i < parallel_operations; i++)
+	{
+		private_car_route_check_cities[i] = NULL;
+		private_car_route_check_city_indices[i] = 0;
+	}
+
 	pthread_attr_init(&thread_attributes);
 	pthread_attr_setdetachstate(&thread_attributes, PTHREAD_CREATE_JOINABLE);
 
@@ -2097,6 +2226,8 @@ void karte_t::init_threads()
 	simthread_barrier_init(&step_convoys_barrier_external, NULL, 2);
 	simthread_barrier_init(&step_convoys_barrier_internal, NULL, parallel_operations + 1);
 	simthread_barrier_init(&path_explorer_barrier, NULL, 2);
+	simthread_barrier_init(&path_explorer_compartments_barrier, NULL, parallel_operations + 1);
+	simthread_barrier_init(&sync_region_barrier, NULL, parallel_operations + 1); // The main thread steps regions as well.
 
 	// Initialise mutexes
 	pthread_mutexattr_init(&mutex_attributes);
@@ -2159,6 +2290,30 @@ void karte_t::init_threads()
 			break;
 		}
 
+		rc = pthread_create(&thread, &thread_attributes, &step_sync_regions_threaded, NULL);
+		if (rc)
+		{
+			dbg->fatal("void karte_t::init_threads()", "Failed to create sync step region thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
+		}
+		else
+		{
+			sync_region_threads.append(thread);
+		}
+
+#ifdef MULTI_THREAD_PATH_EXPLORER
+		uint32* thread_number_pe = new uint32;
+		*thread_number_pe = i;
+		rc = pthread_create(&thread, &thread_attributes, &step_path_explorer_compartments_threaded, (void*)thread_number_pe);
+		if (rc)
+		{
+			dbg->fatal("void karte_t::init_threads()", "Failed to create path explorer compartment thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
+		}
+		else
+		{
+			path_explorer_compartment_threads.append(thread);
+		}
+#endif
+
 #ifdef MULTI_THREAD_CONVOYS
 		uint32* thread_number_cnv = new uint32;
 		*thread_number_cnv = i;
@@ -2227,9 +2382,13 @@ void karte_t::destroy_threads()
 		simthread_barrier_wait(&private_car_barrier);
 
 		simthread_barrier_wait(&unreserve_route_barrier);
+		simthread_barrier_wait(&sync_region_barrier);
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_wait(&path_explorer_barrier);
 		pthread_join(path_explorer_thread, 0);
+		simthread_barrier_wait(&path_explorer_compartments_barrier);
+		clean_threads(&path_explorer_compartment_threads);
+		path_explorer_compartment_threads.clear();
 #endif
 #ifdef MULTI_THREAD_CONVOYS
 		pthread_join(convoy_step_master_thread, 0);
@@ -2245,6 +2404,8 @@ void karte_t::destroy_threads()
 
 		clean_threads(&unreserve_route_threads);
 		unreserve_route_threads.clear();
+		clean_threads(&sync_region_threads);
+		sync_region_threads.clear();
 #ifdef MULTI_THREAD_CONVOYS
 		simthread_barrier_destroy(&step_convoys_barrier_external);
 		simthread_barrier_destroy(&step_convoys_barrier_internal);
@@ -2254,9 +2415,11 @@ void karte_t::destroy_threads()
 #endif
 		simthread_barrier_destroy(&private_car_barrier);
 		simthread_barrier_destroy(&unreserve_route_barrier);
+		simthread_barrier_destroy(&sync_region_barrier);
 
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_destroy(&path_explorer_barrier);
+		simthread_barrier_destroy(&path_explorer_compartments_barrier);
 #endif
 
 		// Destroy mutexes
@@ -2273,6 +2436,10 @@ void karte_t::destroy_threads()
 	private_cars_added_threaded = NULL;
 	delete[] pedestrians_added_threaded;
 	pedestrians_added_threaded = NULL;
+	delete[] generated_passengers_threaded;
+	generated_passengers_threaded = NULL;
+	delete[] started_passengers_threaded;
+	started_passengers_threaded = NULL;
 	delete[] transferring_cargoes;
 	transferring_cargoes = NULL;
 	delete[] marker_t::markers;
@@ -2281,6 +2448,12 @@ void karte_t::destroy_threads()
 	start_halts = NULL;
 	delete[] destination_list;
 	destination_list = NULL;
+	delete[] private_car_route_check_cities;
+	private_car_route_check_cities = NULL;
+	delete[] private_car_route_check_city_indices;
+	private_car_route_check_city_indices = NULL;
+	delete[] private_car_backtraces;
+	private_car_backtraces = NULL;
 
 	threads_initialised = false;
 	terminating_threads = false;
@@ -3051,10 +3224,13 @@ karte_t::karte_t() :
 	fix_ratio_frame_time = 200;
 	idle_time = 0;
 	network_frame_count = 0;
+	month_rollover_steps_left = 0;
+	month_rollover_convoi_next = month_rollover_convoi_end = 0;
 	sync_steps = 0;
 	sync_steps_barrier = sync_steps;
 	next_step_passenger = 0;
 	next_step_mail = 0;
+	passenger_generation_seed = 0;
 	destroying = false;
 	transferring_cargoes = NULL;
 #ifdef MULTI_THREAD
@@ -3134,6 +3310,8 @@ karte_t::karte_t() :
 	const uint8 number_of_passenger_classes = goods_manager_t::passengers->get_number_of_classes();
 	commuter_targets = new weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
 	visitor_targets = new weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
+	commuter_targets_samplers = new alias_sampler_tpl<gebaeude_t*>[number_of_passenger_classes];
+	visitor_targets_samplers = new alias_sampler_tpl<gebaeude_t*>[number_of_passenger_classes];
 
 #ifdef MULTI_THREAD
 	passengers_and_mail_threads_working = false;
@@ -3154,6 +3332,8 @@ karte_t::~karte_t()
 
 	delete[] commuter_targets;
 	delete[] visitor_targets;
+	delete[] commuter_targets_samplers;
+	delete[] visitor_targets_samplers;
 
 	// unset single instance
 	if (world == this) {
@@ -4167,9 +4347,31 @@ stadt_t *karte_t::get_city(const koord pos) const
 
 // -------- Verwaltung von synchronen Objekten ------------------
 
+// How far from the edge of its region a private car or pedestrian must be to be stepped with it:
+// in one sync_step, one of them reaches up to three tiles from where it is (see road_user_t::local_sync_pos()).
+#define SYNC_REGION_MARGIN (4)
+
+// and below this size, hardly anything would be inside the margins
+#define MIN_SYNC_REGION_SIZE (4 * SYNC_REGION_MARGIN)
+
+#define NO_SYNC_REGION (0xFFFFFFFFu)
+
+
+karte_t::sync_list_t::~sync_list_t()
+{
+	clear_ptr_vector(regions);
+}
+
 void karte_t::sync_list_t::add(sync_steppable *obj)
 {
 	//assert(!sync_step_running);
+	if(  obj->sync_list_index != sync_steppable::NO_SYNC_LIST_INDEX  ) {
+		// already there
+		return;
+	}
+	vector_tpl<sync_steppable *> &list = groups[ obj->get_sync_group() ];
+	obj->sync_list_group = obj->get_sync_group();
+	obj->sync_list_index = list.get_count();
 	list.append(obj);
 }
 
@@ -4182,37 +4384,256 @@ void karte_t::sync_list_t::remove(sync_steppable *obj)
 		assert(false);
 	}
 	else {
-		list.remove(obj);
+		remove_from_group(obj);
+	}
+}
+
+void karte_t::sync_list_t::remove_from_group(sync_steppable *obj)
+{
+	const uint32 index = obj->sync_list_index;
+	vector_tpl<sync_steppable *> &list = groups[ obj->sync_list_group ];
+	if(  index >= list.get_count()  ||  list[index] != obj  ) {
+		// not in this list
+		return;
+	}
+	obj->sync_list_index = sync_steppable::NO_SYNC_LIST_INDEX;
+	remove_at(list, index);
+}
+
+void karte_t::sync_list_t::remove_at(vector_tpl<sync_steppable *> &list, uint32 index)
+{
+	// the last one takes its place
+	sync_steppable *last = list.pop_back();
+	if(  index < list.get_count()  ) {
+		list[index] = last;
+		last->sync_list_index = index;
 	}
 }
 
 void karte_t::sync_list_t::clear()
 {
-	list.clear();
+	for(  int g=0;  g<sync_steppable::MAX_SYNC_GROUPS;  g++  ) {
+		FOR(vector_tpl<sync_steppable *>, const ss, groups[g]) {
+			ss->sync_list_index = sync_steppable::NO_SYNC_LIST_INDEX;
+		}
+		groups[g].clear();
+	}
+	border_objects.clear();
 	currently_deleting = NULL;
 	sync_step_running = false;
 }
 
-void karte_t::sync_list_t::sync_step(uint32 delta_t)
+void karte_t::sync_list_t::finish_object(sync_steppable *obj, sync_result result)
 {
-	sync_step_running = true;
-	currently_deleting = NULL;
+	if(  result == SYNC_OK  ) {
+		return;
+	}
+	remove_from_group(obj);
+	if(  result == SYNC_DELETE  ) {
+		currently_deleting = obj;
+		delete obj;
+		currently_deleting = NULL;
+	}
+}
+
+void karte_t::sync_list_t::assign_regions(uint32 delta_t, uint16 region_size)
+{
+	const koord size = world->get_size();
+	const sint32 regions_x = (size.x + region_size - 1) / region_size;
+	const sint32 regions_y = (size.y + region_size - 1) / region_size;
+	if(  region_slots.get_count() != (uint32)(regions_x * regions_y)  ) {
+		region_slots.clear();
+		region_slots.resize(regions_x * regions_y);
+		for(  sint32 i=0;  i<regions_x * regions_y;  i++  ) {
+			region_slots.append(NO_SYNC_REGION);
+		}
+	}
+
+	// each region draws its random numbers from its own stream
+	const uint64 seed = (uint64)simrand_plain() << 32;
+
+	active_regions = 0;
+	border_objects.clear();
+	const int region_groups[2] = { sync_steppable::SYNC_GROUP_PRIVATE_CAR, sync_steppable::SYNC_GROUP_PEDESTRIAN };
+	for(  int g=0;  g<2;  g++  ) {
+		FOR(vector_tpl<sync_steppable *>, const ss, groups[ region_groups[g] ]) {
+			const koord pos = ss->get_local_sync_pos(delta_t);
+			if(  pos.x < 0  ||  pos.y < 0  ||  pos.x >= size.x  ||  pos.y >= size.y  ) {
+				// also koord::invalid
+				border_objects.append(ss);
+				continue;
+			}
+			const koord offset( pos.x % region_size, pos.y % region_size );
+			if(  offset.x < SYNC_REGION_MARGIN  ||  offset.y < SYNC_REGION_MARGIN  ||  offset.x >= region_size - SYNC_REGION_MARGIN  ||  offset.y >= region_size - SYNC_REGION_MARGIN  ) {
+				border_objects.append(ss);
+				continue;
+			}
+			const uint32 map_region = (pos.y / region_size) * regions_x + pos.x / region_size;
+			if(  region_slots[map_region] == NO_SYNC_REGION  ) {
+				region_slots[map_region] = active_regions;
+				if(  active_regions == regions.get_count()  ) {
+					regions.append( new sync_region_t() );
+				}
+				sync_region_t &region = *regions[active_regions++];
+				region.min = pos - offset;
+				region.max = region.min + koord( region_size - 1, region_size - 1 );
+				region.random_state = seed | map_region;
+			}
+			regions[ region_slots[map_region] ]->objects.append(ss);
+		}
+	}
 
-	for(uint32 i=0; i<list.get_count();i++) {
-		sync_steppable *ss = list[i];
-		switch(ss->sync_step(delta_t)) {
+	for(  uint32 i=0;  i<active_regions;  i++  ) {
+		const koord min = regions[i]->min;
+		region_slots[ (min.y / region_size) * regions_x + min.x / region_size ] = NO_SYNC_REGION;
+	}
+}
+
+void karte_t::sync_list_t::step_region(sync_region_t &region, uint32 delta_t)
+{
+	sync_region = &region;
+	set_simrand_stream(&region.random_state);
+	FOR(vector_tpl<sync_steppable *>, const ss, region.objects) {
+		switch(  ss->sync_step(delta_t)  ) {
 			case SYNC_OK:
 				break;
 			case SYNC_DELETE:
-				currently_deleting = ss;
-				delete ss;
-				currently_deleting = NULL;
-				/* fall-through */
+				region.deleted.append(ss);
+				break;
 			case SYNC_REMOVE:
-				ss = list.pop_back();
-				if (i < list.get_count()) {
-					list[i] = ss;
-				}
+				region.removed.append(ss);
+				break;
+		}
+	}
+	set_simrand_stream(NULL);
+	sync_region = NULL;
+}
+
+void karte_t::sync_list_t::step_regions(uint32 delta_t)
+{
+	while(  true  ) {
+#ifdef MULTI_THREAD
+		int error = pthread_mutex_lock(&sync_region_mutex);
+		assert(error == 0);
+#endif
+		const uint32 i = sync_region_next++;
+#ifdef MULTI_THREAD
+		error = pthread_mutex_unlock(&sync_region_mutex);
+		assert(error == 0);
+		(void)error;
+#endif
+		if(  i >= active_regions  ) {
+			return;
+		}
+		step_region(*regions[i], delta_t);
+	}
+}
+
+void karte_t::sync_list_t::finish_region(sync_region_t &region)
+{
+	FOR(vector_tpl<sync_steppable *>, const ss, region.deleted) {
+		finish_object(ss, SYNC_DELETE);
+	}
+	FOR(vector_tpl<sync_steppable *>, const ss, region.removed) {
+		finish_object(ss, SYNC_REMOVE);
+	}
+	FOR(vector_tpl<sync_region_t::toll_t>, const& toll, region.tolls) {
+		toll.player->book_toll_received(toll.amount, road_wt);
+	}
+	FOR(vector_tpl<sync_region_t::way_wear_t>, const& wear, region.way_wear) {
+		wear.way->wear_way(wear.wear);
+	}
+	FOR(vector_tpl<sync_region_t::travel_time_t>, const& time, region.travel_times) {
+		weg_t::add_travel_time_update(time.way, time.actual, time.ideal);
+	}
+	FOR(vector_tpl<stadt_t *>, const city, region.queued_cities) {
+		world->add_queued_city(city);
+	}
+	FOR(vector_tpl<koord>, const pos, region.traffic_jams) {
+		private_car_t::add_traffic_jam_message(pos);
+	}
+	FOR(vector_tpl<sync_region_t::pedestrians_t>, const& pedestrians, region.pedestrians) {
+		pedestrian_t::generate_pedestrians_at(pedestrians.pos, pedestrians.count, pedestrians.time_to_live);
+	}
+	FOR(vector_tpl<sync_region_t::dirty_image_t>, const& dirty, region.dirty_images) {
+		display_mark_img_dirty(dirty.image, dirty.x, dirty.y);
+	}
+	for(  int i=0;  i<CHK_DEBUG_SUMS;  i++  ) {
+		world->debug_sums[i] += region.debug_sums[i];
+	}
+
+	region.objects.clear();
+	region.deleted.clear();
+	region.removed.clear();
+	region.tolls.clear();
+	region.way_wear.clear();
+	region.travel_times.clear();
+	region.queued_cities.clear();
+	region.traffic_jams.clear();
+	region.pedestrians.clear();
+	region.dirty_images.clear();
+	region.clear_debug_sums();
+}
+
+void karte_t::sync_list_t::sync_step(uint32 delta_t, uint16 region_size)
+{
+	sync_step_running = true;
+	currently_deleting = NULL;
+
+	for(  int g=0;  g<sync_steppable::MAX_SYNC_GROUPS;  g++  ) {
+		if(  region_size  &&  g == sync_steppable::SYNC_GROUP_PRIVATE_CAR  ) {
+			// The private cars and pedestrians far enough from the edges of their regions only reach
+			// tiles of their region, so each region can be stepped on a thread of its own.
+			assign_regions(delta_t, max(region_size, MIN_SYNC_REGION_SIZE));
+			sync_region_list = this;
+			sync_region_delta_t = delta_t;
+			sync_region_next = 0;
+#ifdef MULTI_THREAD
+			if(  threads_initialised  &&  active_regions > 1  ) {
+				simthread_barrier_wait(&sync_region_barrier);
+				step_regions(delta_t);
+				simthread_barrier_wait(&sync_region_barrier);
+			}
+			else
+#endif
+			{
+				step_regions(delta_t);
+			}
+			sync_region_list = NULL;
+			for(  uint32 i=0;  i<active_regions;  i++  ) {
+				finish_region(*regions[i]);
+			}
+			active_regions = 0;
+
+			// then the others, one after another
+			FOR(vector_tpl<sync_steppable *>, const ss, border_objects) {
+				finish_object(ss, ss->sync_step(delta_t));
+			}
+			border_objects.clear();
+			continue;
+		}
+		if(  region_size  &&  g == sync_steppable::SYNC_GROUP_PEDESTRIAN  ) {
+			// already stepped with the private cars
+			continue;
+		}
+
+		vector_tpl<sync_steppable *> &list = groups[g];
+		for(uint32 i=0; i<list.get_count();i++) {
+			sync_steppable *ss = list[i];
+			switch(ss->sync_step(delta_t)) {
+				case SYNC_OK:
+					break;
+				case SYNC_DELETE:
+					currently_deleting = ss;
+					delete ss;
+					currently_deleting = NULL;
+					remove_at(list, i);
+					break;
+				case SYNC_REMOVE:
+					ss->sync_list_index = sync_steppable::NO_SYNC_LIST_INDEX;
+					remove_at(list, i);
+					break;
+			}
 		}
 	}
 	sync_step_running = false;
@@ -4273,7 +4694,7 @@ void karte_t::sync_step(uint32 delta_t, bool do_sync_step, bool display )
 
 		clear_random_mode( INTERACTIVE_RANDOM );
 
-		sync.sync_step( delta_t );
+		sync.sync_step( delta_t, settings.get_sync_step_region_size() );
 
 		rands[4] = get_random_seed();
 
@@ -4471,8 +4892,26 @@ inline sint32 get_population(stadt_t const* const c)
 }
 
 
+// milliseconds since @p time, which is moved on to now
+static uint32 take_time(uint32 &time)
+{
+	const uint32 now = dr_time();
+	const uint32 ms = now - time;
+	time = now;
+	return ms;
+}
+
+
 void karte_t::new_month()
 {
+	// what is left of the last month has to be rolled over first
+	finish_month_rollover();
+
+	// time each part, to see which one takes longest on large maps
+	const uint32 start_time = dr_time();
+	uint32 pass_time = start_time;
+	const uint16 rollover_steps = settings.get_month_rollover_steps();
+
 	update_history();
 
 	// advance history ...
@@ -4500,15 +4939,29 @@ void karte_t::new_month()
 
 	// this should be done before a map update, since the map may want an update of the way usage
 //	DBG_MESSAGE("karte_t::new_month()","ways");
-	FOR(vector_tpl<weg_t*>, const w, weg_t::get_alle_wege()) {
-		w->new_month();
+	if(  rollover_steps > 0  ) {
+		// ways, convoys and halts are rolled over in the next steps by step_month_rollover()
+		month_rollover_steps_left = rollover_steps;
+		month_rollover_ms[0] = month_rollover_ms[1] = month_rollover_ms[2] = 0;
+		weg_t::start_month_rollover();
+		month_rollover_convoi_next = 0;
+		month_rollover_convoi_end = convoi_array.get_count();
+		haltestelle_t::start_month_rollover();
+	}
+	else {
+		FOR(vector_tpl<weg_t*>, const w, weg_t::get_alle_wege()) {
+			w->new_month();
+		}
 	}
+	const uint32 ways_ms = take_time(pass_time);
 
 	// Update the maximum vehicle speed records to calibrate when passengers should not burden the journey time database.
 	calc_max_vehicle_speeds();
 
-	// recalc old settings (and maybe update the stops with the current values)
-	minimap_t::get_instance()->new_month();
+	if(  rollover_steps == 0  ) {
+		// recalc old settings (and maybe update the stops with the current values)
+		minimap_t::get_instance()->new_month();
+	}
 
 	INT_CHECK("simworld 3042");
 
@@ -4530,14 +4983,18 @@ void karte_t::new_month()
 	if(  playerwin  ) {
 		playerwin->update_data();
 	}
+	const uint32 players_ms = take_time(pass_time);
 
 	INT_CHECK("simworld 3175");
 
 //	DBG_MESSAGE("karte_t::new_month()","convois");
 	// hsiegeln - call new month for convois
-	FOR(vector_tpl<convoihandle_t>, const cnv, convoi_array) {
-		cnv->new_month();
+	if(  rollover_steps == 0  ) {
+		FOR(vector_tpl<convoihandle_t>, const cnv, convoi_array) {
+			cnv->new_month();
+		}
 	}
+	const uint32 convois_ms = take_time(pass_time);
 
 	base_pathing_counter ++;
 
@@ -4623,6 +5080,7 @@ void karte_t::new_month()
 		}
 		count++;
 	}
+	const uint32 factories_ms = take_time(pass_time);
 
 	INT_CHECK("simworld 3105");
 
@@ -4650,14 +5108,18 @@ void karte_t::new_month()
 		// be built instead every month.
 		factory_builder_t::increase_industry_density(true, true, true, 1);
 	}
+	const uint32 cities_ms = take_time(pass_time);
 
 	INT_CHECK("simworld 3130");
 
 //	DBG_MESSAGE("karte_t::new_month()","halts");
-	FOR(vector_tpl<halthandle_t>, const s, haltestelle_t::get_alle_haltestellen()) {
-		s->new_month();
-		INT_CHECK("simworld 1877");
+	if(  rollover_steps == 0  ) {
+		FOR(vector_tpl<halthandle_t>, const s, haltestelle_t::get_alle_haltestellen()) {
+			s->new_month();
+			INT_CHECK("simworld 1877");
+		}
 	}
+	const uint32 halts_ms = take_time(pass_time);
 
 	INT_CHECK("simworld 2522");
 	FOR(slist_tpl<depot_t *>, const& iter, depot_t::get_depot_list())
@@ -4736,6 +5198,13 @@ void karte_t::new_month()
 	passengers_travelled_this_month_with_tolerance_of_under_10_minutes = 0;
 	total_journey_times_this_month = 0;
 #endif
+	const uint32 other_ms = take_time(pass_time);
+
+	if(  rollover_steps > 0  ) {
+		dbg->message("karte_t::new_month()", "Took %u ms: players %u, factories %u, cities %u, other %u; ways, convoys and halts follow in the next %u steps",
+			dr_time() - start_time, players_ms, factories_ms, cities_ms, other_ms, rollover_steps);
+		return;
+	}
 
 #ifdef MULTI_THREAD
 	await_path_explorer();
@@ -4744,6 +5213,59 @@ void karte_t::new_month()
 	// Added by : Knightly
 	// Note		: This should be done after all lines and convoys have rolled their statistics
 	path_explorer_t::refresh_all_categories(false);
+	const uint32 path_explorer_ms = take_time(pass_time);
+
+	dbg->message("karte_t::new_month()", "Took %u ms: ways %u, players %u, convoys %u, factories %u, cities %u, halts %u, path explorer %u, other %u",
+		dr_time() - start_time, ways_ms, players_ms, convois_ms, factories_ms, cities_ms, halts_ms, path_explorer_ms, other_ms);
+}
+
+
+void karte_t::step_month_rollover()
+{
+	// share out what is left evenly over the remaining steps, so this is the same on all clients
+	const uint32 steps_left = month_rollover_steps_left;
+	uint32 pass_time = dr_time();
+
+	weg_t::step_month_rollover( (weg_t::get_month_rollover_pending() + steps_left - 1) / steps_left );
+	month_rollover_ms[0] += take_time(pass_time);
+
+	const uint32 convois_pending = month_rollover_convoi_end - month_rollover_convoi_next;
+	const uint32 convoi_end = month_rollover_convoi_next + (convois_pending + steps_left - 1) / steps_left;
+	while(  month_rollover_convoi_next < convoi_end  &&  month_rollover_convoi_next < month_rollover_convoi_end  ) {
+		// the index moves on first, as a convoy may remove itself
+		convoihandle_t const cnv = convoi_array[month_rollover_convoi_next++];
+		cnv->new_month();
+	}
+	month_rollover_ms[1] += take_time(pass_time);
+
+	haltestelle_t::step_month_rollover( (haltestelle_t::get_month_rollover_pending() + steps_left - 1) / steps_left );
+	month_rollover_ms[2] += take_time(pass_time);
+
+	if(  --month_rollover_steps_left > 0  ) {
+		return;
+	}
+
+	// recalc old settings (and maybe update the stops with the current values)
+	minimap_t::get_instance()->new_month();
+
+#ifdef MULTI_THREAD
+	await_path_explorer();
+#endif
+	// This should be done after all lines and convoys have rolled their statistics
+	path_explorer_t::refresh_all_categories(false);
+
+	dbg->message("karte_t::step_month_rollover()", "Month rollover finished: ways %u ms, convoys %u ms, halts %u ms, path explorer %u ms",
+		month_rollover_ms[0], month_rollover_ms[1], month_rollover_ms[2], take_time(pass_time));
+}
+
+
+void karte_t::finish_month_rollover()
+{
+	if(  month_rollover_steps_left > 0  ) {
+		// the last step does all that is left
+		month_rollover_steps_left = 1;
+		step_month_rollover();
+	}
 }
 
 
@@ -4915,8 +5437,6 @@ void karte_t::pause_step()
 {
 	// Check the private car routes. In multi-threaded mode, this can be running in the background whilst a number of other steps are processed.
 	// This is computationally intensive, but intermittently. The computational intensity increases exponentially with the size of the map.
-	const sint32 parallel_operations = get_parallel_operations();
-
 	if (!private_car_route_check_complete && cities_awaiting_private_car_route_check.empty())
 	{
 		refresh_private_car_routes();
@@ -4928,16 +5448,9 @@ void karte_t::pause_step()
 	{
 #ifdef MULTI_THREAD
 		// This cannot be started at the end of the step, as we will not know at that point whether we need to call this at all.
-		// There can be many mutex clashes with this; however, processing only one city at a time can make it take an unfeasible amount of time to refresh all routes.
-		//cities_to_process = stadt.get_count() > 64 ? 1 : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
-		//cities_to_process = 1;
-		if (cities_to_process <= 0 || cities_awaiting_private_car_route_check.get_count() > parallel_operations - 1)
-		{
-			cities_to_process = min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
-		}
 		start_private_car_threads();
 #else
-		const sint32 cities_to_process = env_t::networkmode ? 1 : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
+		const sint32 cities_to_process = env_t::networkmode ? 1 : min(cities_awaiting_private_car_route_check.get_count(), get_parallel_operations() - 1);
 		for (sint32 j = 0; j < cities_to_process; j++)
 		{
 			stadt_t* city = cities_awaiting_private_car_route_check.remove_first();
@@ -4995,6 +5508,9 @@ void karte_t::step()
 		DBG_DEBUG4("karte_t::step", "calling new_month");
 		new_month();
 	}
+	else if(  month_rollover_steps_left > 0  ) {
+		step_month_rollover();
+	}
 	rands[9] = get_random_seed();
 
 	DBG_DEBUG4("karte_t::step", "time calculations");
@@ -5061,8 +5577,6 @@ void karte_t::step()
 	const bool check_city_routes = true;
 	if (check_city_routes)
 	{
-		const sint32 parallel_operations = get_parallel_operations();
-
 		if (cities_awaiting_private_car_route_check.empty() && cities_to_process <= 0)
 		{
 			refresh_private_car_routes();
@@ -5071,21 +5585,11 @@ void karte_t::step()
 
 #ifdef MULTI_THREAD
 		// This cannot be started at the end of the step, as we will not know at that point whether we need to call this at all.
-		// There can be many mutex clashes with this; however, processing only one city at a time can make it take an unfeasible amount of time to refresh all routes.
-
-		// Also, processing multiple cities when mutli-threaded is not network safe. The reasons for this are unclear, but this remains so even after
-		// the implementation of rwlocks for the private car routing data in January 2021. It is suspected that hte route finding algorithm is not
-		// deterministic for any given starting point, but investigations have so far not revealed whether this is the real problem or how or in what way(s) that
-		// this is not deterministic.
-
-		// For this reason, multi-threading is disabled when using network mode with clients connected until the problem can be solved.
-		if (cities_to_process <= 0 || cities_awaiting_private_car_route_check.get_count() > parallel_operations - 1)
-		{
-			cities_to_process = env_t::networkmode ? min(1, cities_awaiting_private_car_route_check.get_count()) : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
-		}
+		// Each thread checks one city at a time. Which thread checks which city, and how much of the check is done in each step,
+		// is fixed, and the routes found are applied in the order of the cities, so this is deterministic also in network games.
 		start_private_car_threads();
 #else
-		const sint32 cities_to_process = min(cities_awaiting_private_car_route_check.get_count(), env_t::networkmode ? 1 : parallel_operations - 1);
+		const sint32 cities_to_process = min(cities_awaiting_private_car_route_check.get_count(), env_t::networkmode ? 1 : get_parallel_operations() - 1);
 
 		for (sint32 j = 0; j < cities_to_process; j++)
 		{
@@ -5222,8 +5726,8 @@ void karte_t::step()
 #endif
 
 	// This is quite computationally intensive, but not as much as the path explorer. It can be more or less than the convoys, depending on the map.
-	// Multi-threading the passenger and mail generation is currently not working well as dividing the number of passengers/mail to be generated per
-	//step by the number of parallel operations introduces significant rounding errors.
+	// The number of passengers/mail to be generated is split between the threads in whole packets (see shard_step_budget()),
+	// each thread reseeds its random numbers from passenger_generation_seed, and what they generate is merged in the order of the threads below.
 #ifdef MULTI_THREAD_PASSENGER_GENERATION
 
 #ifdef FORBID_MULTI_THREAD_PASSENGER_GENERATION_IN_NETWORK_MODE
@@ -5252,6 +5756,8 @@ void karte_t::step()
 			debug_sums[6] += transferring_cargoes[i].get_count();
 		}
 
+		update_passenger_samplers();
+		passenger_generation_seed = get_random_seed();
 		start_passengers_and_mail_threads();
 
 #ifdef FORBID_MULTI_THREAD_PASSENGER_GENERATION_IN_NETWORK_MODE
@@ -5300,11 +5806,34 @@ void karte_t::step()
 	}
 
 #ifdef MULTI_THREAD
+	const sint32 passenger_generation_buffers = get_parallel_operations() + 2;
+	for (sint32 i = 0; i < passenger_generation_buffers; i++)
+	{
+		FOR(vector_tpl<generated_passengers_t>, const& generated, generated_passengers_threaded[i])
+		{
+			generated.city->set_generated_passengers(generated.units, generated.type);
+			if (generated.count_in_debug_sums)
+			{
+				add_to_debug_sums(5, generated.units);
+			}
+		}
+		generated_passengers_threaded[i].clear();
+
+		FOR(vector_tpl<started_passengers_t>, const& started, started_passengers_threaded[i])
+		{
+			if (started.halt.is_bound())
+			{
+				started.halt->starte_mit_route(started.ware, started.origin_pos);
+			}
+		}
+		started_passengers_threaded[i].clear();
+	}
+
 	// This is necessary in network mode to ensure that all cars set in motion
 	// by passenger generation are added to the world list in the same order
 	// even when the creation of those objects was multi-threaded.
 #ifndef FORBID_SYNC_OBJECTS
-	for (uint32 i = 0; i < get_parallel_operations() + 2; i++)
+	for (sint32 i = 0; i < passenger_generation_buffers; i++)
 	{
 		FOR(vector_tpl<private_car_t*>, car, private_cars_added_threaded[i])
 		{
@@ -5486,6 +6015,7 @@ void karte_t::refresh_private_car_routes() {
 #ifdef MULTI_THREAD
 	suspend_private_car_threads();
 #endif
+	weg_t::private_car_route_map::compact(weg_t::get_private_car_routes_currently_writing_element());
 	weg_t::swap_private_car_routes_currently_reading_element();
 	clear_private_car_routes();
 	for(auto & city : stadt) {
@@ -5493,17 +6023,54 @@ void karte_t::refresh_private_car_routes() {
 	}
 }
 
+void karte_t::check_all_private_car_routes(bool threaded)
+{
+#ifdef MULTI_THREAD
+	suspend_private_car_threads();
+#endif
+	clear_private_car_routes();
+	cities_awaiting_private_car_route_check.clear();
+	for(auto & city : stadt) {
+		cities_awaiting_private_car_route_check.append(city);
+	}
+
+#ifdef MULTI_THREAD
+	if (threaded)
+	{
+		while (!cities_awaiting_private_car_route_check.empty() || cities_to_process > 0)
+		{
+			start_private_car_threads();
+			await_private_car_threads();
+		}
+	}
+	else
+	{
+		// The check must not halt at the end of the step's part of it, as this is not one of the threads.
+		route_t::suspend_private_car_routing = true;
+	}
+#else
+	(void)threaded;
+#endif
+	while (!cities_awaiting_private_car_route_check.empty())
+	{
+		cities_awaiting_private_car_route_check.remove_first()->check_all_private_car_routes();
+	}
+#ifdef MULTI_THREAD
+	route_t::suspend_private_car_routing = false;
+#endif
+
+	// read the routes found, and check them all again in the step
+	refresh_private_car_routes();
+	private_car_route_check_complete = false;
+}
+
 void karte_t::clear_private_car_routes() {
-	weg_t::private_car_route_map::route_map_lock();
 	for(auto & w : weg_t::get_alle_wege()) {
 		for(auto & l : w->private_car_routes[weg_t::get_private_car_routes_currently_writing_element()]) {
 			l.pre_reset();
 		}
 	}
 	weg_t::private_car_route_map::reset(weg_t::get_private_car_routes_currently_writing_element());
-
-	weg_t::private_car_route_map::route_map_unlock();
-
 }
 
 void karte_t::step_time_interval_signals()
@@ -5542,6 +6109,21 @@ void karte_t::step_time_interval_signals()
 	}
 }
 
+void karte_t::update_passenger_samplers()
+{
+	// Every packet picks an origin and at least one destination.
+	const uint32 passenger_packets = passenger_step_interval > 0 ? max(next_step_passenger, 0) / passenger_step_interval : 0;
+	const uint32 mail_packets = mail_step_interval > 0 ? max(next_step_mail, 0) / mail_step_interval : 0;
+
+	passenger_origins_sampler.update(passenger_origins, passenger_packets);
+	mail_origins_and_targets_sampler.update(mail_origins_and_targets, mail_packets * 2);
+	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
+	{
+		commuter_targets_samplers[i].update(commuter_targets[i], passenger_packets);
+		visitor_targets_samplers[i].update(visitor_targets[i], passenger_packets);
+	}
+}
+
 sint32 karte_t::calc_adjusted_step_interval(const uint32 weight, uint32 trips_per_month_hundredths) const
 {
 	const uint32 median_packet_size = (uint32)(get_settings().get_passenger_routing_packet_size() + 1) / 2;
@@ -5560,6 +6142,8 @@ void karte_t::step_passengers_and_mail(uint32 delta_t)
 	next_step_passenger += delta_t;
 	next_step_mail += delta_t;
 
+	update_passenger_samplers();
+
 	// The generate passengers function is called many times (often well > 100) each step; the mail version is called only once or twice each step, sometimes not at all.
 	sint32 units_this_step;
 	while(passenger_step_interval <= next_step_passenger)
@@ -5749,6 +6333,37 @@ void karte_t::deposit_ware_at_destination(ware_t ware)
 	}
 }
 
+void karte_t::book_generated_passengers(stadt_t *city, uint32 units, int type, bool count_in_debug_sums)
+{
+#ifdef MULTI_THREAD
+	generated_passengers_t generated;
+	generated.city = city;
+	generated.units = units;
+	generated.type = type;
+	generated.count_in_debug_sums = count_in_debug_sums;
+	generated_passengers_threaded[passenger_generation_thread_number].append(generated);
+#else
+	city->set_generated_passengers(units, type);
+	if (count_in_debug_sums)
+	{
+		add_to_debug_sums(5, units);
+	}
+#endif
+}
+
+void karte_t::start_passengers_at(halthandle_t halt, const ware_t &ware, koord origin_pos)
+{
+#ifdef MULTI_THREAD
+	started_passengers_t started;
+	started.halt = halt;
+	started.ware = ware;
+	started.origin_pos = origin_pos;
+	started_passengers_threaded[passenger_generation_thread_number].append(started);
+#else
+	halt->starte_mit_route(ware, origin_pos);
+#endif
+}
+
 sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 {
 	const city_cost history_type = (wtyp == goods_manager_t::passengers) ? HIST_PAS_TRANSPORTED : HIST_MAIL_TRANSPORTED;
@@ -5758,14 +6373,12 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 	if(wtyp == goods_manager_t::passengers)
 	{
 		// Pick a passenger building at random
-		const uint32 weight = simrand(passenger_origins.get_sum_weight() - 1, "void karte_t::generate_passengers_and_mail(uint32 delta_t) pick origin building (passengers)");
-		gb = passenger_origins.at_weight(weight);
+		gb = pick_any_weighted(passenger_origins_sampler, passenger_origins);
 	}
 	else
 	{
 		// Pick a mail building at random
-		const uint32 weight = simrand(mail_origins_and_targets.get_sum_weight() - 1, "void karte_t::generate_passengers_and_mail(uint32 delta_t) pick origin building (mail)");
-		gb = mail_origins_and_targets.at_weight(weight);
+		gb = pick_any_weighted(mail_origins_and_targets_sampler, mail_origins_and_targets);
 	}
 
 	stadt_t* city = gb->get_stadt();
@@ -5777,18 +6390,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 	{
 		// Mail is generated in non-city buildings such as attractions.
 		// That will be the only legitimate case in which this condition is not fulfilled.
-#ifdef MULTI_THREAD
-		int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-#endif
-		city->set_generated_passengers(units_this_step, history_type + 1);
-		add_to_debug_sums(5, units_this_step);
-#ifdef MULTI_THREAD
-		mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-#endif
+		book_generated_passengers(city, units_this_step, history_type + 1, true);
 	}
 
 	koord3d origin_pos = gb->get_pos();
@@ -5956,17 +6558,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// Added here as the original journey had its generated passengers set much earlier, outside the for loop.
 			if(city)
 			{
-#ifdef MULTI_THREAD
-				int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-				(void)mutex_error;
-#endif
-				city->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-				(void)mutex_error;
-#endif
+				book_generated_passengers(city, units_this_step, history_type + 1);
 			}
 
 			if(route_status != private_car)
@@ -6611,21 +7203,13 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 		switch(route_status)
 		{
 		case public_transport:
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			if(tolerance < UINT32_MAX_VALUE)
 			{
 				tolerance -= best_journey_time;
 				walking_tolerance -= best_journey_time;
 			}
 			pax.set_origin(start_halt);
-			start_halt->starte_mit_route(pax, origin_pos.get_2d());
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
+			start_passengers_at(start_halt, pax, origin_pos.get_2d());
 			if(city && wtyp == goods_manager_t::passengers)
 			{
 				city->merke_passagier_ziel(destination_pos, color_idx_to_rgb(MAP_COL_HAPPY));
@@ -6737,15 +7321,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			{
 				first_origin->add_mail_delivery_succeeded(units_this_step);
 			}
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			add_to_waiting_list(pax, origin_pos.get_2d());
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			break;
 
 		case on_foot:
@@ -6815,19 +7391,8 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			{
 				first_origin->add_mail_delivery_succeeded(units_this_step);
 			}
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-
-			// Prevent deadlocks because of double-locking:
-			// there is already a mutex lock in the add_to_waiting_list
-#endif
 			add_to_waiting_list(pax, origin_pos.get_2d());
 			// Do nothing if trip == mail.
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			break;
 
 		case overcrowded:
@@ -6949,29 +7514,13 @@ no_route:
 			if(destination_town)
 			{
 #ifndef FORBID_SET_GENERATED_PASSENGERS
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
-				destination_town->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
+				book_generated_passengers(destination_town, units_this_step, history_type + 1);
 #endif
 			}
 			else if(city)
 			{
 #ifndef FORBID_SET_GENERATED_PASSENGERS
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
-				city->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
+				book_generated_passengers(city, units_this_step, history_type + 1);
 #endif
 				// Cannot add success figures for buildings here as cannot get a building from a koord.
 				// However, this should not matter much, as equally not recording generated passengers
@@ -7075,7 +7624,7 @@ no_route:
 						if (!return_halt_is_overcrowded)
 						{
 #ifndef FORBID_STARTE_MIT_ROUTE_FOR_RETURNING_PASSENGERS
-							ret_halt->starte_mit_route(return_passengers, pax.get_zielpos());
+							start_passengers_at(ret_halt, return_passengers, pax.get_zielpos());
 #endif
 							if (current_destination.type == factory && (trip == commuting_trip || trip == mail_trip))
 							{
@@ -7272,16 +7821,16 @@ karte_t::destination karte_t::find_destination(trip_type trip, uint8 g_class)
 	switch(trip)
 	{
 	case commuting_trip:
-		gb = pick_any_weighted(commuter_targets[g_class]);
+		gb = pick_any_weighted(commuter_targets_samplers[g_class], commuter_targets[g_class]);
 		break;
 
 	case visiting_trip:
-		gb = pick_any_weighted(visitor_targets[g_class]);
+		gb = pick_any_weighted(visitor_targets_samplers[g_class], visitor_targets[g_class]);
 		break;
 
 	default:
 	case mail_trip:
-		gb = pick_any_weighted(mail_origins_and_targets);
+		gb = pick_any_weighted(mail_origins_and_targets_sampler, mail_origins_and_targets);
 	};
 	if(!gb)
 	{
@@ -7874,6 +8423,89 @@ DBG_MESSAGE("karte_t::save()", "saving game to '%s'", filename);
 }
 
 
+#ifdef MULTI_THREAD
+/// A band of map rows serialised by save_tiles_loop()
+struct save_tiles_band_t
+{
+	memory_rdwr_stream_t *stream;
+	stream_loadsave_t *file;
+};
+
+// The rows of the current round of save_tiles_threaded(), the file they are appended to,
+// and their bands, by the first row of each band in the round
+static sint16 save_tiles_round_y = 0;
+static sint16 save_tiles_round_rows = 0;
+static const loadsave_t *save_tiles_file = NULL;
+static save_tiles_band_t *save_tiles_bands = NULL;
+
+
+void karte_t::save_tiles_loop(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
+{
+	// world_xy_loop() splits all rows of the map among the threads: take the same share of the rows of this round
+	const sint16 y_begin = save_tiles_round_y + (sint16)(((sint32)y_min * save_tiles_round_rows) / cached_grid_size.y);
+	const sint16 y_end = save_tiles_round_y + (sint16)(((sint32)y_max * save_tiles_round_rows) / cached_grid_size.y);
+	if(  y_begin >= y_end  ) {
+		return;
+	}
+
+	save_tiles_band_t &band = save_tiles_bands[y_begin - save_tiles_round_y];
+	band.stream = new memory_rdwr_stream_t();
+	band.file = new stream_loadsave_t(band.stream, save_tiles_file);
+	for(  sint16 y=y_begin;  y<y_end;  y++  ) {
+		for(  sint16 x=x_min;  x<x_max;  x++  ) {
+			plan[x+y*cached_grid_size.x].rdwr(band.file, koord(x, y));
+		}
+	}
+}
+
+
+void karte_t::save_tiles_threaded(loadsave_t *file, loadingscreen_t *ls)
+{
+	// Saving a tile only reads the world, so the bands can be serialised at the same time by the world threads.
+	// Each round has one band per thread; the bands are then appended in map order,
+	// so the file is the same as if it had been saved by a single thread.
+	// The rounds only limit how much of the map is held in memory at once.
+	const sint16 rows_per_band = (sint16)max(1, (1 << 18) / get_size().x);
+	const sint16 rows_per_round = (sint16)min(get_size().y, rows_per_band * env_t::num_threads);
+	save_tiles_file = file;
+	save_tiles_bands = new save_tiles_band_t[rows_per_round];
+
+	for(  sint16 y=0;  y<get_size().y;  y+=save_tiles_round_rows  ) {
+		save_tiles_round_y = y;
+		save_tiles_round_rows = (sint16)min(rows_per_round, get_size().y - y);
+		for(  sint16 r=0;  r<save_tiles_round_rows;  r++  ) {
+			save_tiles_bands[r].file = NULL;
+		}
+
+		world_xy_loop(&karte_t::save_tiles_loop, 0);
+
+		for(  sint16 r=0;  r<save_tiles_round_rows;  r++  ) {
+			save_tiles_band_t &band = save_tiles_bands[r];
+			if(  band.file == NULL  ) {
+				continue;
+			}
+			if(  band.stream->get_status() != rdwr_stream_t::STATUS_OK  ) {
+				dbg->fatal("karte_t::save_tiles_threaded()", "Out of memory while saving tiles");
+			}
+			file->wr_raw(band.stream->get_data(), band.stream->get_size());
+			delete band.file; // also deletes the stream
+		}
+
+		if(!ls) {
+			INT_CHECK("saving");
+		}
+		else {
+			ls->set_progress(y + save_tiles_round_rows);
+		}
+	}
+
+	delete [] save_tiles_bands;
+	save_tiles_bands = NULL;
+	save_tiles_file = NULL;
+}
+#endif
+
+
 void karte_t::save(loadsave_t *file, bool silent)
 {
 	bool needs_redraw = false;
@@ -7886,6 +8518,9 @@ DBG_MESSAGE("karte_t::save(loadsave_t *file)", "start");
 #ifdef MULTI_THREAD
 	await_all_threads();
 #endif
+	// savegames hold no half rolled over month
+	finish_month_rollover();
+
 	// rotate the map until it can be saved completely
 	for( int i=0;  i<4  &&  nosave_warning;  i++  ) {
 		rotate90();
@@ -8544,15 +9179,23 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 		}
 	}
 	else {
-		for(int j=0; j<get_size().y; j++) {
-			for(int i=0; i<get_size().x; i++) {
-				plan[i+j*cached_grid_size.x].rdwr(file, koord(i,j) );
-			}
-			if(!ls) {
-				INT_CHECK("saving");
-			}
-			else {
-				ls->set_progress(j);
+#ifdef MULTI_THREAD
+		if(  !file->is_xml()  &&  env_t::num_threads > 1  ) {
+			save_tiles_threaded(file, ls);
+		}
+		else
+#endif
+		{
+			for(int j=0; j<get_size().y; j++) {
+				for(int i=0; i<get_size().x; i++) {
+					plan[i+j*cached_grid_size.x].rdwr(file, koord(i,j) );
+				}
+				if(!ls) {
+					INT_CHECK("saving");
+				}
+				else {
+					ls->set_progress(j);
+				}
 			}
 		}
 	DBG_MESSAGE("karte_t::save(loadsave_t *file)", "saved tiles");
@@ -9199,6 +9842,8 @@ void karte_t::load(loadsave_t *file)
 #endif
 
 	tile_counter = 0;
+	month_rollover_steps_left = 0;
+	month_rollover_convoi_next = month_rollover_convoi_end = 0;
 	simloops = 60;
 
 	rdwr_gamestate(file, &ls);
@@ -9307,6 +9952,30 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 	}
 	haltestelle_t::end_load_game();
 
+#ifdef DEBUG
+	{
+		// memory taken by goods packets, by where they are
+		uint32 waiting_packets = 0, transferring_packets = 0, travelling_packets = 0;
+		FOR(vector_tpl<halthandle_t>, const halt, haltestelle_t::get_alle_haltestellen()) {
+			waiting_packets += halt->get_waiting_packet_count();
+			transferring_packets += halt->get_transferring_cargoes_count();
+		}
+		FOR(vector_tpl<convoihandle_t>, const cnv, convoi_array) {
+			for(  uint8 i=0;  i<cnv->get_vehicle_count();  i++  ) {
+				const vehicle_t *v = cnv->get_vehicle(i);
+				for(  uint8 j=0;  j<v->get_desc()->get_number_of_classes();  j++  ) {
+					travelling_packets += v->get_cargo(j).get_count();
+				}
+			}
+		}
+		DBG_MESSAGE("karte_t::load()", "goods packets (%d bytes each): %u waiting at stops (%u kB), %u transferring (%u kB), %u in vehicles (%u kB)",
+			(int)sizeof(ware_t),
+			waiting_packets, (uint32)(((uint64)waiting_packets * sizeof(ware_t)) >> 10),
+			transferring_packets, (uint32)(((uint64)transferring_packets * sizeof(transferring_cargo_t)) >> 10),
+			travelling_packets, (uint32)(((uint64)travelling_packets * (sizeof(ware_t) + sizeof(void *))) >> 10) );
+	}
+#endif
+
 	// register all line stops and change line types, if needed
 	for(int i=0; i<MAX_PLAYER_COUNT ; i++) {
 		if(  players[i]  ) {
@@ -9613,6 +10282,9 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 		}
 
 		file->rdwr_long(cities_to_process);
+		// No check is in progress after loading: checks are completed before saving.
+		// (Older versions saved the number of cities to be checked next here.)
+		cities_to_process = 0;
 	}
 
 	// MUST be at the end of the load/save routine.
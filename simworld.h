@@ -15,6 +15,7 @@
 #include "halthandle_t.h"
 
 #include "tpl/weighted_vector_tpl.h"
+#include "tpl/alias_sampler_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/slist_tpl.h"
 #include "tpl/koordhashtable_tpl.h"
@@ -27,6 +28,9 @@
 #include "simware.h"
 #include "simplan.h"
 #include "simdebug.h"
+#include "ifc/sync_steppable.h"
+#include "display/simimg.h"
+#include "display/scr_coord.h"
 
 #include "utils/checklist.h"
 
@@ -50,7 +54,6 @@ class grund_t;
 class planquadrat_t;
 class main_view_t;
 class interaction_t;
-class sync_steppable;
 class tool_t;
 class scenario_t;
 class message_t;
@@ -62,6 +65,8 @@ class memory_rw_t;
 class viewport_t;
 class loadingscreen_t;
 class terraformer_t;
+class weg_t;
+class player_t;
 
 
 #define CHK_RANDS 32
@@ -641,6 +646,17 @@ private:
 	 */
 	uint32 tile_counter;
 
+	/**
+	 * Used to distribute rolling over ways, convoys and halts into a new month
+	 * to several steps. Convoys from index month_rollover_convoi_next up to
+	 * month_rollover_convoi_end of convoi_array still have to be rolled over.
+	 */
+	uint16 month_rollover_steps_left;
+	uint32 month_rollover_convoi_next;
+	uint32 month_rollover_convoi_end;
+	// milliseconds spent so far on the ways, convoys and halts
+	uint32 month_rollover_ms[3];
+
 	/**
 	 * To identify different stages of the same game.
 	 */
@@ -667,6 +683,18 @@ private:
 	 */
 	void new_month();
 
+	/**
+	 * Rolls the next ways, convoys and halts over into the month started by
+	 * new_month(), when month_rollover_steps spreads this over several steps.
+	 */
+	void step_month_rollover();
+
+	/**
+	 * Rolls all ways, convoys and halts still left over into the new month,
+	 * e.g. before saving or before the next month starts.
+	 */
+	void finish_month_rollover();
+
 	/**
 	 * Yearly actions.
 	 */
@@ -676,6 +704,17 @@ private:
 	 * Internal saving method.
 	 */
 	void save(loadsave_t *file, bool silent);
+
+#ifdef MULTI_THREAD
+	/**
+	 * Saves the tiles in bands of rows serialised in parallel,
+	 * which are then appended to @p file in map order.
+	 */
+	void save_tiles_threaded(loadsave_t *file, loadingscreen_t *ls);
+
+	/// Serialises the tiles of a band of the current round of save_tiles_threaded()
+	void save_tiles_loop(sint16, sint16, sint16, sint16);
+#endif
 public:
 	/**
 	 * Internal loading method.
@@ -806,6 +845,21 @@ private:
 	 */
 	weighted_vector_tpl <gebaeude_t *> mail_origins_and_targets;
 
+	/**
+	 * O(1) pickers for the above buildings (the targets indexed by class),
+	 * updated before each passenger generation by update_passenger_samplers().
+	 */
+	alias_sampler_tpl <gebaeude_t *> passenger_origins_sampler;
+	alias_sampler_tpl <gebaeude_t *> *commuter_targets_samplers;
+	alias_sampler_tpl <gebaeude_t *> *visitor_targets_samplers;
+	alias_sampler_tpl <gebaeude_t *> mail_origins_and_targets_sampler;
+
+	/**
+	 * Rebuilds the stale pickers of passenger origins and targets once they
+	 * would pay off. Must not be called while passengers are generated.
+	 */
+	void update_passenger_samplers();
+
 	/** Stores the value of the next step for passenger/mail generation
 	 * purposes.
 	 */
@@ -815,6 +869,12 @@ private:
 	sint32 passenger_step_interval = 1;
 	sint32 mail_step_interval;
 
+	/**
+	 * Taken from the game random number generator before each passenger
+	 * generation, so the threads can seed their streams deterministically.
+	 */
+	uint32 passenger_generation_seed;
+
 	// Signals in the time interval working method that need
 	// to be checked periodically to see whether they need
 	// to change to a less restrictive aspect.
@@ -865,6 +925,8 @@ public:
 	void start_passengers_and_mail_threads();
 	void start_convoy_threads();
 	void start_path_explorer();
+	// Called from the path explorer thread: steps the compartments to be processed concurrently and waits for them.
+	void step_path_explorer_compartments();
 	void start_private_car_threads(bool override_suspend = false);
 #else
 public:
@@ -901,6 +963,19 @@ private:
 
 	sint32 generate_passengers_or_mail(const goods_desc_t * wtyp);
 
+	/**
+	 * Books passengers/mail generated in @p city.
+	 * In threads, this is deferred and booked after the passenger generation in the order of the threads.
+	 */
+	void book_generated_passengers(stadt_t *city, uint32 units, int type, bool count_in_debug_sums = false);
+
+	/**
+	 * Starts the journey of @p ware at @p halt.
+	 * In threads, this is deferred and done after the passenger generation in the order of the threads,
+	 * so that what waits at the halts does not depend on which thread got there first.
+	 */
+	void start_passengers_at(halthandle_t halt, const ware_t &ware, koord origin_pos);
+
 	destination find_destination(trip_type trip, uint8 g_class);
 
 	static sint32 cities_to_process;
@@ -910,7 +985,9 @@ private:
 	friend void *step_passengers_and_mail_threaded(void* args);
 	friend void *step_convoys_threaded(void* args);
 	friend void *path_explorer_threaded(void* args);
+	friend void *step_path_explorer_compartments_threaded(void* args);
 	friend void *step_individual_convoy_threaded(void* args);
+	friend void *step_sync_regions_threaded(void* args);
 	static vector_tpl<convoihandle_t> convoys_next_step;
 	public:
 	static bool threads_initialised;
@@ -919,6 +996,23 @@ private:
 	static vector_tpl<private_car_t*> *private_cars_added_threaded;
 	static vector_tpl<pedestrian_t*> *pedestrians_added_threaded;
 
+	struct generated_passengers_t
+	{
+		stadt_t *city;
+		uint32 units;
+		sint32 type;
+		bool count_in_debug_sums;
+	};
+	static vector_tpl<generated_passengers_t> *generated_passengers_threaded;
+
+	struct started_passengers_t
+	{
+		halthandle_t halt;
+		ware_t ware;
+		koord origin_pos;
+	};
+	static vector_tpl<started_passengers_t> *started_passengers_threaded;
+
 	static thread_local uint32 passenger_generation_thread_number;
 	static thread_local uint32 marker_index;
 
@@ -954,7 +1048,16 @@ public:
 
 	void set_rands(uint8 num, uint32 val) { rands[num] = val; }
 	void inc_rands(uint8 num) { rands[num]++; }
-	inline void add_to_debug_sums(uint8 num, uint32 val) { debug_sums[num] += val; }
+	inline void add_to_debug_sums(uint8 num, uint32 val)
+	{
+		if(  sync_region  ) {
+			// added after all regions, see sync_list_t::sync_step()
+			sync_region->debug_sums[num] += val;
+		}
+		else {
+			debug_sums[num] += val;
+		}
+	}
 
 
 	/**
@@ -1089,6 +1192,13 @@ public:
 	uint32 get_cities_to_process() const { return cities_to_process; }
 #endif
 
+	/**
+	 * Checks the private car routes of all cities at once rather than over the next steps, and then reads them.
+	 * If threaded, the cities are checked by the private car route threads as in the step,
+	 * otherwise one after the other on this thread.
+	 */
+	void check_all_private_car_routes(bool threaded);
+
 #ifdef MULTI_THREAD
 	/**
 	* @returns true if threads are being terminated
@@ -2158,20 +2268,103 @@ public:
 	// rotate map view by 90 degrees
 	void rotate90();
 
+	/**
+	 * A square region of the map whose private cars and pedestrians are stepped
+	 * on one thread, in parallel with those of the other regions.
+	 * Whatever they do to things which other regions may also reach is kept back
+	 * here and done after all regions, in the order of the regions, so that the
+	 * result does not depend on the number of threads.
+	 */
+	class sync_region_t {
+		public:
+			struct toll_t { player_t *player; sint64 amount; };
+			struct way_wear_t { weg_t *way; uint32 wear; };
+			struct travel_time_t { weg_t *way; uint32 actual; uint32 ideal; };
+			struct pedestrians_t { koord3d pos; uint32 count; uint32 time_to_live; };
+			struct dirty_image_t { image_id image; scr_coord_val x, y; };
+
+			/// the tiles of this region
+			koord min, max;
+			/// stepped in this order
+			vector_tpl<sync_steppable *> objects;
+			/// state of simrand() while this region is stepped
+			uint64 random_state;
+
+			/// objects which returned SYNC_DELETE or SYNC_REMOVE
+			vector_tpl<sync_steppable *> deleted;
+			vector_tpl<sync_steppable *> removed;
+
+			vector_tpl<toll_t> tolls;
+			vector_tpl<way_wear_t> way_wear;
+			vector_tpl<travel_time_t> travel_times;
+			vector_tpl<pedestrians_t> pedestrians;
+			vector_tpl<stadt_t *> queued_cities;
+			vector_tpl<koord> traffic_jams;
+			vector_tpl<dirty_image_t> dirty_images;
+			uint32 debug_sums[CHK_DEBUG_SUMS];
+
+			sync_region_t() : random_state(0) { clear_debug_sums(); }
+
+			/// whether @p k and all its neighbours are in this region
+			bool is_inside(koord k) const { return min.x < k.x  &&  k.x < max.x  &&  min.y < k.y  &&  k.y < max.y; }
+
+			void clear_debug_sums() { for(  int i=0;  i<CHK_DEBUG_SUMS;  i++  ) { debug_sums[i] = 0; } }
+	};
+
+private:
+	static thread_local sync_region_t *sync_region;
+
+public:
+	/// the region whose objects the calling thread steps, NULL when not stepping by regions
+	static sync_region_t *get_sync_region() { return sync_region; }
+
 	class sync_list_t {
 			friend class karte_t;
 		public:
-			sync_list_t() : currently_deleting(NULL), sync_step_running(false) {}
+			sync_list_t() : currently_deleting(NULL), sync_step_running(false), active_regions(0) {}
+			~sync_list_t();
 			void add(sync_steppable *obj);
+			/// in O(1), as the objects know where they are
 			void remove(sync_steppable *obj);
 		private:
-			void sync_step(uint32 delta_t);
+			/**
+			 * With @p region_size, the private cars and pedestrians which only reach tiles around them
+			 * are stepped by square regions of that many tiles in parallel, and the others afterwards.
+			 */
+			void sync_step(uint32 delta_t, uint16 region_size = 0);
 			/// clears list, does not delete the objects
 			void clear();
-
-			vector_tpl<sync_steppable *> list;  ///< list of sync-steppable objects
+			/// removes the object at @p index of @p list by moving the last one there
+			static void remove_at(vector_tpl<sync_steppable *> &list, uint32 index);
+			/// removes @p obj from the list it is in, if it is
+			void remove_from_group(sync_steppable *obj);
+
+			/// sorts the private cars and pedestrians into regions, or into border_objects
+			void assign_regions(uint32 delta_t, uint16 region_size);
+			/// does what the objects of @p region kept back, and removes those which are done
+			void finish_region(sync_region_t &region);
+
+			/// sync-steppable objects by sync_steppable::sync_group_t, each stepped in turn
+			vector_tpl<sync_steppable *> groups[sync_steppable::MAX_SYNC_GROUPS];
 			sync_steppable* currently_deleting; ///< deleted durign sync_step, safeguard calls to remove
 			bool sync_step_running;
+
+			/// the first active_regions are stepped in this sync_step, in this order
+			vector_tpl<sync_region_t *> regions;
+			uint32 active_regions;
+			/// for each region of the map, its index in regions while it is active
+			vector_tpl<uint32> region_slots;
+			/// private cars and pedestrians which are stepped after the regions, in this order
+			vector_tpl<sync_steppable *> border_objects;
+
+			/// steps the objects of @p region on the calling thread
+			static void step_region(sync_region_t &region, uint32 delta_t);
+			/// removes @p obj after it returned @p result, and deletes it for SYNC_DELETE
+			void finish_object(sync_steppable *obj, sync_result result);
+
+		public:
+			/// steps the regions not yet taken by another thread, one after another
+			void step_regions(uint32 delta_t);
 	};
 
 	sync_list_t sync;              ///< vehicles, transformers, traffic lights
@@ -9,6 +9,7 @@
 //
 
 include("tests/test_building")
+include("tests/test_city")
 include("tests/test_climate")
 include("tests/test_depot")
 include("tests/test_dir")
@@ -20,6 +21,7 @@ include("tests/test_label")
 include("tests/test_player")
 include("tests/test_powerline")
 include("tests/test_reservation")
+include("tests/test_route")
 include("tests/test_scenario")
 include("tests/test_sign")
 include("tests/test_slope")
@@ -40,6 +42,7 @@ all_tests <- [
 	test_building_rotate_harbour,
 	test_building_rotate_station,
 	test_building_rotate_factory,
+	test_city_private_car_routes_threaded,
 	test_climate_invalid,
 	test_climate_flat,
 	test_climate_cliff,
@@ -112,6 +115,7 @@ all_tests <- [
 	test_reservation_clear_ground,
 	test_reservation_clear_road,
 	test_reservation_clear_rail,
+	test_route_bidirectional_turn_back,
 	test_scenario_rules_allow_forbid_tool,
 	test_scenario_rules_allow_forbid_way_tool_rect,
 	test_scenario_rules_allow_forbid_way_tool_cube,
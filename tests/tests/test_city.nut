@@ -0,0 +1,91 @@
+//
+// This file is part of the Simutrans-Extended project under the Artistic License.
+// (see LICENSE.txt)
+//
+
+
+//
+// Tests for cities
+//
+
+
+// The next tile of the private car routes from every road on the map to each destination, in a fixed order
+function get_private_car_routes(destinations)
+{
+	local routes = []
+	local size = world.get_size()
+	for (local x = 0; x < size.x; x++) {
+		for (local y = 0; y < size.y; y++) {
+			local way = square_x(x, y).get_ground_tile().get_way(wt_road)
+			if (way == null) {
+				continue
+			}
+			foreach (dest in destinations) {
+				local next = way.get_next_on_private_car_route_to(dest)
+				routes.append(next.x + "," + next.y + "," + next.z)
+			}
+		}
+	}
+	return routes
+}
+
+
+function test_city_private_car_routes_threaded()
+{
+	local public_pl = player_x(1)
+	local city_builder = command_x(tool_add_city)
+	local remover = command_x(tool_remover)
+	local wayremover = command_x(tool_remove_way)
+	local road = way_desc_x.get_available_ways(wt_road, st_flat)[0]
+
+	ASSERT_TRUE(road != null)
+
+	ASSERT_EQUAL(city_builder.work(public_pl, coord3d(3, 3, 0)), null)
+	ASSERT_EQUAL(city_builder.work(public_pl, coord3d(12, 12, 0)), null)
+
+	local cities = [ world.find_nearest_city(coord(3, 3)), world.find_nearest_city(coord(12, 12)) ]
+	local destinations = [ cities[0].get_townhall_road(), cities[1].get_townhall_road() ]
+	ASSERT_TRUE(destinations[0].x != destinations[1].x  ||  destinations[0].y != destinations[1].y)
+
+	// connect the cities
+	ASSERT_EQUAL(command_x.build_way(public_pl, coord3d(destinations[0].x, destinations[0].y, 0), coord3d(destinations[1].x, destinations[1].y, 0), road, true), null)
+
+	{
+		world.check_private_car_routes(false)
+		local routes = get_private_car_routes(destinations)
+
+		world.check_private_car_routes(true)
+		local threaded_routes = get_private_car_routes(destinations)
+
+		// the threads must find the same routes as a single thread
+		ASSERT_EQUAL(threaded_routes.len(), routes.len())
+		local route_count = 0
+		foreach (i, next in routes) {
+			ASSERT_EQUAL(threaded_routes[i], next)
+			if (next != "-1,-1,-1") {
+				route_count++
+			}
+		}
+
+		// and the cities must be connected
+		ASSERT_TRUE(route_count > 0)
+		local next = square_x(destinations[0].x, destinations[0].y).get_ground_tile().get_way(wt_road).get_next_on_private_car_route_to(destinations[1])
+		ASSERT_TRUE(next.x >= 0)
+	}
+
+	// clean up: the cities are waiting for their routes to be checked again when they are removed
+	foreach (city in cities) {
+		local pos = city.get_pos()
+		ASSERT_EQUAL(remover.work(public_pl, coord3d(pos.x, pos.y, 0)), null)
+	}
+	local size = world.get_size()
+	for (local x = 0; x < size.x; x++) {
+		for (local y = 0; y < size.y; y++) {
+			if (square_x(x, y).get_ground_tile().get_way(wt_road) != null) {
+				ASSERT_EQUAL(wayremover.work(public_pl, coord3d(x, y, 0), coord3d(x, y, 0), "" + wt_road), null)
+			}
+		}
+	}
+
+	RESET_ALL_PLAYER_FUNDS()
+}
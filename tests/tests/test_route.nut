@@ -0,0 +1,75 @@
+//
+// This file is part of the Simutrans-Extended project under the Artistic License.
+// (see LICENSE.txt)
+//
+
+
+//
+// Tests for vehicle route search
+//
+
+
+function test_route_bidirectional_turn_back()
+{
+	local pl = player_x(0)
+	local wayremover = command_x(tool_remove_way)
+	local road = way_desc_x.get_available_ways(wt_road, st_flat)[0]
+	local vehicle = vehicle_desc_x.get_available_vehicles(wt_road)[0]
+	local min_distance = settings.get_bidirectional_route_min_distance()
+
+	ASSERT_TRUE(road != null)
+	ASSERT_TRUE(vehicle != null)
+
+	// A straight road with a detour, and a dead end half way. Both searches enter the dead end
+	// from the straight road, so that they meet there turning back.
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(1, 8, 0), coord3d(14, 8, 0), road, true), null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(7, 8, 0), coord3d(7, 4, 0), road, true), null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(3, 8, 0), coord3d(3, 12, 0), road, true), null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(3, 12, 0), coord3d(11, 12, 0), road, true), null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(11, 12, 0), coord3d(11, 8, 0), road, true), null)
+
+	local start = tile_x(1, 8, 0)
+	local target = tile_x(14, 8, 0)
+
+	{
+		settings.set_bidirectional_route_min_distance(0)
+		local route = start.find_route(target, vehicle, pl)
+
+		settings.set_bidirectional_route_min_distance(1)
+		local bidirectional_route = start.find_route(target, vehicle, pl)
+
+		// both searches must find the straight road
+		ASSERT_EQUAL(route.len(), 14)
+		ASSERT_EQUAL(bidirectional_route.len(), route.len())
+		foreach (i, pos in bidirectional_route) {
+			ASSERT_EQUAL(pos.x, route[i].x)
+			ASSERT_EQUAL(pos.y, route[i].y)
+			ASSERT_EQUAL(pos.y, 8)
+		}
+
+		// and back again
+		local return_route = target.find_route(start, vehicle, pl)
+		ASSERT_EQUAL(return_route.len(), 14)
+		ASSERT_EQUAL(return_route[0].x, 14)
+		ASSERT_EQUAL(return_route[13].x, 1)
+	}
+
+	// into the dead end, the route must not turn back on the way there
+	{
+		local route = start.find_route(tile_x(7, 4, 0), vehicle, pl)
+		ASSERT_EQUAL(route.len(), 11)
+		ASSERT_EQUAL(route[6].x, 7)
+		ASSERT_EQUAL(route[6].y, 8)
+		ASSERT_EQUAL(route[7].y, 7)
+	}
+
+	// clean up
+	settings.set_bidirectional_route_min_distance(min_distance)
+	ASSERT_EQUAL(wayremover.work(pl, coord3d(3, 9, 0), coord3d(3, 11, 0), "" + wt_road), null)
+	ASSERT_EQUAL(wayremover.work(pl, coord3d(11, 9, 0), coord3d(11, 11, 0), "" + wt_road), null)
+	ASSERT_EQUAL(wayremover.work(pl, coord3d(3, 12, 0), coord3d(11, 12, 0), "" + wt_road), null)
+	ASSERT_EQUAL(wayremover.work(pl, coord3d(7, 4, 0), coord3d(7, 7, 0), "" + wt_road), null)
+	ASSERT_EQUAL(wayremover.work(pl, coord3d(1, 8, 0), coord3d(14, 8, 0), "" + wt_road), null)
+
+	RESET_ALL_PLAYER_FUNDS()
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_ALIAS_SAMPLER_TPL_H
+#define TPL_ALIAS_SAMPLER_TPL_H
+
+
+#include "../simtypes.h"
+#include "vector_tpl.h"
+#include "weighted_vector_tpl.h"
+
+
+/**
+ * Picks elements of a weighted_vector_tpl with a probability proportional
+ * to their weight in O(1) (Walker's alias method), where at_weight() needs
+ * a binary search.
+ *
+ * The table has to be rebuilt in O(n) whenever the weights change. update()
+ * only does this once enough picks were made since the change to pay for it;
+ * until then is_current() is false and the vector must be used directly.
+ * All integer, so the same draws give the same elements on all clients.
+ */
+template<class T> class alias_sampler_tpl
+{
+private:
+	struct column_t
+	{
+		uint32 threshold; ///< below this, the column picks its own element
+		uint32 alias;     ///< otherwise this one
+	};
+
+public:
+	alias_sampler_tpl() : source(NULL), revision(0), sum_weight(0), pending_picks(0) {}
+
+	/**
+	 * Rebuilds the table for @p vector if it has changed since the last
+	 * rebuild and about @p expected_picks picks were made since then.
+	 * Must not be called while other threads pick from this sampler.
+	 */
+	void update(const weighted_vector_tpl<T> &vector, uint32 expected_picks)
+	{
+		if(  is_current(vector)  ) {
+			return;
+		}
+		pending_picks += expected_picks;
+
+		// a rebuild costs about as much as count/log2(count) binary searches
+		const uint32 count = vector.get_count();
+		uint32 log2_count = 1;
+		while(  (1u << log2_count) < count  &&  log2_count < 31  ) {
+			log2_count++;
+		}
+		if(  pending_picks * log2_count >= count  ) {
+			rebuild(vector);
+		}
+	}
+
+	/** @returns true, if the table matches the current weights of @p vector */
+	bool is_current(const weighted_vector_tpl<T> &vector) const
+	{
+		return source == &vector  &&  revision == vector.get_revision()  &&  !columns.empty();
+	}
+
+	/**
+	 * Forgets the table and the picks counted towards the next rebuild.
+	 * The state is not saved, so this must be called whenever the game is
+	 * loaded: otherwise a client which kept a current table would draw
+	 * differently from one which had to start without.
+	 */
+	void reset()
+	{
+		columns.clear();
+		source = NULL;
+		revision = 0;
+		sum_weight = 0;
+		pending_picks = 0;
+	}
+
+	/**
+	 * Picks an element of @p vector, which must be current.
+	 * @param column   uniformly random in [0, vector.get_count())
+	 * @param fraction uniformly random in [0, vector.get_sum_weight())
+	 */
+	const T& at(const weighted_vector_tpl<T> &vector, uint32 column, uint32 fraction) const
+	{
+		const column_t &c = columns[column];
+		return vector[fraction < c.threshold ? column : c.alias];
+	}
+
+private:
+	void rebuild(const weighted_vector_tpl<T> &vector)
+	{
+		source = &vector;
+		revision = vector.get_revision();
+		sum_weight = vector.get_sum_weight();
+		pending_picks = 0;
+
+		const uint32 count = vector.get_count();
+		columns.clear();
+		if(  count == 0  ||  sum_weight == 0  ) {
+			return;
+		}
+		columns.resize(count);
+
+		// Scale the weights by the number of columns, so each column holds exactly sum_weight.
+		// Columns with less are filled up with the rest of a column with more (Vose's method).
+		vector_tpl<uint64> scaled(count);
+		vector_tpl<uint32> small(count), large(count);
+		for(  uint32 i=0;  i<count;  i++  ) {
+			const uint32 weight = (i+1 < count ? vector.weight_at(i+1) : sum_weight) - vector.weight_at(i);
+			scaled.append( (uint64)weight * count );
+			columns.append( column_t() );
+			if(  scaled[i] < sum_weight  ) {
+				small.append(i);
+			}
+			else {
+				large.append(i);
+			}
+		}
+
+		while(  !small.empty()  &&  !large.empty()  ) {
+			const uint32 less = small.pop_back();
+			const uint32 more = large.back();
+			columns[less].threshold = (uint32)scaled[less];
+			columns[less].alias = more;
+			scaled[more] -= sum_weight - scaled[less];
+			if(  scaled[more] < sum_weight  ) {
+				large.pop_back();
+				small.append(more);
+			}
+		}
+		// as the weights are integers, the remaining columns hold exactly sum_weight
+		while(  !large.empty()  ) {
+			const uint32 full = large.pop_back();
+			columns[full].threshold = sum_weight;
+			columns[full].alias = full;
+		}
+		while(  !small.empty()  ) {
+			const uint32 full = small.pop_back();
+			columns[full].threshold = sum_weight;
+			columns[full].alias = full;
+		}
+	}
+
+	vector_tpl<column_t> columns;
+	const weighted_vector_tpl<T> *source;
+	uint32 revision;
+	uint32 sum_weight;
+	uint64 pending_picks;
+};
+
+#endif
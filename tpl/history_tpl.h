@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_HISTORY_TPL_H
+#define TPL_HISTORY_TPL_H
+
+
+#include "../simtypes.h"
+
+
+/**
+ * Statistics of the last MONTHS months (or years) with TYPES values each,
+ * where [0] is the current month, [1] the last one and so on.
+ *
+ * This is a ring of rows: roll() starts a new month by moving the index of
+ * the current row and clearing only that row, rather than moving all the
+ * others down. [month][type] reads and writes like the plain two dimensional
+ * array it replaces, so savegames keep their layout. MONTHS must not exceed 256.
+ */
+template<class T, int MONTHS, int TYPES> class history_tpl
+{
+private:
+	T rows[MONTHS][TYPES];
+	uint8 current; ///< row of month 0
+
+	int row_of(int month) const
+	{
+		const int row = current + month;
+		return row < MONTHS ? row : row - MONTHS;
+	}
+
+public:
+	history_tpl() { clear(); }
+
+	T *operator[](int month) { return rows[ row_of(month) ]; }
+	const T *operator[](int month) const { return rows[ row_of(month) ]; }
+
+	/** sets all months to zero */
+	void clear()
+	{
+		current = 0;
+		for(  int month=0;  month<MONTHS;  month++  ) {
+			for(  int type=0;  type<TYPES;  type++  ) {
+				rows[month][type] = 0;
+			}
+		}
+	}
+
+	/** starts a new month: the oldest one is dropped and the new one is zero */
+	void roll()
+	{
+		current = current == 0 ? MONTHS-1 : current-1;
+		for(  int type=0;  type<TYPES;  type++  ) {
+			rows[current][type] = 0;
+		}
+	}
+
+	/**
+	 * For charts: the rows in memory and the one of month 0;
+	 * month m is in row (get_current_row() + m) % MONTHS.
+	 */
+	const T *get_rows() const { return *rows; }
+	const uint8 *get_current_row() const { return &current; }
+};
+
+#endif
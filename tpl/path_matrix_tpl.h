@@ -0,0 +1,335 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_PATH_MATRIX_TPL_H
+#define TPL_PATH_MATRIX_TPL_H
+
+
+#include <string.h>
+
+#include "../simtypes.h"
+#include "vector_tpl.h"
+
+
+/**
+ * Square matrix of the fastest paths between the halts of a path explorer compartment, with the
+ * Floyd-Warshall kernels which find them. Each field is kept in its own contiguous row-major array,
+ * so that path search streams through memory.
+ * H is the handle of the next transfer; it needs is_bound() and get_id().
+ * The searches can be interrupted by an iteration limit : they then return false, and resume from the
+ * counters which they are given when called again.
+ */
+template<class H> class path_matrix_tpl
+{
+private:
+
+	uint16 halt_count;
+
+public:
+
+	// number of halts per tile side in blocked path search
+	static const uint16 tile_size = 64;
+
+	// stages of blocked path search within a block of transfers
+	enum { stage_transfer_block = 0, stage_transfer_rows, stage_all_rows };
+
+	uint32 *aggregate_time;
+	H *next_transfer;
+
+	// best lines/convoys : only used during path search
+	uint16 *first_transport;
+	uint16 *last_transport;
+
+	path_matrix_tpl(const uint16 count, const bool with_transport) :
+		halt_count(count),
+		first_transport(NULL),
+		last_transport(NULL)
+	{
+		const size_t element_count = (size_t)count * count;
+		aggregate_time = new uint32[element_count];
+		next_transfer = new H[element_count];
+		for (size_t i = 0; i < element_count; ++i)
+		{
+			aggregate_time[i] = UINT32_MAX_VALUE;
+		}
+		if (with_transport)
+		{
+			first_transport = new uint16[element_count]();	// initialise all elements to zero
+			last_transport = new uint16[element_count]();
+		}
+	}
+
+	~path_matrix_tpl()
+	{
+		delete[] aggregate_time;
+		delete[] next_transfer;
+		release_transport();
+	}
+
+	// transport data are no longer needed once path search is completed
+	void release_transport()
+	{
+		delete[] first_transport;
+		first_transport = NULL;
+		delete[] last_transport;
+		last_transport = NULL;
+	}
+
+	uint16 get_halt_count() const { return halt_count; }
+
+	size_t index(const uint16 row, const uint16 column) const { return (size_t)row * halt_count + column; }
+
+	/**
+	 * Relaxes a tile through the listed transfers, in list order.
+	 * Rows/columns are taken from row_list/column_list, or are consecutive from row_begin/column_begin if the list is NULL.
+	 * @return the number of iterations performed
+	 */
+	uint64 relax_tile(const uint16 *const via_list, const uint16 via_count,
+					  const uint16 *const row_list, const uint16 row_count, const uint16 row_begin,
+					  const uint16 *const column_list, const uint16 column_count, const uint16 column_begin)
+	{
+		// transfers must be processed in order, as later transfers rely on paths found through earlier ones
+		for ( uint16 v = 0; v < via_count; ++v )
+		{
+			const uint16 via = via_list[v];
+			const size_t via_row = index(via, 0);
+
+			for ( uint16 r = 0; r < row_count; ++r )
+			{
+				const uint16 origin = row_list ? row_list[r] : row_begin + r;
+				const size_t origin_row = index(origin, 0);
+				const uint32 inbound_time = aggregate_time[origin_row + via];
+
+				if ( origin == via || inbound_time == UINT32_MAX_VALUE )
+				{
+					continue;
+				}
+
+				const uint16 inbound_transport = last_transport[origin_row + via];
+
+				for ( uint16 c = 0; c < column_count; ++c )
+				{
+					const uint16 target = column_list ? column_list[c] : column_begin + c;
+					const uint32 outbound_time = aggregate_time[via_row + target];
+
+					// as with the connection clusters, do not transfer to the same line/lineless convoy
+					if ( outbound_time == UINT32_MAX_VALUE || ( inbound_transport == first_transport[via_row + target] && inbound_transport != 0u ) )
+					{
+						continue;
+					}
+
+					const uint32 combined_time = inbound_time + outbound_time;
+					const size_t origin_target = origin_row + target;
+					if ( combined_time < aggregate_time[origin_target] )
+					{
+						aggregate_time[origin_target] = combined_time;
+						next_transfer[origin_target] = next_transfer[origin_row + via];
+						first_transport[origin_target] = first_transport[origin_row + via];
+						last_transport[origin_target] = last_transport[via_row + target];
+					}
+				}
+			}
+		}
+
+		return (uint64)via_count * row_count * column_count;
+	}
+
+	/**
+	 * Floyd-Warshall through the listed transfers, tiled to suit the cache, for the listed rows or all rows
+	 * if row_list is NULL. The transfers are the outermost loop over all rows, as the rows may be connected
+	 * through each other. The counters hold the position of the search, and must be zero at the start.
+	 * @return false if interrupted because iterations reached limit
+	 */
+	bool relax_blocked(const uint16 *const vias, const uint16 vias_count,
+					   const uint16 *const row_list, const uint16 row_count,
+					   uint16 &via_index, uint32 &stage, uint32 &row_index, uint32 &column_index,
+					   const uint64 limit, uint64 &iterations)
+	{
+		// Transfers are taken in blocks. For each block, the paths among its transfers are completed first, then the rows
+		// of those transfers, and finally all rows (or the listed ones), one tile at a time. As the transfer rows are final by the time other rows
+		// are processed, each tile only needs the block's transfer rows and its own part of the matrix in the cache.
+		while ( via_index < vias_count )
+		{
+			const uint16 *const via_list = vias + via_index;
+			const uint16 via_count = (uint16)min( tile_size, vias_count - via_index );
+
+			if ( stage == stage_transfer_block )
+			{
+				iterations += relax_tile(via_list, via_count, via_list, via_count, 0, via_list, via_count, 0);
+
+				stage = stage_transfer_rows;
+				column_index = 0;
+
+				// iteration control
+				if ( iterations >= limit )
+				{
+					return false;
+				}
+			}
+
+			if ( stage == stage_transfer_rows )
+			{
+				// for each column tile
+				while ( column_index < halt_count )
+				{
+					const uint16 column_count = (uint16)min( tile_size, halt_count - column_index );
+					iterations += relax_tile(via_list, via_count, via_list, via_count, 0, NULL, column_count, (uint16)column_index);
+					column_index += column_count;
+
+					// iteration control
+					if ( iterations >= limit )
+					{
+						return false;
+					}
+				}
+
+				stage = stage_all_rows;
+				row_index = 0;
+				column_index = 0;
+			}
+
+			// for each row tile
+			while ( row_index < row_count )
+			{
+				const uint16 tile_row_count = (uint16)min( tile_size, row_count - row_index );
+				const uint16 *const tile_row_list = row_list ? row_list + row_index : NULL;
+				const uint16 tile_row_begin = row_list ? 0 : (uint16)row_index;
+
+				if ( column_index == 0 )
+				{
+					// complete the columns of the transfers first, as every column tile below reads them.
+					// This is not followed by iteration control, so that at least one column tile is processed with it.
+					iterations += relax_tile(via_list, via_count, tile_row_list, tile_row_count, tile_row_begin, via_list, via_count, 0);
+				}
+
+				// for each column tile
+				while ( column_index < halt_count )
+				{
+					const uint16 column_count = (uint16)min( tile_size, halt_count - column_index );
+					iterations += relax_tile(via_list, via_count, tile_row_list, tile_row_count, tile_row_begin, NULL, column_count, (uint16)column_index);
+					column_index += column_count;
+
+					// iteration control
+					if ( iterations >= limit )
+					{
+						return false;
+					}
+				}
+
+				column_index = 0;
+				row_index += tile_row_count;
+			}
+
+			// proceed to the next block of transfers
+			stage = stage_transfer_block;
+			row_index = 0;
+			column_index = 0;
+			via_index += via_count;
+		}
+
+		return true;
+	}
+
+	/**
+	 * One pass over the targets to seed the repair of this matrix, after some halts have changed, from the
+	 * finished matrix of the halts before the change. A finished path remains valid as long as it neither
+	 * starts at nor passes through a changed halt. Origins with invalid paths are flagged in explore_row and
+	 * appended to rows; if copy is set, the valid paths of the other origins are copied into this matrix.
+	 * @param finished_index maps the halts of this matrix to those of the finished one, 65535 for new halts
+	 * @param finished_map maps halt ids to the halts of the finished matrix, 65535 for none
+	 * @param target_index the next target, zero at the start
+	 * @return false if interrupted because iterations reached limit
+	 */
+	bool seed_paths(const path_matrix_tpl &finished, const uint16 *const finished_index, const uint16 *const finished_map,
+					const bool *const changed_finished, bool *const explore_row, vector_tpl<uint16> &rows, const bool copy,
+					uint32 &target_index, const uint64 limit, uint64 &iterations)
+	{
+		const uint16 finished_count = finished.get_halt_count();
+
+		// state of the finished path from a halt to the current target : unknown, valid, invalid or being checked
+		enum { path_unknown = 0, path_valid, path_invalid, path_checking };
+		uint8 *const path_state = new uint8[finished_count];
+		vector_tpl<uint16> chain(16);
+		bool limit_reached = false;
+
+		while ( target_index < halt_count && !limit_reached )
+		{
+			const uint16 target = (uint16)target_index;
+			const uint16 finished_target = finished_index[target];
+			++target_index;
+			if ( finished_target == 65535 )
+			{
+				continue;
+			}
+
+			memset( path_state, path_unknown, finished_count );
+			path_state[finished_target] = path_valid;
+			iterations += halt_count;
+
+			for ( uint16 origin = 0; origin < halt_count; ++origin )
+			{
+				if ( explore_row[origin] || origin == target )
+				{
+					continue;
+				}
+
+				// follow the finished path until a halt with a known state is reached
+				uint16 current = finished_index[origin];
+				const size_t origin_target = finished.index(current, finished_target);
+				if ( finished.aggregate_time[origin_target] == UINT32_MAX_VALUE )
+				{
+					continue;
+				}
+				chain.clear();
+				while ( path_state[current] == path_unknown )
+				{
+					const H &next_halt = finished.next_transfer[ finished.index(current, finished_target) ];
+					const uint16 next = next_halt.is_bound() ? finished_map[ next_halt.get_id() ] : 65535;
+					if ( changed_finished[current] || next == 65535 )
+					{
+						path_state[current] = path_invalid;
+						break;
+					}
+					path_state[current] = path_checking;
+					chain.append(current);
+					current = next;
+				}
+				const uint8 state = path_state[current] == path_checking ? (uint8)path_invalid : path_state[current];
+				for ( uint32 c = 0; c < chain.get_count(); ++c )
+				{
+					path_state[ chain[c] ] = state;
+				}
+				iterations += chain.get_count() + 1;
+
+				if ( state != path_valid )
+				{
+					explore_row[origin] = true;
+					rows.append(origin);
+				}
+				else if ( copy )
+				{
+					const size_t element = index(origin, target);
+					if ( finished.aggregate_time[origin_target] < aggregate_time[element] )
+					{
+						// the transports of the finished path are unknown, so they do not restrict transfers
+						aggregate_time[element] = finished.aggregate_time[origin_target];
+						next_transfer[element] = finished.next_transfer[origin_target];
+						first_transport[element] = 0;
+						last_transport[element] = 0;
+					}
+				}
+			}
+
+			// iteration control
+			limit_reached = iterations >= limit;
+		}
+
+		delete[] path_state;
+
+		return target_index >= halt_count;
+	}
+};
+
+#endif
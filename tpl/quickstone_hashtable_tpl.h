@@ -22,7 +22,7 @@ class quickstone_hash_tpl {
 public:
 	typedef long diff_type;
 
-	static uint16 hash(const quickstone_tpl<key_t> key)
+	static quickstone_id_t hash(const quickstone_tpl<key_t> key)
 	{
 		return key.get_id();
 	}
@@ -31,25 +31,30 @@ private:
 	/**
 	 * Next entry to check
 	 */
-	static uint16 next;
+	static quickstone_id_t next;
 
 	/**
 	 * Size of tombstone table
 	 */
-	static uint16 size;
+	static quickstone_id_t size;
+
+	/**
+	 * Largest size of the tombstone table, at most QUICKSTONE_ID_RANGE-1
+	 */
+	static quickstone_id_t max_size;
 
 	/**
 	 * The index in the table for this handle.
 	 * (only this variable is actually saved, since the rest is static!)
 	 */
-	uint16 entry;
+	quickstone_id_t entry;
 
 private:
 	/**
 	 * Retrieves next free tombstone index
 	 */
-	static uint16 find_next() {
-		uint16 i;
+	static quickstone_id_t find_next() {
+		quickstone_id_t i;
 
 		// scan rest of array
 		for(  i=next;  i<size;  i++  ) {
@@ -59,12 +64,15 @@ private:
 			}
 		}
 
-		if (size < 65535)
+		if (size < 65535  &&  size < max_size)
 		{
 			// Enlarge the array before searching old handles.
 			// This is slightly less efficient, but minimises handle
 			// duplication, which can cause problems when handles are
 			// used as indices.
+			// Beyond 65535 entries old handles are reused first, so that
+			// the table does not keep growing with the number of handles
+			// ever created.
 			return enlarge();
 		}
 
@@ -78,17 +86,17 @@ private:
 		return enlarge();
 	}
 
-	static uint16 enlarge()
+	static quickstone_id_t enlarge()
 	{
 		// no free entry found, extend array if possible
-		uint16 newsize;
-		if (size == 65535) {
+		quickstone_id_t newsize;
+		if (size == max_size) {
 			// completely out of handles
-			dbg->fatal("quickstone<T>::find_next()","no free index found (size=%i)",size);
+			dbg->fatal("quickstone<T>::find_next()","no free index found (size=%u)",(unsigned)size);
 			return 0; //dummy for compiler
-		} else if (size >= 32768) {
-			// max out on handles, don't overflow uint16
-			newsize = 65535;
+		} else if (size > max_size/2) {
+			// max out on handles, don't overflow quickstone_id_t
+			newsize = max_size;
 		} else {
 			newsize = 2*size;
 		}
@@ -96,7 +104,7 @@ private:
 		// Move data to new extended array
 		T ** newdata = new T* [newsize];
 		memcpy( newdata, data, sizeof(T*)*size );
-		for(  uint16 i=size;  i<newsize;  i++  ) {
+		for(  quickstone_id_t i=size;  i<newsize;  i++  ) {
 			newdata[i] = 0;
 		}
 		delete [] data;
@@ -112,15 +120,17 @@ public:
 	 * quickstones invalid.
 	 *
 	 * @param n number of elements
+	 * @param max largest number of elements, including the NULL entry
 	 */
-	static void init(const uint16 n)
+	static void init(const quickstone_id_t n, const quickstone_id_t max = QUICKSTONE_ID_RANGE-1)
 	{
 		delete [] data;
 		size = n;
+		max_size = max;
 		data = new T* [size];
 
 		// all NULL pointers are mapped to entry 0
-		for(int i=0; i<size; i++) {
+		for(quickstone_id_t i=0; i<size; i++) {
 			data[i] = 0;
 		}
 		next = 1;
@@ -148,10 +158,10 @@ public:
 	// connects with last handle
 	explicit quickstone_tpl(T* p, bool)
 	{
-		uint16 i;
+		quickstone_id_t i;
 
 		// scan rest of array
-		for(  i=size-1;  i>0;  i++  ) {
+		for(  i=size-1;  i>0;  i--  ) {
 			if(  data[i] == 0  ) {
 				entry = i;
 				data[entry] = p;
@@ -160,7 +170,7 @@ public:
 		}
 		enlarge();
 		// repeat
-		for(  i=size-1;  i>0;  i++  ) {
+		for(  i=size-1;  i>0;  i--  ) {
 			if(  data[i] == 0  ) {
 				entry = i;
 				data[entry] = p;
@@ -171,24 +181,24 @@ public:
 	}
 
 	// creates handle with id, fails if already taken
-	quickstone_tpl(T* p, uint16 id)
+	quickstone_tpl(T* p, quickstone_id_t id)
 	{
 		if(p) {
 			if(  id == 0  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","wants to assign non-null pointer to null index");
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","wants to assign non-null pointer to null index");
 			}
 			while(  id >= size  ) {
 				enlarge();
 			}
 			if(  data[id]!=NULL  &&  data[id]!=p  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","slot (%d) already taken", id);
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","slot (%u) already taken", (unsigned)id);
 			}
 			entry = id;
 			data[entry] = p;
 		}
 		else {
 			if(  id!=0  ) {
-				dbg->fatal("quickstone<T>::quickstone_tpl(T*,uint16)","wants to assign null pointer to non-null index");
+				dbg->fatal("quickstone<T>::quickstone_tpl(T*,quickstone_id_t)","wants to assign null pointer to non-null index");
 			}
 			// all NULL pointers are mapped to entry 0
 			entry = 0;
@@ -198,9 +208,9 @@ public:
 	// returns true, if no handles left
 	static bool is_exhausted()
 	{
-		if(  size==65535  ) {
+		if(  size==max_size  ) {
 			// scan  array
-			for(  uint16 i = 1; i<size; i++) {
+			for(  quickstone_id_t i = 1; i<size; i++) {
 				if(data[i] == 0) {
 					// still empty handles left
 					return false;
@@ -248,7 +258,7 @@ public:
 	 * @return the index into the tombstone table. May be used as
 	 * an ID for the referenced object.
 	 */
-	inline uint16 get_id() const { return entry; }
+	inline quickstone_id_t get_id() const { return entry; }
 
 	/**
 	 * For read/write from/to any storage (file or memory) with the appropriate interface
@@ -257,8 +267,8 @@ public:
 	template <class STORAGE>
 	void rdwr(STORAGE *store)
 	{
-		store->rdwr_short(entry);
-		if (entry > next && next < 65534)
+		store->rdwr_handle_id(entry);
+		if (entry > next && next < max_size-1)
 		{
 			// This makes sure that "next" always searches to the end of the array
 			// before returning to the beginning again.
@@ -270,7 +280,7 @@ public:
 	 * Sets the current id: Needed to recreate stuff via network.
 	 * ATTENTION: This may be harmful. DO not use unless really really needed!
 	 */
-	void set_id(uint16 e) { entry=e; }
+	void set_id(quickstone_id_t e) { entry=e; }
 
 	/**
 	 * Overloaded dereference operator. With this, quickstones can
@@ -291,18 +301,19 @@ public:
 		return entry <= other.entry;
 	}
 
-	static uint16 get_size() { return size; }
+	static quickstone_id_t get_size() { return size; }
 
 	/**
 	 * For checking the consistency of handle allocation
 	 * among the server and the clients in network mode
 	 */
-	static uint16 get_next_check() { return next; }
+	static quickstone_id_t get_next_check() { return next; }
 };
 
 template <class T> T** quickstone_tpl<T>::data = 0;
 
-template <class T> uint16 quickstone_tpl<T>::next = 1;
-template <class T> uint16 quickstone_tpl<T>::size = 0;
+template <class T> quickstone_id_t quickstone_tpl<T>::next = 1;
+template <class T> quickstone_id_t quickstone_tpl<T>::size = 0;
+template <class T> quickstone_id_t quickstone_tpl<T>::max_size = QUICKSTONE_ID_RANGE-1;
 
 #endif
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ *
+ * Micro-benchmark for alias_sampler_tpl.h against weighted_vector_tpl::at_weight()
+ * on as many buildings as a large world has. Also checks that both pick with the
+ * same distribution.
+ * Do NOT link this into simutrans!  Build it on its own, e.g.
+ * g++ -O2 -std=c++14 tpl/test_alias_sampler_tpl.cc -o test_alias_sampler
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+
+#include "../simtypes.h"
+#include "../utils/log.h"
+#include "alias_sampler_tpl.h"
+
+// The templates need logging in order to link; only fatal() can be called here.
+log_t *dbg = NULL;
+
+void log_t::fatal(const char *who, const char *format, ...)
+{
+	va_list argptr;
+	va_start(argptr, format);
+	fprintf(stderr, "FATAL ERROR: %s: ", who);
+	vfprintf(stderr, format, argptr);
+	fprintf(stderr, "\n");
+	va_end(argptr);
+	abort();
+}
+
+
+// the same generator as simrand(), which would drag in the whole game
+static std::mt19937 mersenne_twister(5489u);
+static uint32 test_rand(uint32 max)
+{
+	return (uint32)(((uint64)mersenne_twister() * max) >> 32);
+}
+
+
+int main(int argc, char **argv)
+{
+	uint32 building_count = argc > 1 ? atoi(argv[1]) : 500000;
+	const uint32 pick_count = argc > 2 ? atoi(argv[2]) : 20000000;
+
+	weighted_vector_tpl<uint32> buildings(building_count);
+	for(  uint32 i=0;  i<building_count;  i++  ) {
+		// few large buildings, many small ones, some without weight
+		const uint32 weight = test_rand(4) == 0 ? test_rand(200) : test_rand(8);
+		buildings.append(buildings.get_count(), weight);
+	}
+	// with IGNORE_ZERO_WEIGHT, buildings without weight were left out
+	building_count = buildings.get_count();
+
+	alias_sampler_tpl<uint32> sampler;
+	const std::chrono::steady_clock::time_point build_start = std::chrono::steady_clock::now();
+	sampler.update(buildings, UINT32_MAX_VALUE);
+	const std::chrono::steady_clock::time_point build_end = std::chrono::steady_clock::now();
+	if(  !sampler.is_current(buildings)  ) {
+		fprintf(stderr, "Sampler was not built\n");
+		return 1;
+	}
+
+	uint32 *picked_by_weight = new uint32[building_count]();
+	uint32 *picked_by_alias = new uint32[building_count]();
+	const uint32 sum_weight = buildings.get_sum_weight();
+
+	const std::chrono::steady_clock::time_point weight_start = std::chrono::steady_clock::now();
+	for(  uint32 i=0;  i<pick_count;  i++  ) {
+		picked_by_weight[buildings.at_weight(test_rand(sum_weight))]++;
+	}
+	const std::chrono::steady_clock::time_point weight_end = std::chrono::steady_clock::now();
+
+	for(  uint32 i=0;  i<pick_count;  i++  ) {
+		const uint32 column = test_rand(building_count);
+		picked_by_alias[sampler.at(buildings, column, test_rand(sum_weight))]++;
+	}
+	const std::chrono::steady_clock::time_point alias_end = std::chrono::steady_clock::now();
+
+	// compare the picks per weight class with what the weights expect
+	double chi_square_weight = 0, chi_square_alias = 0;
+	uint32 zero_weight_picks = 0;
+	for(  uint32 i=0;  i<building_count;  i++  ) {
+		const uint32 weight = (i+1 < building_count ? buildings.weight_at(i+1) : sum_weight) - buildings.weight_at(i);
+		const double expected = (double)pick_count * weight / sum_weight;
+		if(  weight == 0  ) {
+			zero_weight_picks += picked_by_alias[i];
+			continue;
+		}
+		chi_square_weight += (picked_by_weight[i] - expected) * (picked_by_weight[i] - expected) / expected;
+		chi_square_alias += (picked_by_alias[i] - expected) * (picked_by_alias[i] - expected) / expected;
+	}
+
+	typedef std::chrono::duration<double, std::milli> ms_t;
+	printf("%u buildings, %u picks each\n", building_count, pick_count);
+	printf("alias table built in %.1f ms\n", ms_t(build_end - build_start).count());
+	printf("at_weight():        %8.1f ms (%.1f ns per pick)\n", ms_t(weight_end - weight_start).count(), ms_t(weight_end - weight_start).count() * 1e6 / pick_count);
+	printf("alias_sampler_tpl:  %8.1f ms (%.1f ns per pick)\n", ms_t(alias_end - weight_end).count(), ms_t(alias_end - weight_end).count() * 1e6 / pick_count);
+	printf("chi square per building: at_weight() %.3f, alias %.3f (about 1 is expected)\n", chi_square_weight / building_count, chi_square_alias / building_count);
+	printf("picks of buildings without weight: %u\n", zero_weight_picks);
+
+	// after a reset, as on loading, the table must be stale until enough picks were made again
+	sampler.reset();
+	const bool stale_after_reset = !sampler.is_current(buildings);
+	sampler.update(buildings, 1);
+	const bool rebuilt_too_early = sampler.is_current(buildings);
+	sampler.update(buildings, UINT32_MAX_VALUE);
+	const bool rebuilt = sampler.is_current(buildings);
+	printf("reset: stale %s, early rebuild %s, rebuilt %s\n", stale_after_reset ? "yes" : "no", rebuilt_too_early ? "yes" : "no", rebuilt ? "yes" : "no");
+
+	delete [] picked_by_weight;
+	delete [] picked_by_alias;
+	return zero_weight_picks == 0  &&  stale_after_reset  &&  !rebuilt_too_early  &&  rebuilt ? 0 : 1;
+}
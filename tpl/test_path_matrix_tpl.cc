@@ -0,0 +1,213 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ *
+ * Unit test for path_matrix_tpl.h : after some lines of a random network have changed,
+ * repairing the finished paths must give the same journey times as exploring all paths again,
+ * whether or not the search is interrupted by iteration limits.
+ * Do NOT link this into simutrans!  This is a unit test!
+ * g++ -O2 -std=c++14 tpl/test_path_matrix_tpl.cc -o test_path_matrix
+ */
+#include <stdio.h>
+#include <random>
+
+#include "../simtypes.h"
+#include "path_matrix_tpl.h"
+
+// This is a hack, but it's worth it.  The templates need logging in order to link.
+#include "../simdebug.cc"
+#include "../utils/dumb-log.cc"
+
+
+// halt i has the id i+1, as id 0 is unbound
+struct test_handle_t
+{
+	uint16 id;
+	test_handle_t() : id(0) {}
+	bool is_bound() const { return id != 0; }
+	uint16 get_id() const { return id; }
+};
+
+typedef path_matrix_tpl<test_handle_t> matrix_t;
+
+static const uint16 halt_count = 400;
+static const uint16 line_count = 90;
+static std::mt19937 rng(1234u);
+
+
+struct line_t
+{
+	vector_tpl<uint16> stops;
+	vector_tpl<uint32> times;	// from each stop to the next, the last one back to the first
+};
+
+
+static void random_line(line_t &line)
+{
+	line.stops.clear();
+	line.times.clear();
+	const uint32 stop_count = 3 + rng() % 10;
+	while(  line.stops.get_count() < stop_count  ) {
+		line.stops.append_unique( (uint16)(rng() % halt_count) );
+	}
+	for(  uint32 i = 0;  i < stop_count;  i++  ) {
+		line.times.append( 10 + rng() % 200 );
+	}
+}
+
+
+/**
+ * Fills the matrix with the direct connexions of the lines, which are circular. As in the path
+ * explorer, the transfers are the halts served by more than one line. The transports are left
+ * at zero, so that the search finds the fastest paths without any restriction on transfers.
+ */
+static void fill(matrix_t &matrix, const vector_tpl<line_t> &lines, vector_tpl<uint16> &transfers)
+{
+	uint8 served[halt_count] = {};
+	for(  uint16 h = 0;  h < halt_count;  h++  ) {
+		matrix.aggregate_time[ matrix.index(h, h) ] = 0;
+		matrix.next_transfer[ matrix.index(h, h) ].id = h + 1;
+	}
+	FOR(vector_tpl<line_t>, const &line, lines) {
+		const uint32 stop_count = line.stops.get_count();
+		for(  uint32 i = 0;  i < stop_count;  i++  ) {
+			if(  served[ line.stops[i] ] < 2  ) {
+				served[ line.stops[i] ]++;
+			}
+			uint32 time = 0;
+			for(  uint32 j = 1;  j < stop_count;  j++  ) {
+				time += line.times[ (i + j - 1) % stop_count ];
+				const uint16 target = line.stops[ (i + j) % stop_count ];
+				const size_t element = matrix.index(line.stops[i], target);
+				if(  time < matrix.aggregate_time[element]  ) {
+					matrix.aggregate_time[element] = time;
+					matrix.next_transfer[element].id = target + 1;
+				}
+			}
+		}
+	}
+	transfers.clear();
+	for(  uint16 h = 0;  h < halt_count;  h++  ) {
+		if(  served[h] > 1  ) {
+			transfers.append(h);
+		}
+	}
+}
+
+
+static void explore_all(matrix_t &matrix, const vector_tpl<uint16> &transfers)
+{
+	uint16 via_index = 0;
+	uint32 stage = 0, row_index = 0, column_index = 0;
+	uint64 iterations = 0;
+	matrix.relax_blocked(transfers.begin(), (uint16)transfers.get_count(), NULL, halt_count, via_index, stage, row_index, column_index, UINT64_MAX_VALUE, iterations);
+}
+
+
+/**
+ * Repairs the matrix in the order of the path explorer : the seeding passes, then the rows to be explored
+ * again through all transfers, then all rows through the changed transfers. Each call is limited to
+ * limit iterations. Returns the number of rows explored again.
+ */
+static uint32 repair(matrix_t &matrix, const matrix_t &finished, const vector_tpl<uint16> &transfers, const bool *changed, const uint64 limit)
+{
+	uint16 index_map[halt_count];
+	uint16 id_map[halt_count + 1];
+	id_map[0] = 65535;
+	for(  uint16 h = 0;  h < halt_count;  h++  ) {
+		index_map[h] = h;
+		id_map[h + 1] = h;
+	}
+	bool explore_row[halt_count] = {};
+	vector_tpl<uint16> rows;
+	for(  uint16 h = 0;  h < halt_count;  h++  ) {
+		if(  changed[h]  ) {
+			explore_row[h] = true;
+			rows.append(h);
+		}
+	}
+
+	for(  uint32 pass = 0;  pass < 2;  pass++  ) {
+		uint32 target_index = 0;
+		for(  uint64 iterations = 0;  !matrix.seed_paths(finished, index_map, id_map, changed, explore_row, rows, pass == 1, target_index, limit, iterations);  iterations = 0  ) {}
+	}
+
+	vector_tpl<uint16> vias;
+	FOR(vector_tpl<uint16>, const t, transfers) {
+		if(  changed[t]  ) {
+			vias.append(t);
+		}
+	}
+
+	uint16 via_index = 0;
+	uint32 stage = 0, row_index = 0, column_index = 0;
+	for(  uint64 iterations = 0;  !matrix.relax_blocked(transfers.begin(), (uint16)transfers.get_count(), rows.begin(), (uint16)rows.get_count(), via_index, stage, row_index, column_index, limit, iterations);  iterations = 0  ) {}
+	via_index = 0;
+	stage = row_index = column_index = 0;
+	for(  uint64 iterations = 0;  !matrix.relax_blocked(vias.begin(), (uint16)vias.get_count(), NULL, halt_count, via_index, stage, row_index, column_index, limit, iterations);  iterations = 0  ) {}
+
+	return rows.get_count();
+}
+
+
+static uint32 count_differences(const matrix_t &a, const matrix_t &b)
+{
+	uint32 differences = 0;
+	for(  size_t i = 0;  i < (size_t)halt_count * halt_count;  i++  ) {
+		if(  a.aggregate_time[i] != b.aggregate_time[i]  ) {
+			differences++;
+		}
+	}
+	return differences;
+}
+
+
+int main(int, char **)
+{
+	init_logging( "stderr", true, true, NULL, NULL );
+
+	vector_tpl<line_t> lines(line_count);
+	for(  uint16 l = 0;  l < line_count;  l++  ) {
+		line_t line;
+		random_line(line);
+		lines.append(line);
+	}
+
+	vector_tpl<uint16> transfers;
+	matrix_t finished(halt_count, true);
+	fill(finished, lines, transfers);
+	explore_all(finished, transfers);
+
+	// change some lines; the halts on their old and new stops are the changed ones
+	bool changed[halt_count] = {};
+	for(  uint16 l = 0;  l < line_count;  l += 15  ) {
+		FOR(vector_tpl<uint16>, const s, lines[l].stops) {
+			changed[s] = true;
+		}
+		random_line(lines[l]);
+		FOR(vector_tpl<uint16>, const s, lines[l].stops) {
+			changed[s] = true;
+		}
+	}
+
+	matrix_t full(halt_count, true);
+	fill(full, lines, transfers);
+	explore_all(full, transfers);
+
+	int result = 0;
+	const uint64 limits[] = { UINT64_MAX_VALUE, 1000, 50000 };
+	for(  uint32 i = 0;  i < sizeof(limits) / sizeof(limits[0]);  i++  ) {
+		matrix_t incremental(halt_count, true);
+		fill(incremental, lines, transfers);
+		const uint32 rows = repair(incremental, finished, transfers, changed, limits[i]);
+		const uint32 differences = count_differences(incremental, full);
+		fprintf(stdout, "iteration limit %llu : %u rows explored again, %u journey times differ\n", (unsigned long long)limits[i], rows, differences);
+		// more rows than fit into one tile, as the paths between the tiles matter
+		if(  rows <= matrix_t::tile_size  ||  differences > 0  ) {
+			result = 1;
+		}
+	}
+
+	fprintf(stdout, result == 0 ? "passed\n" : "FAILED\n");
+	return result;
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ *
+ * Micro-benchmark for quickstone_tpl.h: how much larger handles and the goods
+ * packets holding them get with QUICKSTONE_32BIT, and how fast handles are
+ * created, destroyed and dereferenced with many objects.
+ * Do NOT link this into simutrans!  Build it on its own, once with and once
+ * without -DQUICKSTONE_32BIT, e.g.
+ * g++ -O2 -std=c++14 tpl/test_quickstone_tpl.cc -o test_quickstone
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+
+#include "../simtypes.h"
+#include "../utils/log.h"
+#include "quickstone_tpl.h"
+
+// The templates need logging in order to link; only fatal() can be called here.
+log_t *dbg = NULL;
+
+void log_t::fatal(const char *who, const char *format, ...)
+{
+	va_list argptr;
+	va_start(argptr, format);
+	fprintf(stderr, "FATAL ERROR: %s: ", who);
+	vfprintf(stderr, format, argptr);
+	fprintf(stderr, "\n");
+	va_end(argptr);
+	abort();
+}
+
+
+// the same generator as simrand(), which would drag in the whole game
+static std::mt19937 mersenne_twister(5489u);
+static uint32 test_rand(uint32 max)
+{
+	return (uint32)(((uint64)mersenne_twister() * max) >> 32);
+}
+
+
+struct convoy_t
+{
+	uint32 distance;
+};
+
+typedef quickstone_tpl<convoy_t> convoy_handle_t;
+
+// the members of ware_t, if its halt handles were built from quickstone_id_t
+struct packet_t
+{
+	uint32 menge;
+	uint8 index;
+	uint8 g_class;
+	uint16 comfort_preference_percentage;
+	convoy_handle_t ziel, zwischenziel, origin, last_transfer;
+	sint16 zielpos_x, zielpos_y;
+	uint32 arrival_time;
+};
+
+
+int main(int argc, char **argv)
+{
+	// more than fits into 16 bit handles, if the build allows it
+	const uint32 convoy_count = argc > 1 ? atoi(argv[1]) : (QUICKSTONE_ID_RANGE > 0x10000 ? 200000 : 60000);
+	const uint32 step_count = argc > 2 ? atoi(argv[2]) : 20000000;
+
+	convoy_handle_t::init(1024);
+
+	convoy_t *convoys = new convoy_t[convoy_count];
+	convoy_handle_t *handles = new convoy_handle_t[convoy_count];
+
+	const std::chrono::steady_clock::time_point create_start = std::chrono::steady_clock::now();
+	for(  uint32 i=0;  i<convoy_count;  i++  ) {
+		convoys[i].distance = i;
+		handles[i] = convoy_handle_t(convoys + i);
+	}
+	const std::chrono::steady_clock::time_point create_end = std::chrono::steady_clock::now();
+
+	// convoys being sold and bought while the table is nearly full
+	for(  uint32 i=0;  i<step_count/100;  i++  ) {
+		const uint32 n = test_rand(convoy_count);
+		handles[n].detach();
+		handles[n] = convoy_handle_t(convoys + n);
+	}
+	const std::chrono::steady_clock::time_point churn_end = std::chrono::steady_clock::now();
+
+	uint64 sum = 0;
+	uint32 errors = 0;
+	for(  uint32 i=0;  i<step_count;  i++  ) {
+		const uint32 n = test_rand(convoy_count);
+		if(  !handles[n].is_bound()  ||  handles[n]->distance != n  ) {
+			errors++;
+		}
+		sum += handles[n]->distance;
+	}
+	const std::chrono::steady_clock::time_point deref_end = std::chrono::steady_clock::now();
+
+	typedef std::chrono::duration<double, std::milli> ms_t;
+	printf("handle ids of %u bytes, table of %u entries\n", (unsigned)sizeof(quickstone_id_t), (unsigned)convoy_handle_t::get_size());
+	printf("sizeof(handle) %u, sizeof(packet with four handles) %u\n", (unsigned)sizeof(convoy_handle_t), (unsigned)sizeof(packet_t));
+	printf("%u handles created in %.1f ms\n", convoy_count, ms_t(create_end - create_start).count());
+	printf("%u handles replaced in %.1f ms (%.1f ns each)\n", step_count/100, ms_t(churn_end - create_end).count(), ms_t(churn_end - create_end).count() * 1e8 / step_count);
+	printf("%u dereferences in %.1f ms (%.1f ns each, checksum %llu)\n", step_count, ms_t(deref_end - churn_end).count(), ms_t(deref_end - churn_end).count() * 1e6 / step_count, (unsigned long long)sum);
+
+	delete [] handles;
+	delete [] convoys;
+	return errors == 0 ? 0 : 1;
+}
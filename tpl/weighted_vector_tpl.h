@@ -92,7 +92,7 @@ public:
 		friend class weighted_vector_tpl;
 	};
 
-	weighted_vector_tpl() : nodes(NULL), size(0), count(0), total_weight(0) {}
+	weighted_vector_tpl() : nodes(NULL), size(0), count(0), total_weight(0), revision(0) {}
 
 	/** Construct a vector for size elements */
 	explicit weighted_vector_tpl(uint32 size)
@@ -101,6 +101,7 @@ public:
 		nodes = (size > 0 ? new nodestruct[size] : NULL);
 		count = 0;
 		total_weight = 0;
+		revision = 0;
 	}
 
 	~weighted_vector_tpl() { delete [] nodes; }
@@ -110,6 +111,7 @@ public:
 	{
 		count = 0;
 		total_weight = 0;
+		revision++;
 	}
 
 	/**
@@ -171,6 +173,7 @@ public:
 		nodes[count].weight = total_weight;
 		count++;
 		total_weight += weight;
+		revision++;
 		return true;
 	}
 
@@ -202,6 +205,7 @@ public:
 			nodes[pos].data = elem;
 			total_weight += weight;
 			count++;
+			revision++;
 			return true;
 		}
 		else {
@@ -299,6 +303,7 @@ public:
 			}
 			total_weight -= delta_weight;
 		}
+		revision++;
 		return true;
 	}
 
@@ -314,6 +319,7 @@ public:
 			sum      += get_weight(i->data);
 		}
 		total_weight = sum;
+		revision++;
 	}
 
 	/** removes element, if contained */
@@ -353,6 +359,7 @@ public:
 		}
 		count--;
 		total_weight -= diff_weight;
+		revision++;
 		return true;
 	}
 
@@ -361,6 +368,7 @@ public:
 		assert(count>0);
 		--count;
 		total_weight = nodes[count].weight;
+		revision++;
 		return nodes[count].data;
 	}
 
@@ -434,6 +442,9 @@ public:
 	/** Gets the total weight */
 	uint32 get_sum_weight() const { return total_weight; }
 
+	/** Changes whenever elements or weights change, e.g. to know when tables built from this vector are stale */
+	uint32 get_revision() const { return revision; }
+
 	bool empty() const { return count == 0; }
 
 	iterator begin() { return iterator(nodes); }
@@ -447,6 +458,7 @@ private:
 	uint32 size;                  ///< Capacity
 	uint32 count;                 ///< Number of elements in vector
 	uint32 total_weight; ///< Sum of all weights
+	uint32 revision;     ///< Incremented by each change of the elements or weights
 
 	weighted_vector_tpl(const weighted_vector_tpl& other);
 
@@ -458,6 +470,8 @@ private:
 		sim::swap(a.size, b.size);
 		sim::swap(a.count, b.count);
 		sim::swap(a.total_weight, b.total_weight);
+		a.revision++;
+		b.revision++;
 	}
 };
 
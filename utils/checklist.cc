@@ -49,8 +49,8 @@ checklist_t::checklist_t(const uint32 &hash) :
 }
 
 
-// checklist_t::checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint16 _line_entry, uint16 _convoy_entry, uint32* _rands, uint32* _debug_sums)
-checklist_t::checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint16 _line_entry, uint16 _convoy_entry, uint32 *_rands, uint32 *_debug_sums) :
+// checklist_t::checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint32 _line_entry, uint32 _convoy_entry, uint32* _rands, uint32* _debug_sums)
+checklist_t::checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint32 _line_entry, uint32 _convoy_entry, uint32 *_rands, uint32 *_debug_sums) :
 	hash(0),
 	random_seed(_random_seed),
 	halt_entry(_halt_entry),
@@ -110,8 +110,8 @@ void checklist_t::rdwr(memory_rw_t *buffer)
 	buffer->rdwr_byte(nfc);
 	buffer->rdwr_long(random_seed);
 	buffer->rdwr_short(halt_entry);
-	buffer->rdwr_short(line_entry);
-	buffer->rdwr_short(convoy_entry);
+	buffer->rdwr_long(line_entry);
+	buffer->rdwr_long(convoy_entry);
 	// desync debug
 	for(  uint8 i = 0;  i < CHK_RANDS;  i++  ) {
 		buffer->rdwr_long(rand[i]);
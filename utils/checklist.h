@@ -21,8 +21,8 @@ private:
 	uint32 hash;
 	uint32 random_seed;
 	uint16 halt_entry;
-	uint16 line_entry;
-	uint16 convoy_entry;
+	uint32 line_entry;
+	uint32 convoy_entry;
 
 	uint32 ss;
 	uint32 st;
@@ -34,7 +34,7 @@ private:
 public:
 	checklist_t();
 	explicit checklist_t(const uint32 &hash);
-	checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint16 _line_entry, uint16 _convoy_entry, uint32 *_rands, uint32 *_debug_sums);
+	checklist_t(uint32 _ss, uint32 _st, uint8 _nfc, uint32 _random_seed, uint16 _halt_entry, uint32 _line_entry, uint32 _convoy_entry, uint32 *_rands, uint32 *_debug_sums);
 
 	bool operator == (const checklist_t &other) const;
 	bool operator != (const checklist_t &other) const { return !( *this==other ); }
@@ -20,22 +20,6 @@
 #include "log.h"
 #include "../simdebug.h"
 
-/**
- * writes important messages to stderr
- */
-void log_t::important(const char* format, ...)
-{
-	va_list argptr;
-
-	va_start( argptr, format );
-
-	vfprintf( stderr, format, argptr );
-	fprintf( stderr, "\n" );
-	if (  force_flush  ) { fflush( stderr ); }
-
-	va_end( argptr );
-}
-
 /**
  * writes a debug message to stderr
  */
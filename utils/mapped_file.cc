@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mapped_file.h"
+#include "../sys/simsys.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+bool mapped_file_t::open(const char *filename)
+{
+	close();
+
+#ifndef _WIN32
+	const int fd = ::open(filename, O_RDONLY);
+	if(  fd < 0  ) {
+		return false;
+	}
+	struct stat st;
+	if(  fstat(fd, &st) == 0  &&  st.st_size > 0  ) {
+		// private and writeable, so changes by the readers stay in memory
+		void *const p = mmap(NULL, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if(  p != MAP_FAILED  ) {
+			data = (char *)p;
+			size = st.st_size;
+			mapped = true;
+		}
+	}
+	::close(fd);
+	if(  mapped  ) {
+		return true;
+	}
+#endif
+
+	// no mapping possible => read it all
+	FILE *const fp = dr_fopen(filename, "rb");
+	if(  !fp  ) {
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	const long len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if(  len > 0  ) {
+		data = (char *)malloc(len);
+		if(  data  &&  fread(data, len, 1, fp) == 1  ) {
+			size = len;
+		}
+		else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(fp);
+	return data != NULL;
+}
+
+
+void mapped_file_t::prefetch() const
+{
+	if(  mapped  ) {
+		volatile char touched = 0;
+		for(  size_t i = 0;  i < size;  i += 4096  ) {
+			touched += data[i];
+		}
+		(void)touched;
+	}
+}
+
+
+void mapped_file_t::close()
+{
+	if(  data  ) {
+#ifndef _WIN32
+		if(  mapped  ) {
+			munmap(data, size);
+		}
+		else
+#endif
+		{
+			free(data);
+		}
+	}
+	data = NULL;
+	size = 0;
+	mapped = false;
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+
+#include <stddef.h>
+
+
+/**
+ * A whole file in memory. Where the system supports it, the file is mapped,
+ * so its pages are only read when accessed and are shared with the file cache.
+ * Otherwise it is read into memory at once.
+ * The data may be changed, but this never changes the file.
+ */
+class mapped_file_t
+{
+public:
+	mapped_file_t() : data(NULL), size(0), mapped(false) {}
+	~mapped_file_t() { close(); }
+
+	/// @returns false if the file could not be opened or is empty
+	bool open(const char *filename);
+
+	void close();
+
+	/// Reads all pages of a mapped file into memory, so later accesses need not wait for the disk
+	void prefetch() const;
+
+	char *get_data() const { return data; }
+	size_t get_size() const { return size; }
+
+private:
+	mapped_file_t(const mapped_file_t &);
+	mapped_file_t &operator=(const mapped_file_t &);
+
+	char *data;
+	size_t size;
+	bool mapped;
+};
+
+#endif
@@ -29,6 +29,9 @@ static uint32 thread_local mersenne_twister_index = MERSENNE_TWISTER_N + 1; // m
 
 static uint8 thread_local random_origin = 0;
 
+// see set_simrand_stream()
+static uint64 thread_local *random_stream = NULL;
+
 #ifdef DEBUG_SIMRAND_CALLS
 /* We use the seed to distinguish between threads in the debug output */
 static uint32 thread_local thread_seed = 0;
@@ -97,6 +100,14 @@ uint32 simrand_plain()
 {
 	uint32 y;
 
+	if(  random_stream  ) {
+		// splitmix64
+		uint64 z = (*random_stream += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return (uint32)((z ^ (z >> 31)) >> 32);
+	}
+
 	if (mersenne_twister_index >= MERSENNE_TWISTER_N) { /* generate N words at one time */
 		MTgenerate();
 	}
@@ -296,6 +307,19 @@ uint32 setsimrand(uint32 seed,uint32 ns)
 }
 
 
+void setsimrand_thread(uint32 seed)
+{
+	init_genrand( seed );
+	random_origin = 0;
+}
+
+
+void set_simrand_stream(uint64 *state)
+{
+	random_stream = state;
+}
+
+
 static double int_noise(const sint32 x, const sint32 y)
 {
 	uint32 n = (uint32)x + (uint32)y*101U + noise_seed;
@@ -13,12 +13,26 @@
 
 
 class loadsave_t;
+template<class T> class weighted_vector_tpl;
+template<class T> class alias_sampler_tpl;
 
 
 uint32 get_random_seed();
 
 uint32 setsimrand(uint32 seed, uint32 noise_seed);
 
+/* seeds only the generator of the calling thread,
+ * e.g. for a deterministic stream per worker thread and step
+ */
+void setsimrand_thread(uint32 seed);
+
+/* While @p state is not NULL, simrand() on the calling thread draws from this
+ * small generator instead of the Mersenne twister, which is left as it is.
+ * This gives each part of the work of a step its own deterministic stream,
+ * whichever thread does it; seeding the twister would take too long for that.
+ */
+void set_simrand_stream(uint64 *state);
+
 /* generates a random number on [0,max-1]-interval
  * without affecting the game state
  * Use this for UI etc.
@@ -82,6 +96,17 @@ template<typename T, template<typename> class U> T const& pick_any_weighted(U<T>
 	return container.at_weight(simrand(container.get_sum_weight(), "template<typename T, template<typename> class U> T const& pick_any_weighted(U<T> const& container)"));
 }
 
+/* Randomly select an entry from the given weighted vector in O(1) if the sampler is current for it. */
+template<typename T> T const& pick_any_weighted(alias_sampler_tpl<T> const& sampler, weighted_vector_tpl<T> const& container)
+{
+	if(  !sampler.is_current(container)  ) {
+		return pick_any_weighted(container);
+	}
+	const uint32 column = simrand(container.get_count(), "template<typename T> T const& pick_any_weighted(alias_sampler_tpl<T> const& sampler, weighted_vector_tpl<T> const& container) column");
+	const uint32 fraction = simrand(container.get_sum_weight(), "template<typename T> T const& pick_any_weighted(alias_sampler_tpl<T> const& sampler, weighted_vector_tpl<T> const& container) fraction");
+	return sampler.at(container, column, fraction);
+}
+
 
 // compute integer log10
 uint32 log10( uint32 v );
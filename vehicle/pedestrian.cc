@@ -199,6 +199,13 @@ void pedestrian_t::generate_pedestrians_at(const koord3d k, uint32 count, uint32
 		return;
 	}
 
+	if(  karte_t::sync_region_t *region = karte_t::get_sync_region()  ) {
+		// generated after all regions are stepped, in their order
+		const karte_t::sync_region_t::pedestrians_t pedestrians = { k, count, time_to_live };
+		region->pedestrians.append(pedestrians);
+		return;
+	}
+
 	grund_t* gr = welt->lookup(k);
 	if (gr) {
 		weg_t* weg = gr->get_weg(road_wt);
@@ -60,6 +60,8 @@ public:
 #endif
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	sync_group_t get_sync_group() const OVERRIDE { return SYNC_GROUP_PEDESTRIAN; }
+	koord get_local_sync_pos(uint32 delta_t) const OVERRIDE { return local_sync_pos(delta_t, 128); }
 
 	///@ returns true if pedestrian walks on the left side of the road
 	bool is_on_left() const { return on_left; }
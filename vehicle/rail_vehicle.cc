@@ -337,6 +337,41 @@ int rail_vehicle_t::get_cost(const grund_t *gr, const sint32 max_speed, ribi_t::
 }
 
 
+// everything on which check_next_tile() and get_cost() depend, apart from the ways
+bool rail_vehicle_t::get_route_cache_signature(uint64 &signature) const
+{
+	if(  cnv == NULL  ||  cnv->get_is_choosing()  ||  (target_halt.is_bound()  &&  cnv->is_waiting())  ) {
+		// the reservations of other trains matter
+		return false;
+	}
+
+	// the vehicles must all fulfil the way constraints
+	way_constraints_mask permissive = 0;
+	way_constraints_mask prohibitive = (way_constraints_mask)~0;
+	for(  uint32 i = 0;  i < cnv->get_vehicle_count();  i++  ) {
+		const way_constraints_of_vehicle_t &constraints = cnv->get_vehicle(i)->get_desc()->get_way_constraints();
+		permissive |= constraints.get_permissive();
+		prohibitive &= constraints.get_prohibitive();
+	}
+
+	// access to foreign ways depends on the owner of the way we are on
+	const grund_t *gr = welt->lookup(get_pos());
+	const weg_t *way = gr ? gr->get_weg(get_waytype()) : NULL;
+	const uint8 way_owner_nr = way ? (uint8)way->get_owner_nr() : PLAYER_UNOWNED;
+
+	signature = (uint64)(uint8)get_owner_nr()
+		| (uint64)way_owner_nr << 8
+		| (uint64)permissive << 16
+		| (uint64)prohibitive << 24
+		| (uint64)min(cnv->get_min_top_speed(), 0xFFFFFF) << 32
+		| (uint64)welt->get_settings().get_enforce_weight_limits() << 56
+		| (uint64)cnv->needs_electrification() << 60
+		| (uint64)desc->get_override_way_speed() << 61
+		| (uint64)(speed_limit < INT_MAX) << 62;
+	return true;
+}
+
+
 // this routine is called by find_route, to determined if we reached a destination
 bool rail_vehicle_t::is_target(const grund_t *gr,const grund_t *prev_gr)
 {
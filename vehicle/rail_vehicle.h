@@ -39,6 +39,8 @@ public:
 
 	uint32 get_cost_upslope() const OVERRIDE { return 75; } // Standard is 15
 
+	bool get_route_cache_signature(uint64 &signature) const OVERRIDE;
+
 	// returns true for the way search to an unknown target.
 	bool is_target(const grund_t *,const grund_t *) OVERRIDE;
 
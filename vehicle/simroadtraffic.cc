@@ -219,6 +219,24 @@ void road_user_t::hop(grund_t *)
 
 
 
+koord road_user_t::local_sync_pos(uint32 delta_t, uint32 speed) const
+{
+	// Within less than half a tile (the shortest tile is a diagonal one), it hops at most once, or twice when turning
+	// around at the end of a road, and only looks at the tiles next to those it hops to (see karte_t::sync_list_t).
+	const uint64 steps_to_do = ((uint64)weg_next + (uint64)speed * delta_t) >> YARDS_PER_VEHICLE_STEP_SHIFT;
+	if(  steps_to_do >= VEHICLE_STEPS_PER_TILE / 2  ) {
+		return koord::invalid;
+	}
+	// Level crossings are shared by several tiles and all kinds of vehicles.
+	const grund_t *gr = welt->lookup(get_pos());
+	const grund_t *gr_next = welt->lookup(pos_next);
+	if(  (gr  &&  gr->ist_uebergang())  ||  (gr_next  &&  gr_next->ist_uebergang())  ) {
+		return koord::invalid;
+	}
+	return get_pos().get_2d();
+}
+
+
 void road_user_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t t( file, "road_user_t" );
@@ -522,7 +540,7 @@ sync_result private_car_t::sync_step(uint32 delta_t)
 			else {
 				if(  ms_traffic_jam > welt->ticks_per_world_month  &&  old_ms_traffic_jam<=welt->ticks_per_world_month  ) {
 					// message after two month, reset waiting timer
-					welt->get_message()->add_message( translator::translate("To heavy traffic\nresults in traffic jam.\n"), get_pos().get_2d(), message_t::traffic_jams|message_t::expire_after_one_month_flag, color_idx_to_rgb(COL_ORANGE) );
+					add_traffic_jam_message( get_pos().get_2d() );
 				}
 			}
 		}
@@ -555,6 +573,28 @@ sync_result private_car_t::sync_step(uint32 delta_t)
 }
 
 
+void private_car_t::add_traffic_jam_message(koord pos)
+{
+	if(  karte_t::sync_region_t *region = karte_t::get_sync_region()  ) {
+		// added after all regions are stepped, in their order
+		region->traffic_jams.append(pos);
+		return;
+	}
+	welt->get_message()->add_message( translator::translate("To heavy traffic\nresults in traffic jam.\n"), pos, message_t::traffic_jams|message_t::expire_after_one_month_flag, color_idx_to_rgb(COL_ORANGE) );
+}
+
+
+koord private_car_t::get_local_sync_pos(uint32 delta_t) const
+{
+	// as in sync_step()
+	uint32 speed = current_speed;
+	if(  speed > 0  &&  ms_traffic_jam == SINT32_MAX_VALUE  ) {
+		speed = kmh_to_speed(welt->get_settings().get_town_road_speed_limit());
+	}
+	return local_sync_pos(delta_t, speed);
+}
+
+
 void private_car_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t s( file, "private_car_t" );
@@ -1155,7 +1195,7 @@ grund_t* private_car_t::hop_check()
 			return can_enter_tile(from) ? from : NULL;
 		}
 
-		static weighted_vector_tpl<koord3d> poslist(4);
+		static thread_local weighted_vector_tpl<koord3d> poslist(4);
 		poslist.clear();
 
 		bool city_exit = false;
@@ -1308,6 +1348,8 @@ void private_car_t::hop(grund_t* to)
 
 	weg_t* const way = to->get_weg(road_wt);
 	const uint32 tiles_per_km = 1000 / welt->get_settings().get_meters_per_tile();
+	// While stepped by regions, the toll and the wear are booked after all regions, as the way may be a player's or a city's.
+	karte_t::sync_region_t *region = karte_t::get_sync_region();
 	if(way && tiles_since_last_increment++ > tiles_per_km)
 	{
 		tiles_since_last_increment -= tiles_per_km;
@@ -1315,7 +1357,13 @@ void private_car_t::hop(grund_t* to)
 		if(player && player->get_player_nr() != 1)
 		{
 			const sint64 toll = welt->get_settings().get_private_car_toll_per_km();
-			player->book_toll_received(toll, road_wt);
+			if(  region  ) {
+				const karte_t::sync_region_t::toll_t booking = { player, toll };
+				region->tolls.append(booking);
+			}
+			else {
+				player->book_toll_received(toll, road_wt);
+			}
 		}
 	}
 
@@ -1337,7 +1385,13 @@ void private_car_t::hop(grund_t* to)
 
 	if(way)
 	{
-		way->wear_way(welt->get_settings().get_citycar_way_wear_factor());
+		if(  region  ) {
+			const karte_t::sync_region_t::way_wear_t wear = { way, welt->get_settings().get_citycar_way_wear_factor() };
+			region->way_wear.append(wear);
+		}
+		else {
+			way->wear_way(welt->get_settings().get_citycar_way_wear_factor());
+		}
 	}
 
 	leave_tile();
@@ -1464,6 +1518,17 @@ void private_car_t::rotate90()
  * conditions for a city car to overtake another overtaker.
  * The city car is not overtaking/being overtaken.
  */
+/**
+ * While stepped by regions, a car must not look at the tiles of other regions,
+ * so it does not begin to overtake where it would need to.
+ */
+static inline bool outside_sync_region(koord3d pos)
+{
+	const karte_t::sync_region_t *region = karte_t::get_sync_region();
+	return region  &&  !region->is_inside(pos.get_2d());
+}
+
+
 bool private_car_t::can_overtake( overtaker_t *other_overtaker, sint32 other_speed, sint16 steps_other)
 {
 	const grund_t *gr = welt->lookup(get_pos());
@@ -1492,6 +1557,9 @@ bool private_car_t::can_overtake( overtaker_t *other_overtaker, sint32 other_spe
 		const ribi_t::ribi direction = get_direction() & str->get_ribi();
 		koord3d check_pos = get_pos()+koord((ribi_t::ribi)(str->get_ribi()&direction));
 		for(  int tiles=1+(steps_other-1)/(CARUNITS_PER_TILE*VEHICLE_STEPS_PER_CARUNIT);  tiles>=0;  tiles--  ) {
+			if(  outside_sync_region(check_pos)  ) {
+				return false;
+			}
 			grund_t *gr = welt->lookup(check_pos);
 			if(  gr==NULL  ) {
 				return false;
@@ -1561,6 +1629,10 @@ bool private_car_t::can_overtake( overtaker_t *other_overtaker, sint32 other_spe
 
 	while(  distance > 0  ) {
 
+		if(  outside_sync_region(check_pos)  ) {
+			return false;
+		}
+
 		// we allow stops and slopes, since empty stops and slopes cannot affect us
 		// (citycars do not slow down on slopes!)
 
@@ -1673,6 +1745,10 @@ bool private_car_t::can_overtake( overtaker_t *other_overtaker, sint32 other_spe
 	}
 	time_overtaking = (time_overtaking << 16)/(sint32)current_speed;
 	do {
+		if(  outside_sync_region(check_pos)  ) {
+			return false;
+		}
+
 		// we can allow crossings or traffic lights here, since they will stop also oncoming traffic
 		if(  ribi_t::is_straight(str->get_ribi())  ) {
 			time_overtaking -= (VEHICLE_STEPS_PER_TILE<<16) / max(1, kmh_to_speed(str->get_max_speed()));
@@ -49,6 +49,9 @@ protected:
 	void hop(grund_t *gr) OVERRIDE;
 	virtual void update_bookkeeping(uint32) OVERRIDE {};
 
+	/// get_local_sync_pos() for a road user which moves @p speed yards per ms
+	koord local_sync_pos(uint32 delta_t, uint32 speed) const;
+
 #ifdef INLINE_OBJ_TYPE
 	road_user_t(typ type);
 
@@ -136,6 +139,11 @@ public:
 	const citycar_desc_t *get_desc() const { return desc; }
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
+	sync_group_t get_sync_group() const OVERRIDE { return SYNC_GROUP_PRIVATE_CAR; }
+	koord get_local_sync_pos(uint32 delta_t) const OVERRIDE;
+
+	/// tells the player about a car stuck at @p pos for long
+	static void add_traffic_jam_message(koord pos);
 
 	void hop(grund_t *gr) OVERRIDE;
 	bool can_enter_tile(grund_t *gr);